@@ -23,6 +23,9 @@ namespace hft_system
         // This now returns a map of key-value metrics.
         std::map<std::string, double> generate_report(const std::list<Trade> &trade_log);
 
+        // The report for an equity curve that was collected elsewhere (e.g. by a parameter sweep).
+        static std::map<std::string, double> build_report(const std::vector<double> &equity_curve, const std::list<Trade> &trade_log);
+
     private:
         void on_portfolio_update(const Event &event);
 
@@ -0,0 +1,65 @@
+#ifndef HFT_SYSTEM_IMBALANCESWEEP_H
+#define HFT_SYSTEM_IMBALANCESWEEP_H
+
+#include "../config/Config.h"
+#include "../core/DataTypes.h"
+#include "../strategy/BookImbalance.h"
+#include "SimulatedAccount.h"
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace hft_system
+{
+
+    // Evaluates OrderBookImbalanceStrategy for many imbalance thresholds in one
+    // pass over a tick file. Each book's imbalance ratio is computed once; the
+    // per-threshold inputs (one "lane" per threshold) are kept column-wise so the
+    // signal decision is a single loop over the lanes. Lanes that signal then
+    // trade their own SimulatedAccount, as if each threshold had been
+    // backtested alone with the events handled one at a time.
+    class ImbalanceSweep
+    {
+    public:
+        // Uses the first ORDER_BOOK_IMBALANCE entry of config.strategies for the
+        // symbol, lookback and level decay, and config's data, execution, risk and capital.
+        ImbalanceSweep(const Config &config, std::vector<double> thresholds);
+
+        // True if a sweep reproduces config's backtests: a "ticks" data file, a
+        // single ORDER_BOOK_IMBALANCE strategy and no ML model (whose sizing is random).
+        static bool supports(const Config &config);
+
+        // Replays the data file. Returns false if it cannot be read.
+        bool run();
+
+        size_t lane_count() const { return thresholds_.size(); }
+        double threshold(size_t lane) const { return thresholds_[lane]; }
+        const std::list<Trade> &trade_log(size_t lane) const { return accounts_[lane].trade_log(); }
+        const std::vector<double> &equity_curve(size_t lane) const { return accounts_[lane].equity_curve(); }
+        // Same metrics as Application::run_backtest().
+        std::map<std::string, double> report(size_t lane) const { return accounts_[lane].report(); }
+
+        size_t books_replayed() const { return books_replayed_; }
+
+    private:
+        void on_book(const OrderBook &book);
+
+        Config config_;
+        std::string symbol_;
+        BookImbalance imbalance_{10};
+        SymbolId symbol_id_ = INVALID_SYMBOL_ID;
+        Price last_bid_; // What the RiskManager would price orders at
+        size_t books_replayed_ = 0;
+
+        // Per-lane columns
+        std::vector<double> thresholds_;
+        std::vector<double> inverse_thresholds_;
+        std::vector<int8_t> signals_; // +1 buy, -1 sell, 0 none for the current book
+        std::vector<SimulatedAccount> accounts_;
+    };
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_IMBALANCESWEEP_H
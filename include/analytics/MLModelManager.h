@@ -16,7 +16,7 @@ namespace hft_system
         void stop() override;
 
         // Simulates running a model to get a confidence score for a trade
-        double get_trade_confidence(const std::string &symbol);
+        double get_trade_confidence(SymbolId symbol_id);
 
     private:
         MLConfig config_;
@@ -2,12 +2,17 @@
 #define HFT_SYSTEM_MARKETREGIMEDETECTOR_H
 
 #include "../core/Component.h"
-#include <vector>
-#include <deque>
+#include "../utils/Indicators.h"
+#include <cstddef>
 
 namespace hft_system
 {
 
+    // Classifies the market from the stream of MarketEvent prices: volatility
+    // from the standard deviation of the last volatility_period - 1 returns,
+    // trend from the mean of the newer half of the last trend_period prices
+    // against the older half. Both are maintained incrementally, so a tick costs
+    // O(1) whatever the periods.
     class MarketRegimeDetector : public Component
     {
     public:
@@ -16,13 +21,23 @@ namespace hft_system
         void start() override;
         void stop() override;
 
+        // The price windows and the current regime.
+        void save_snapshot(Snapshot &snapshot) const override;
+        void restore_snapshot(const Snapshot &snapshot) override;
+
+        const MarketState &current_state() const { return current_state_; }
+
     private:
         void on_market_event(const Event &event);
         void calculate_regime();
 
         int volatility_period_;
         int trend_period_;
-        std::deque<double> price_history_;
+        RollingStats returns_;      // Simple returns over the volatility period
+        RollingStats recent_half_;  // Newer half of the trend period's prices
+        RollingStats earlier_half_; // Older half, fed with prices leaving recent_half_
+        double last_price_ = 0.0;
+        size_t prices_seen_ = 0;
         MarketState current_state_;
     };
 
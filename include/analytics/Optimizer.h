@@ -21,6 +21,8 @@ private:
     std::map<std::string, double> results_; // Stores results as {param_set_string -> sharpe_ratio}
 
     void generate_test_configs();
+    // Single-pass ImbalanceSweep over the threshold grid, used when it reproduces the backtests.
+    void run_sweep(const std::vector<double>& thresholds);
 };
 
 } // namespace hft_system
@@ -0,0 +1,51 @@
+#ifndef HFT_SYSTEM_SIMULATEDACCOUNT_H
+#define HFT_SYSTEM_SIMULATEDACCOUNT_H
+
+#include "../config/Config.h"
+#include "../core/DataTypes.h"
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace hft_system
+{
+
+    // One backtest account for a single symbol, driven without the EventBus:
+    // a signal goes through the RiskManager's sizing (with an ML confidence of
+    // 1), the ExecutionHandler's fill and the PortfolioManager's bookkeeping in
+    // one call, as if each event were handled before the next arrived. Used by
+    // the engines that replay data without an Application.
+    class SimulatedAccount
+    {
+    public:
+        SimulatedAccount(const Config &config, std::string symbol);
+
+        // Sizes, fills and books an order at `market_price`. Returns false if the
+        // RiskManager would have rejected the signal.
+        bool on_signal(OrderDirection direction, Price market_price, const InstrumentSpec &spec);
+
+        double cash() const { return cash_; }
+        double equity() const { return equity_; }
+        const std::vector<double> &equity_curve() const { return equity_curve_; }
+        const std::list<Trade> &trade_log() const { return trade_log_; }
+        // Same metrics as Application::run_backtest().
+        std::map<std::string, double> report() const;
+
+    private:
+        RiskConfig risk_;
+        ExecutionConfig execution_;
+        std::string symbol_;
+        double cash_;
+        double equity_; // Last portfolio update, which sizes the next order
+        int64_t position_lots_ = 0;
+        OrderDirection position_direction_ = OrderDirection::NONE;
+        double entry_price_ = 0.0;
+        std::vector<double> equity_curve_;
+        std::list<Trade> trade_log_;
+    };
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_SIMULATEDACCOUNT_H
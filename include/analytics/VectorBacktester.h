@@ -0,0 +1,58 @@
+#ifndef HFT_SYSTEM_VECTORBACKTESTER_H
+#define HFT_SYSTEM_VECTORBACKTESTER_H
+
+#include "../config/Config.h"
+#include "../core/DataTypes.h"
+#include "SimulatedAccount.h"
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace hft_system
+{
+
+    // Screening backtest of MovingAverageCrossStrategy over a bar file without
+    // the event pipeline. The closes come from the DatasetCache as one column;
+    // the moving averages and crossings are computed a whole array at a time in
+    // loops the compiler vectorises, and only the bars that signal reach a
+    // SimulatedAccount. The report has the same keys and values as
+    // Application::run_backtest() on the same config, as long as the event
+    // engine handles each event before the next one arrives.
+    class VectorBacktester
+    {
+    public:
+        explicit VectorBacktester(const Config &config);
+
+        // True for "csv" data with a single MA_CROSSOVER strategy on the data's
+        // symbol and no ML model (whose sizing is random).
+        static bool supports(const Config &config);
+
+        // Loads the data and runs the backtest. Returns false if the file cannot be read.
+        bool run();
+
+        std::map<std::string, double> report() const { return account_ ? account_->report() : std::map<std::string, double>{}; }
+        const std::vector<int8_t> &signals() const { return signals_; } // Per bar: +1 buy, -1 sell, 0 none
+        size_t bar_count() const { return ticks_.size(); }
+        size_t signal_count() const { return signal_count_; }
+
+    private:
+        Config config_;
+        std::string symbol_;
+        int fast_period_ = 5;
+        int slow_period_ = 20;
+
+        // Columns, one entry per bar
+        std::vector<int64_t> ticks_;  // Closes on the symbol's price grid
+        std::vector<int64_t> prefix_; // prefix_[i] = ticks_[0] + ... + ticks_[i - 1]
+        std::vector<int8_t> trends_;
+        std::vector<int8_t> signals_;
+        size_t signal_count_ = 0;
+
+        std::optional<SimulatedAccount> account_;
+    };
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_VECTORBACKTESTER_H
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include "../core/DataTypes.h"
 
 namespace hft_system
 {
@@ -20,6 +21,20 @@ namespace hft_system
     {
         std::string symbol;
         std::string file_path;
+        int replay_delay_us = 100; // Pause between replayed events; 0 replays flat out
+        // Publish the next event only once the last one has been fully handled
+        // (csv, dataset and tick replays); reproducible at any machine load.
+        bool lockstep = false;
+        // Optional [start_time, end_time) slice, in the data file's timestamp units. 0 = unbounded.
+        long long start_time = 0;
+        long long end_time = 0;
+        // Replay from the process-wide DatasetCache instead of re-parsing the file.
+        bool use_dataset_cache = false;
+        // "csv" for OHLCV text files, "ticks" for depth recorded with the tick codec,
+        // "capture" for raw WebSocket journals written via websocket.capture_path.
+        std::string format = "csv";
+        // Capture replay pace relative to the recorded receive times; 0 replays flat out.
+        double replay_speed = 1.0;
     };
 
     struct ExecutionConfig
@@ -44,6 +59,14 @@ namespace hft_system
     {
         int lookback_levels = 10;
         double imbalance_threshold = 1.5;
+        // ORDER_BOOK_IMBALANCE: level i's quantity weighs level_decay^i, in (0, 1]
+        double level_decay = 1.0;
+        // ORDER_BOOK_IMBALANCE: lots whose fill price the book features report;
+        // 0 leaves the features uncomputed
+        int64_t vwap_size = 0;
+        // MA_CROSSOVER: moving average lengths, in market events
+        int fast_period = 5;
+        int slow_period = 20;
     };
 
     struct StrategyConfig
@@ -57,8 +80,42 @@ namespace hft_system
     {
         std::string host;
         int port;
-        std::string target;
+        std::string target; // Combined-stream endpoint, e.g. "/stream"
+        bool use_tls = true; // false for plain ws://, e.g. a local ReplayServer
         std::string symbol;
+        // Symbols to subscribe to on combined connections; empty means just `symbol`.
+        std::vector<std::string> symbols;
+        // Stream types subscribed for every symbol: "depth", "trade", "bookTicker".
+        std::vector<std::string> streams{"depth"};
+        // Symbols are sharded round-robin across this many connections, each
+        // with its own io_context thread.
+        int connections = 1;
+        // A dropped connection (or a book that cannot be resynchronised in
+        // place) is reconnected after an exponential backoff from
+        // reconnect_initial_ms up to reconnect_max_ms. max_reconnects limits the
+        // consecutive attempts per connection; -1 retries forever, 0 never reconnects.
+        int reconnect_initial_ms = 100;
+        int reconnect_max_ms = 10000;
+        int max_reconnects = -1;
+        // When set, every published order book is also recorded to this tick file
+        // (suffixed with ".<SYMBOL>" when several symbols are subscribed).
+        std::string record_path;
+        // When set, every raw frame (plus the subscription and depth snapshots)
+        // is journaled to <capture_path>.<connection>.NNNNNN segment files.
+        std::string capture_path;
+        size_t capture_segment_bytes = 64 << 20;
+        size_t capture_max_segments = 0; // Oldest segments are deleted beyond this; 0 keeps all
+        // Grid of subscribed symbols that have no `instruments` entry.
+        double price_tick = 0.01;
+        double qty_lot = 0.00001;
+        // Depth snapshot used to seed the local book: a recorded REST response if
+        // snapshot_file is set (suffixed with ".<SYMBOL>" when several symbols
+        // are subscribed), otherwise fetched from rest_url.
+        std::string snapshot_file;
+        std::string rest_url = "https://api.binance.com/api/v3/depth";
+        int snapshot_limit = 1000;
+        int snapshot_timeout_ms = 5000; // A fetch that takes longer fails and is retried on the next gap or session
+        int book_depth = 20; // Levels per side published to strategies
     };
 
     struct OptimizationParams
@@ -75,6 +132,28 @@ namespace hft_system
         int out_of_sample_days;
     };
 
+    struct BarConfig
+    {
+        std::vector<BarSpec> windows; // Empty disables bar aggregation
+        bool use_book_mid = false;    // Aggregate order book mids instead of MarketEvent prices; TIME windows only
+    };
+
+    // Tick and lot grid of a traded symbol. Symbols without an entry use a 1e-8 grid.
+    struct InstrumentConfig
+    {
+        std::string symbol;
+        double price_tick = 1e-8;
+        double qty_lot = 1e-8;
+    };
+
+    // Warm restarts in LIVE mode: component state is restored from `path` at
+    // startup and written back every interval_s seconds and at shutdown.
+    struct SnapshotConfig
+    {
+        std::string path; // Empty disables snapshots
+        int interval_s = 60;
+    };
+
     struct MLConfig
     {
         std::string model_path;
@@ -89,10 +168,18 @@ namespace hft_system
         RiskConfig risk;
         AnalyticsConfig analytics;
         std::vector<StrategyConfig> strategies;
+        // "dynamic" routes events through StrategyManager; "static" through the
+        // StaticStrategySet of strategy types compiled into the application.
+        std::string strategy_dispatch = "dynamic";
+        // Threads StrategyManager fans each event out to, the EventBus thread included.
+        int strategy_workers = 1;
         WebSocketConfig websocket;
         OptimizationParams optimization;
         WalkForwardConfig walk_forward;
         MLConfig machine_learning;
+        BarConfig bars;
+        std::vector<InstrumentConfig> instruments;
+        SnapshotConfig snapshot;
     };
 
 } // namespace hft_system
@@ -7,6 +7,8 @@
 #include <string>
 #include <thread>
 #include <atomic>
+#include <future>
+#include <vector>
 
 namespace hft_system
 {
@@ -14,12 +16,13 @@ namespace hft_system
     // Forward declarations...
     class EventBus;
     class DataHandler;
-    class StrategyManager;
+    class Component;
     class PortfolioManager;
     class RiskManager;
     class ExecutionHandler;
     class Analytics;
     class MLModelManager;
+    class BarAggregator;
 
     class Application
     {
@@ -36,16 +39,25 @@ namespace hft_system
     private:
         void main_loop();
 
+        // Warm restarts (config_.snapshot): components with state worth keeping, in snapshot order.
+        std::vector<std::shared_ptr<Component>> stateful_components() const;
+        void restore_snapshot();
+        // Runs on the EventBus thread, where the state lives; the file is written in the background.
+        void capture_snapshot();
+        void write_final_snapshot();
+
         Config config_;
         std::shared_ptr<EventBus> event_bus_;
         std::shared_ptr<DataHandler> data_handler_;
-        std::shared_ptr<StrategyManager> strategy_manager_;
+        std::shared_ptr<Component> strategy_manager_; // StrategyManager or the static pipeline
         std::shared_ptr<PortfolioManager> portfolio_manager_;
         std::shared_ptr<RiskManager> risk_manager_;
         std::shared_ptr<ExecutionHandler> execution_handler_;
         std::shared_ptr<Analytics> analytics_;
         std::shared_ptr<MLModelManager> ml_manager_; // Add this
+        std::shared_ptr<BarAggregator> bar_aggregator_;
 
+        std::future<bool> snapshot_write_; // The last background snapshot write
         std::thread app_thread_;
         std::atomic<bool> is_running_{false};
     };
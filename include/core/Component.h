@@ -8,6 +8,8 @@
 namespace hft_system
 {
 
+    class Snapshot;
+
     class Component
     {
     public:
@@ -24,6 +26,13 @@ namespace hft_system
 
         const std::string &getName() const { return name_; }
 
+        // Warm-restart state (see Snapshot.h). A component whose state takes
+        // time to rebuild from live data writes it into a section named after
+        // itself, and reads it back before start(). Both are called on the
+        // EventBus thread or while it is stopped; the default is stateless.
+        virtual void save_snapshot(Snapshot &) const {}
+        virtual void restore_snapshot(const Snapshot &) {}
+
     protected:
         std::shared_ptr<EventBus> event_bus_;
         const std::string name_;
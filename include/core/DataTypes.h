@@ -3,6 +3,10 @@
 
 #include <string>
 #include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "FixedPoint.h"
 
 namespace hft_system
 {
@@ -19,15 +23,21 @@ namespace hft_system
         LIMIT
     };
 
-    // Represents a single level (price and quantity) in the order book.
+    // Represents a single level (price and quantity) in the order book, on the
+    // instrument's tick and lot grid.
     struct OrderBookLevel
     {
-        double price;
-        double quantity;
+        Price price;
+        Quantity quantity;
     };
 
-    // Represents a full snapshot of the order book at a point in time.
-    struct OrderBook
+    // Dense id for an instrument, assigned by the SymbolRegistry.
+    using SymbolId = uint32_t;
+    constexpr SymbolId INVALID_SYMBOL_ID = UINT32_MAX;
+
+    // Variable-length list of levels as they arrive on the wire: a depth diff
+    // (where a zero quantity removes a level) or a full REST snapshot.
+    struct DepthUpdate
     {
         std::string symbol;
         long long timestamp = 0;
@@ -35,6 +45,71 @@ namespace hft_system
         std::vector<OrderBookLevel> asks;
     };
 
+    constexpr size_t MAX_BOOK_DEPTH = 20;
+
+    // One side of an OrderBook: parallel price/quantity arrays, level 0 best.
+    // Only the first `depth` entries are meaningful.
+    struct BookSide
+    {
+        Price price[MAX_BOOK_DEPTH];
+        Quantity quantity[MAX_BOOK_DEPTH];
+        uint32_t depth = 0;
+
+        size_t size() const { return depth; }
+        bool empty() const { return depth == 0; }
+        void clear() { depth = 0; }
+        // Returns false (and drops the level) once the side is full.
+        bool push_back(Price level_price, Quantity level_quantity)
+        {
+            if (depth == MAX_BOOK_DEPTH)
+                return false;
+            price[depth] = level_price;
+            quantity[depth] = level_quantity;
+            ++depth;
+            return true;
+        }
+    };
+
+    // Top-of-book view handed to strategies: fixed depth, stored inline and
+    // trivially copyable, so publishing one is a memcpy rather than three heap
+    // allocations. Aligned to a cache line so the header and best levels of
+    // each side share as few lines as possible. A book with no levels on either
+    // side means the feed lost sync: it must not be priced off until a
+    // non-empty book for the symbol follows.
+    struct alignas(64) OrderBook
+    {
+        SymbolId symbol_id = INVALID_SYMBOL_ID;
+        long long timestamp = 0;
+        BookSide bids;
+        BookSide asks;
+    };
+    static_assert(std::is_trivially_copyable_v<OrderBook>, "OrderBook must stay memcpy-able");
+
+    // One OHLCV row of historical data.
+    struct Bar
+    {
+        long long timestamp = 0;
+        double open = 0.0;
+        double high = 0.0;
+        double low = 0.0;
+        double close = 0.0;
+        double volume = 0.0;
+    };
+
+    // Window over which ticks are aggregated into a bar: a fixed time span
+    // (nanoseconds) or a traded volume threshold.
+    struct BarSpec
+    {
+        enum class Kind
+        {
+            TIME,
+            VOLUME
+        } kind = Kind::TIME;
+        double size = 0.0;
+
+        bool operator==(const BarSpec &other) const { return kind == other.kind && size == other.size; }
+    };
+
     struct Trade
     {
         std::string symbol;
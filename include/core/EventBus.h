@@ -41,6 +41,20 @@ public:
      */
     void publish(std::shared_ptr<Event> event);
 
+    /**
+     * @brief Publishes a batch of events with a single queue operation.
+     * Events are enqueued in order under one lock acquisition.
+     * @param events The events to publish.
+     */
+    void publish_batch(std::vector<std::shared_ptr<Event>> events);
+
+    /**
+     * @brief Blocks until every event published so far, and every event their
+     * subscribers published in turn, has been dispatched.
+     * Must not be called from a subscriber, nor while the bus is stopped.
+     */
+    void wait_until_idle();
+
     /**
      * @brief Starts the event bus's processing thread.
      */
@@ -66,6 +80,8 @@ private:
     std::queue<std::shared_ptr<Event>> event_queue_;
     std::mutex queue_mutex_;
     std::condition_variable queue_cond_;
+    size_t pending_ = 0; // Published but not yet dispatched, guarded by queue_mutex_
+    std::condition_variable idle_cond_;
 
     // The dedicated thread for running the dispatch_loop.
     std::thread dispatch_thread_;
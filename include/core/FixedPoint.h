@@ -0,0 +1,189 @@
+#ifndef HFT_SYSTEM_FIXEDPOINT_H
+#define HFT_SYSTEM_FIXEDPOINT_H
+
+#include <algorithm>
+#include <cmath>
+#include <compare>
+#include <cstdint>
+#include <string_view>
+
+namespace hft_system
+{
+
+    // A count of an instrument's price ticks or quantity lots. Prices and
+    // quantities are distinct types so they cannot be mixed up, and both stay
+    // exact under addition and comparison; scaling to a decimal value goes
+    // through the instrument's InstrumentSpec.
+    template <typename Tag>
+    struct Fixed
+    {
+        int64_t value = 0;
+
+        constexpr Fixed() = default;
+        constexpr explicit Fixed(int64_t units) : value(units) {}
+
+        constexpr Fixed operator+(Fixed other) const { return Fixed(value + other.value); }
+        constexpr Fixed operator-(Fixed other) const { return Fixed(value - other.value); }
+        constexpr Fixed operator-() const { return Fixed(-value); }
+        constexpr Fixed &operator+=(Fixed other)
+        {
+            value += other.value;
+            return *this;
+        }
+        constexpr Fixed &operator-=(Fixed other)
+        {
+            value -= other.value;
+            return *this;
+        }
+        constexpr Fixed operator*(int64_t factor) const { return Fixed(value * factor); }
+
+        constexpr bool operator==(const Fixed &) const = default;
+        constexpr auto operator<=>(const Fixed &) const = default;
+    };
+
+    struct PriceTag;
+    struct QuantityTag;
+    using Price = Fixed<PriceTag>;       // Ticks
+    using Quantity = Fixed<QuantityTag>; // Lots
+
+    // Parses a plain decimal string ("27123.45000000", "-3", ".5") into an
+    // integer count of 10^-decimals units without going through a double.
+    // Digits past `decimals` are rounded half away from zero. Exponents and
+    // empty input are rejected, as is anything that would overflow.
+    inline bool parse_scaled(std::string_view text, int decimals, int64_t &value)
+    {
+        const char *p = text.data();
+        const char *end = p + text.size();
+        bool negative = false;
+        if (p != end && (*p == '-' || *p == '+'))
+            negative = *p++ == '-';
+
+        constexpr int64_t LIMIT = INT64_MAX / 10 - 9;
+        int64_t units = 0;
+        int fraction_digits = -1; // -1 until the decimal point is seen
+        bool any_digit = false;
+        bool round_up = false;
+        for (; p != end; ++p)
+        {
+            char c = *p;
+            if (c == '.' && fraction_digits < 0)
+            {
+                fraction_digits = 0;
+                continue;
+            }
+            if (c < '0' || c > '9')
+                return false;
+            any_digit = true;
+            if (fraction_digits >= decimals)
+            {
+                // First dropped digit decides the rounding; the rest are only validated.
+                if (fraction_digits == decimals && c >= '5')
+                    round_up = true;
+                fraction_digits = decimals + 1;
+                continue;
+            }
+            if (units > LIMIT)
+                return false;
+            units = units * 10 + (c - '0');
+            if (fraction_digits >= 0)
+                ++fraction_digits;
+        }
+        if (!any_digit)
+            return false;
+
+        for (int i = fraction_digits < 0 ? 0 : fraction_digits; i < decimals; ++i)
+        {
+            if (units > LIMIT)
+                return false;
+            units *= 10;
+        }
+        if (round_up)
+            ++units;
+        value = negative ? -units : units;
+        return true;
+    }
+
+    // Tick and lot grid of one instrument. Both sizes must be a whole number of
+    // some power of ten down to 1e-12 (0.01, 0.05, 0.00001, ...). Decimal
+    // strings are parsed exactly at that power of ten and then divided by the
+    // step, so no binary floating point is involved.
+    struct InstrumentSpec
+    {
+        double price_tick = 1e-8;
+        double qty_lot = 1e-8;
+        int price_decimals = 8;
+        int qty_decimals = 8;
+        int64_t price_step = 1; // Tick size in 10^-price_decimals units
+        int64_t qty_step = 1;   // Lot size in 10^-qty_decimals units
+
+        static InstrumentSpec from(double price_tick, double qty_lot)
+        {
+            InstrumentSpec spec;
+            spec.price_tick = price_tick;
+            spec.qty_lot = qty_lot;
+            grid_of(price_tick, spec.price_decimals, spec.price_step);
+            grid_of(qty_lot, spec.qty_decimals, spec.qty_step);
+            return spec;
+        }
+
+        bool parse_price(std::string_view text, Price &price) const
+        {
+            int64_t units;
+            if (!parse_scaled(text, price_decimals, units))
+                return false;
+            price = Price(round_div(units, price_step));
+            return true;
+        }
+
+        bool parse_quantity(std::string_view text, Quantity &quantity) const
+        {
+            int64_t units;
+            if (!parse_scaled(text, qty_decimals, units))
+                return false;
+            quantity = Quantity(round_div(units, qty_step));
+            return true;
+        }
+
+        // Conversions for the edges that work in doubles (sizing, analytics, reports).
+        Price to_price(double price) const { return Price(std::llround(price / price_tick)); }
+        Quantity to_quantity(double quantity) const { return Quantity(std::llround(quantity / qty_lot)); }
+        // Whole lots at most / at least `quantity`, for sizes bounded by a budget
+        // or a minimum; within 1e-9 lots of a whole lot counts as on it.
+        Quantity to_quantity_floor(double quantity) const { return Quantity(static_cast<int64_t>(std::floor(quantity / qty_lot + 1e-9))); }
+        Quantity to_quantity_ceil(double quantity) const { return Quantity(static_cast<int64_t>(std::ceil(quantity / qty_lot - 1e-9))); }
+        double to_double(Price price) const { return static_cast<double>(price.value * price_step) / pow10(price_decimals); }
+        double to_double(Quantity quantity) const { return static_cast<double>(quantity.value * qty_step) / pow10(qty_decimals); }
+
+        // Quote-currency value of `quantity` at `price`.
+        double notional(Price price, Quantity quantity) const { return to_double(price) * to_double(quantity); }
+
+    private:
+        static double pow10(int exponent)
+        {
+            static constexpr double POWERS[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6,
+                                                1e7, 1e8, 1e9, 1e10, 1e11, 1e12};
+            return POWERS[exponent];
+        }
+
+        static void grid_of(double size, int &decimals, int64_t &step)
+        {
+            for (decimals = 0; decimals < 12; ++decimals)
+            {
+                double scaled = size * pow10(decimals);
+                if (scaled >= 1.0 - 1e-9 && std::fabs(scaled - std::round(scaled)) < 1e-6)
+                    break;
+            }
+            step = std::max<int64_t>(std::llround(size * pow10(decimals)), 1);
+        }
+
+        static int64_t round_div(int64_t units, int64_t step)
+        {
+            if (step == 1)
+                return units;
+            int64_t half = step / 2;
+            return units >= 0 ? (units + half) / step : -((-units + half) / step);
+        }
+    };
+
+} // namespace hft_system
+#endif // HFT_SYSTEM_FIXEDPOINT_H
@@ -6,16 +6,17 @@
 #include "DataTypes.h"
 #include <map>
 #include <list>
+#include <vector>
 
 namespace hft_system
 {
 
     struct Position
     {
-        std::string symbol;
-        OrderDirection direction;
-        double quantity = 0.0; // Changed from int to double
-        double entry_price = 0.0;
+        SymbolId symbol_id = INVALID_SYMBOL_ID;
+        OrderDirection direction = OrderDirection::NONE;
+        Quantity quantity;        // Whole lots, so a fully closed position is exactly zero
+        double entry_price = 0.0; // Volume-weighted average, not necessarily on the tick grid
     };
 
     class PortfolioManager : public Component
@@ -29,12 +30,20 @@ namespace hft_system
         const std::list<Trade> &get_trade_log() const;
         std::map<std::string, double> get_pnl_summary() const;
 
+        // Cash and open positions. The trade log is not part of it: after a
+        // restore it only covers trades closed since the restart.
+        void save_snapshot(Snapshot &snapshot) const override;
+        void restore_snapshot(const Snapshot &snapshot) override;
+
+        double cash() const { return cash_; }
+        double total_equity() const;
+
     private:
         void on_fill(const Event &event);
 
         double capital_;
         double cash_;
-        std::map<std::string, Position> positions_;
+        std::vector<Position> positions_; // Indexed by SymbolId; quantity 0 means flat
         std::list<Trade> trade_log_;
     };
 
@@ -0,0 +1,147 @@
+#ifndef HFT_SYSTEM_SNAPSHOT_H
+#define HFT_SYSTEM_SNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace hft_system
+{
+
+    // Appends values to a snapshot section in host byte order; the snapshot file
+    // records the byte order and is rejected on a machine with another one.
+    class SnapshotWriter
+    {
+    public:
+        template <typename T>
+        void put(const T &value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "put() copies raw bytes");
+            data_.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        void put_string(std::string_view value)
+        {
+            put(static_cast<uint64_t>(value.size()));
+            data_.append(value.data(), value.size());
+        }
+
+        template <typename T>
+        void put_vector(const std::vector<T> &values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "put_vector() copies raw bytes");
+            put(static_cast<uint64_t>(values.size()));
+            data_.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+        }
+
+        const std::string &data() const { return data_; }
+        std::string &data() { return data_; }
+
+    private:
+        std::string data_;
+    };
+
+    // Reads back what a SnapshotWriter wrote, in the same order. A read past the
+    // end fails and leaves ok() false, so a truncated section is detected once
+    // after restoring rather than after every call.
+    class SnapshotReader
+    {
+    public:
+        explicit SnapshotReader(std::string_view data) : data_(data) {}
+
+        template <typename T>
+        bool get(T &value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "get() copies raw bytes");
+            if (!take(sizeof(T)))
+                return false;
+            std::memcpy(&value, data_.data() + offset_ - sizeof(T), sizeof(T));
+            return true;
+        }
+
+        bool get_string(std::string &value)
+        {
+            uint64_t size = 0;
+            if (!get(size) || !take(size))
+                return false;
+            value.assign(data_.data() + offset_ - size, size);
+            return true;
+        }
+
+        template <typename T>
+        bool get_vector(std::vector<T> &values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "get_vector() copies raw bytes");
+            uint64_t count = 0;
+            if (!get(count) || count > (data_.size() - offset_) / sizeof(T) || !take(count * sizeof(T)))
+                return false;
+            values.resize(count);
+            std::memcpy(values.data(), data_.data() + offset_ - count * sizeof(T), count * sizeof(T));
+            return true;
+        }
+
+        bool ok() const { return ok_; }
+        bool at_end() const { return offset_ == data_.size(); }
+
+    private:
+        bool take(uint64_t bytes)
+        {
+            if (!ok_ || bytes > data_.size() - offset_)
+            {
+                ok_ = false;
+                return false;
+            }
+            offset_ += bytes;
+            return true;
+        }
+
+        std::string_view data_;
+        size_t offset_ = 0;
+        bool ok_ = true;
+    };
+
+    // Warm-restart state of the components, as named sections. Each section
+    // carries the version of the layout its owner wrote; a reader asks for the
+    // version it understands and gets nothing for any other, so a component
+    // whose layout changed re-warms from live data instead of misreading.
+    // On disk: a fixed header, the sections, and an FNV-1a checksum of both.
+    class Snapshot
+    {
+    public:
+        // Starts section `name` (replacing any earlier one) with layout `version`.
+        SnapshotWriter &add_section(const std::string &name, uint32_t version);
+
+        // The section's contents if it exists with exactly `version`; logs and
+        // returns nothing otherwise.
+        std::optional<SnapshotReader> section(const std::string &name, uint32_t version) const;
+
+        bool has_section(const std::string &name) const { return sections_.count(name) > 0; }
+        size_t section_count() const { return sections_.size(); }
+        bool empty() const { return sections_.empty(); }
+
+        // Writes to a temporary file and renames it over `path`, so a crash
+        // mid-write leaves the previous snapshot intact. Returns false on I/O failure.
+        bool save(const std::string &path) const;
+
+        // Replaces the contents with the snapshot at `path`. Returns false (and
+        // stays empty) if the file is missing, from another format version or
+        // byte order, truncated or corrupt.
+        bool load(const std::string &path);
+
+    private:
+        struct Section
+        {
+            uint32_t version = 0;
+            SnapshotWriter writer;
+        };
+        std::map<std::string, Section> sections_;
+    };
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_SNAPSHOT_H
@@ -0,0 +1,56 @@
+#ifndef HFT_SYSTEM_SYMBOLREGISTRY_H
+#define HFT_SYSTEM_SYMBOLREGISTRY_H
+
+#include "DataTypes.h"
+#include "FixedPoint.h"
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace hft_system
+{
+
+    // Process-wide mapping between instrument names and dense SymbolIds.
+    // Ids are assigned in first-seen order starting at 0 and never reused, so
+    // components can index flat arrays by id. Names returned by name() stay
+    // valid for the lifetime of the process.
+    class SymbolRegistry
+    {
+    public:
+        static SymbolRegistry &get_instance();
+
+        // Returns the id for `name`, registering it on first use.
+        SymbolId intern(std::string_view name);
+
+        // Returns the id for `name`, or INVALID_SYMBOL_ID if it was never registered.
+        SymbolId find(std::string_view name) const;
+
+        // Name of a registered id; an empty string for unknown ids.
+        const std::string &name(SymbolId id) const;
+
+        size_t size() const;
+
+        // Tick and lot grid of a symbol; the default 1e-8 grid until one is set.
+        void set_spec(SymbolId id, const InstrumentSpec &spec);
+        InstrumentSpec spec(SymbolId id) const;
+
+    private:
+        SymbolRegistry() = default;
+        SymbolRegistry(const SymbolRegistry &) = delete;
+        SymbolRegistry &operator=(const SymbolRegistry &) = delete;
+
+        mutable std::shared_mutex mutex_;
+        std::deque<std::string> names_; // deque: references survive growth
+        std::deque<InstrumentSpec> specs_;
+        std::unordered_map<std::string_view, SymbolId> ids_;
+    };
+
+    // Shorthands for the edges of the system: config, logging and tests.
+    inline SymbolId intern_symbol(std::string_view name) { return SymbolRegistry::get_instance().intern(name); }
+    inline const std::string &symbol_name(SymbolId id) { return SymbolRegistry::get_instance().name(id); }
+    inline InstrumentSpec instrument_spec(SymbolId id) { return SymbolRegistry::get_instance().spec(id); }
+
+} // namespace hft_system
+#endif // HFT_SYSTEM_SYMBOLREGISTRY_H
@@ -0,0 +1,52 @@
+#ifndef HFT_SYSTEM_BARAGGREGATOR_H
+#define HFT_SYSTEM_BARAGGREGATOR_H
+
+#include "../core/Component.h"
+#include "../config/Config.h"
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace hft_system
+{
+
+    // Turns ticks (MarketEvent prices, or order book mids) into OHLCV bars for
+    // every configured window and publishes each completed bar as a BarEvent.
+    // Each tick costs O(1) per window: only the open bar is kept per symbol and
+    // window. Time bars close on the first tick of a later window (empty windows
+    // produce no bar); volume bars close on the tick that reaches the threshold.
+    class BarAggregator : public Component
+    {
+    public:
+        BarAggregator(std::shared_ptr<EventBus> event_bus, std::string name, BarConfig config);
+
+        void start() override;
+        void stop() override;
+
+        // Feeds one tick. `time_ns` is the exchange time in nanoseconds.
+        void on_tick(SymbolId symbol_id, int64_t time_ns, double price, double volume);
+
+        // Publishes every partially filled bar, e.g. at the end of a replay.
+        void flush();
+
+    private:
+        struct WindowState
+        {
+            BarSpec spec;
+            Bar bar;
+            int64_t bucket = std::numeric_limits<int64_t>::min();
+            bool open = false;
+        };
+
+        void on_market_event(const Event &event);
+        void on_order_book_event(const Event &event);
+        std::vector<WindowState> &windows_for(SymbolId symbol_id);
+        void publish_bar(SymbolId symbol_id, WindowState &state);
+
+        BarConfig config_;
+        std::vector<std::vector<WindowState>> windows_; // Indexed by SymbolId
+    };
+
+} // namespace hft_system
+#endif // HFT_SYSTEM_BARAGGREGATOR_H
@@ -0,0 +1,118 @@
+#ifndef HFT_SYSTEM_BINANCEDEPTHDECODER_H
+#define HFT_SYSTEM_BINANCEDEPTHDECODER_H
+
+#include "../core/DataTypes.h"
+#include "simdjson.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hft_system
+{
+
+    // A depthUpdate whose levels have been validated but not parsed: the
+    // price and quantity strings are kept in one buffer with an offset index,
+    // and only turned into ticks and lots when decode() is first called. The
+    // update ids, symbol and event time are always available, so a diff that
+    // turns out stale against a snapshot is dropped without its levels ever
+    // being parsed.
+    class RawDepthUpdate
+    {
+    public:
+        // Where a level's price and quantity strings sit in the text buffer.
+        struct LevelText
+        {
+            uint32_t price_offset;
+            uint32_t price_size;
+            uint32_t quantity_offset;
+            uint32_t quantity_size;
+        };
+
+        RawDepthUpdate() = default;
+
+        // Wraps an update that was already decoded.
+        RawDepthUpdate(const DepthUpdate &update, int64_t first_update_id, int64_t final_update_id)
+            : update_(update), first_update_id_(first_update_id), final_update_id_(final_update_id), decoded_(true) {}
+
+        int64_t first_update_id() const { return first_update_id_; }
+        int64_t final_update_id() const { return final_update_id_; }
+        size_t bid_count() const { return decoded_ ? update_.bids.size() : bid_text_.size(); }
+        size_t ask_count() const { return decoded_ ? update_.asks.size() : ask_text_.size(); }
+        bool is_decoded() const { return decoded_; }
+
+        // Parses the levels on `spec`'s grid the first time it is called; later
+        // calls return the cached result. False if a level does not parse.
+        bool decode(const InstrumentSpec &spec);
+
+        // Symbol and timestamp are always set; the levels only after decode().
+        const DepthUpdate &update() const { return update_; }
+
+    private:
+        friend class BinanceDepthDecoder;
+
+        void clear();
+        bool decode_side(const std::vector<LevelText> &text, const InstrumentSpec &spec, std::vector<OrderBookLevel> &levels) const;
+
+        DepthUpdate update_;
+        int64_t first_update_id_ = 0;
+        int64_t final_update_id_ = 0;
+        std::string text_; // Price and quantity strings of every level, back to back
+        std::vector<LevelText> bid_text_;
+        std::vector<LevelText> ask_text_;
+        bool decoded_ = false;
+    };
+
+    // Decodes Binance depthUpdate frames in place.
+    // The parser and its internal buffers are reused across frames, levels are
+    // parsed straight from the JSON text into ticks and lots of the configured
+    // InstrumentSpec, and the output book is cleared rather than reallocated,
+    // so once warmed up a frame is decoded without touching the heap.
+    class BinanceDepthDecoder
+    {
+    public:
+        explicit BinanceDepthDecoder(const InstrumentSpec &spec = InstrumentSpec{}) : spec_(spec) {}
+
+        void set_spec(const InstrumentSpec &spec) { spec_ = spec; }
+        const InstrumentSpec &spec() const { return spec_; }
+
+        enum class Result
+        {
+            DEPTH_UPDATE,
+            SUBSCRIPTION_ACK,
+            IGNORED,
+            ERROR
+        };
+
+        // `data` must stay readable up to `capacity` bytes, which has to be at
+        // least size + simdjson::SIMDJSON_PADDING (see padded_capacity()).
+        Result decode(const char *data, size_t size, size_t capacity, DepthUpdate &book);
+
+        // Update id range ("U".."u") of the last decoded depth update.
+        int64_t first_update_id() const { return first_update_id_; }
+        int64_t final_update_id() const { return final_update_id_; }
+
+        // Decodes a REST /api/v3/depth snapshot. Same padding requirement as decode().
+        bool decode_snapshot(const char *data, size_t size, size_t capacity, DepthUpdate &book, int64_t &last_update_id);
+
+        // Decodes the fields of a depthUpdate payload that has already been
+        // parsed, e.g. the "data" member of a combined-stream frame.
+        static Result decode_fields(simdjson::ondemand::object &object, const InstrumentSpec &spec, DepthUpdate &book,
+                                    int64_t &first_update_id, int64_t &final_update_id);
+
+        // Like decode_fields(), but the levels are only validated and indexed
+        // into `update`, to be parsed later by RawDepthUpdate::decode().
+        static Result index_fields(simdjson::ondemand::object &object, RawDepthUpdate &update);
+
+        static constexpr size_t padded_capacity(size_t size) { return size + simdjson::SIMDJSON_PADDING; }
+
+    private:
+        simdjson::ondemand::parser parser_;
+        InstrumentSpec spec_;
+        int64_t first_update_id_ = 0;
+        int64_t final_update_id_ = 0;
+    };
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_BINANCEDEPTHDECODER_H
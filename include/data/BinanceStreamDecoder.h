@@ -0,0 +1,127 @@
+#ifndef HFT_SYSTEM_BINANCESTREAMDECODER_H
+#define HFT_SYSTEM_BINANCESTREAMDECODER_H
+
+#include "../core/DataTypes.h"
+#include "BinanceDepthDecoder.h"
+#include "simdjson.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace hft_system
+{
+
+    // A trade print from a <symbol>@trade stream.
+    struct TradeUpdate
+    {
+        int64_t trade_id = 0;
+        int64_t trade_time = 0; // Milliseconds since epoch
+        Price price;
+        Quantity quantity;
+        bool buyer_is_maker = false;
+    };
+
+    // Best bid and ask from a <symbol>@bookTicker stream.
+    struct BookTickerUpdate
+    {
+        int64_t update_id = 0;
+        Price bid_price;
+        Quantity bid_quantity;
+        Price ask_price;
+        Quantity ask_quantity;
+    };
+
+    // Demultiplexes frames of a Binance combined-stream connection
+    // ({"stream":"btcusdt@depth","data":{...}}). Streams are registered up
+    // front with the InstrumentSpec of their symbol; the "stream" member of a
+    // frame selects one with a single hash lookup and its "data" payload is
+    // decoded in the same on-demand pass. Like BinanceDepthDecoder, the parser
+    // and the output updates are reused, so a warm decode does not allocate.
+    class BinanceStreamDecoder
+    {
+    public:
+        enum class StreamKind
+        {
+            DEPTH,
+            TRADE,
+            BOOK_TICKER
+        };
+
+        enum class Result
+        {
+            DEPTH_UPDATE,
+            TRADE,
+            BOOK_TICKER,
+            SUBSCRIPTION_ACK,
+            IGNORED, // Unregistered stream or an event the stream kind does not carry
+            ERROR
+        };
+
+        static constexpr size_t NO_STREAM = static_cast<size_t>(-1);
+
+        // Kind of a stream name such as "btcusdt@depth@100ms"; false if it is not supported.
+        static bool parse_kind(std::string_view name, StreamKind &kind);
+
+        // Registers a stream and returns its index, or NO_STREAM if the kind is unsupported.
+        // Registering the same name twice returns the existing index.
+        size_t add_stream(std::string_view name, const InstrumentSpec &spec);
+
+        size_t stream_count() const { return streams_.size(); }
+        const std::string &stream_name(size_t stream) const { return streams_[stream].name; }
+        StreamKind stream_kind(size_t stream) const { return streams_[stream].kind; }
+
+        // While set, depth frames of the stream only have their levels indexed
+        // into raw_depth() instead of decoded into depth().
+        void set_lazy_depth(size_t stream, bool lazy) { streams_[stream].lazy_depth = lazy; }
+
+        // Same padding requirement as BinanceDepthDecoder::decode().
+        Result decode(const char *data, size_t size, size_t capacity);
+
+        // Stream of the last decoded frame; NO_STREAM for acks and unregistered streams.
+        size_t stream() const { return stream_; }
+
+        // Payload of the last frame, valid for the matching Result.
+        // A depth frame fills raw_depth() if its stream is lazy (see depth_is_raw()), depth() otherwise.
+        const DepthUpdate &depth() const { return depth_; }
+        const RawDepthUpdate &raw_depth() const { return raw_depth_; }
+        bool depth_is_raw() const { return depth_is_raw_; }
+        int64_t first_update_id() const { return first_update_id_; }
+        int64_t final_update_id() const { return final_update_id_; }
+        const TradeUpdate &trade() const { return trade_; }
+        const BookTickerUpdate &book_ticker() const { return book_ticker_; }
+
+        static constexpr size_t padded_capacity(size_t size) { return size + simdjson::SIMDJSON_PADDING; }
+
+    private:
+        struct Stream
+        {
+            std::string name;
+            StreamKind kind;
+            InstrumentSpec spec;
+            bool lazy_depth = false;
+        };
+
+        Result decode_payload(simdjson::ondemand::object &payload, const Stream &stream);
+        bool decode_trade(simdjson::ondemand::object &payload, const InstrumentSpec &spec);
+        bool decode_book_ticker(simdjson::ondemand::object &payload, const InstrumentSpec &spec);
+
+        simdjson::ondemand::parser parser_;
+        std::deque<Stream> streams_; // deque: index_ keys point at the names
+        std::unordered_map<std::string_view, size_t> index_;
+        size_t stream_ = NO_STREAM;
+
+        DepthUpdate depth_;
+        RawDepthUpdate raw_depth_;
+        bool depth_is_raw_ = false;
+        int64_t first_update_id_ = 0;
+        int64_t final_update_id_ = 0;
+        TradeUpdate trade_;
+        BookTickerUpdate book_ticker_;
+    };
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_BINANCESTREAMDECODER_H
@@ -0,0 +1,139 @@
+#ifndef HFT_SYSTEM_CAPTUREJOURNAL_H
+#define HFT_SYSTEM_CAPTUREJOURNAL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace hft_system
+{
+
+    // Raw market data journal: every frame as received, plus the REST
+    // snapshots and subscription that give the frames their meaning, so a
+    // capture can be replayed bit-for-bit through the live parse path.
+    //
+    // A journal is a series of segment files <base>.000000, <base>.000001, ...
+    // Each starts with a 32-byte header ("HFTCAP01", version, segment index,
+    // creation time) followed by 8-byte aligned records:
+    //
+    //   uint32 size | uint16 kind | uint16 reserved | int64 receive_time_ns | bytes[size] | pad
+    //
+    // A zeroed record header marks the end of a segment.
+    struct CaptureRecord
+    {
+        enum class Kind : uint16_t
+        {
+            FRAME = 1,    // WebSocket frame payload
+            SNAPSHOT = 2, // "<SYMBOL>\0<REST depth snapshot body>"
+            SUBSCRIBE = 3 // Subscription request sent on the connection
+        };
+
+        Kind kind = Kind::FRAME;
+        int64_t receive_time = 0; // system_clock nanoseconds
+        std::string_view data;
+    };
+
+    // Appends records from one producer thread without blocking it: records
+    // are copied into a preallocated single-producer ring, and a side thread
+    // moves them into memory-mapped, preallocated segment files, rotating when
+    // a segment fills. If the ring is full the record is dropped and counted
+    // rather than stalling the read path.
+    class CaptureWriter
+    {
+    public:
+        struct Options
+        {
+            std::string base_path;
+            size_t segment_bytes = 64 << 20;
+            size_t max_segments = 0;       // Oldest segments are deleted beyond this; 0 keeps all
+            size_t buffer_bytes = 8 << 20; // Ring between the producer and the writer thread
+        };
+
+        explicit CaptureWriter(Options options);
+        ~CaptureWriter();
+
+        CaptureWriter(const CaptureWriter &) = delete;
+        CaptureWriter &operator=(const CaptureWriter &) = delete;
+
+        // Deletes any segments already at the base path, maps the first one and
+        // starts the writer thread. False on I/O failure.
+        bool start();
+        // Drains the ring, trims the open segment to its used size and unmaps it.
+        void stop();
+
+        // Producer side. Returns false (and counts a drop) if the ring is full.
+        bool append(CaptureRecord::Kind kind, int64_t receive_time, std::string_view data);
+
+        uint64_t records_written() const { return records_written_.load(std::memory_order_relaxed); }
+        uint64_t records_dropped() const { return records_dropped_.load(std::memory_order_relaxed); }
+        uint32_t segments_opened() const { return segments_opened_.load(std::memory_order_relaxed); }
+
+        static std::string segment_path(const std::string &base_path, uint32_t index);
+        // Deletes every segment of the journal at `base_path`; returns how many.
+        static size_t remove_journal(const std::string &base_path);
+
+    private:
+        void writer_loop();
+        bool drain();
+        bool write_record(const char *record, size_t record_bytes);
+        bool open_segment(uint32_t index);
+        void close_segment();
+
+        Options options_;
+        std::unique_ptr<char[]> ring_;
+        size_t ring_capacity_ = 0;                  // Power of two
+        alignas(64) std::atomic<uint64_t> head_{0}; // Written by the producer
+        alignas(64) std::atomic<uint64_t> tail_{0}; // Written by the writer thread
+        alignas(64) std::atomic<bool> running_{false};
+        std::thread writer_thread_;
+
+        int fd_ = -1;
+        char *map_ = nullptr;
+        size_t map_bytes_ = 0;
+        size_t offset_ = 0;
+        uint32_t segment_index_ = 0;
+
+        std::atomic<uint64_t> records_written_{0};
+        std::atomic<uint64_t> records_dropped_{0};
+        std::atomic<uint32_t> segments_opened_{0};
+    };
+
+    // Reads a journal's records in order across its segments. Segments are
+    // memory-mapped, so record data points straight into the file.
+    class CaptureReader
+    {
+    public:
+        explicit CaptureReader(std::string base_path);
+        ~CaptureReader();
+
+        CaptureReader(const CaptureReader &) = delete;
+        CaptureReader &operator=(const CaptureReader &) = delete;
+
+        // Finds the segments on disk. False if there are none.
+        bool open();
+
+        // Next record; `record.data` stays valid until the following call.
+        bool next(CaptureRecord &record);
+
+        size_t segment_count() const { return segments_.size(); }
+
+    private:
+        bool map_segment(size_t position);
+        void unmap_segment();
+
+        std::string base_path_;
+        std::vector<uint32_t> segments_; // Indices present on disk, ascending
+        size_t current_ = 0;
+        const char *map_ = nullptr;
+        size_t map_bytes_ = 0;
+        size_t offset_ = 0;
+    };
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_CAPTUREJOURNAL_H
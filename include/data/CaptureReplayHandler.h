@@ -0,0 +1,68 @@
+#ifndef HFT_SYSTEM_CAPTUREREPLAYHANDLER_H
+#define HFT_SYSTEM_CAPTUREREPLAYHANDLER_H
+
+#include "../../include/data/DataHandler.h"
+#include "CaptureJournal.h"
+#include "StreamProcessor.h"
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hft_system {
+
+// Replays raw frames journaled by WebSocketDataHandler (websocket.capture_path)
+// through the same StreamProcessor the live connections use, so books, trades
+// and quotes come out exactly as they did live. Journals <base>.0, <base>.1, ...
+// (one per live connection) are merged by receive time; a bare <base> journal
+// is read if there is no <base>.0.
+class CaptureReplayHandler : public DataHandler {
+public:
+    CaptureReplayHandler(std::shared_ptr<EventBus> event_bus, std::string base_path, size_t book_depth = 20);
+    ~CaptureReplayHandler();
+
+    // Overrides from the Component base class
+    void start() override;
+    void stop() override;
+
+    // Override from the DataHandler base class
+    void run() override;
+
+    // Pace relative to the recorded receive times: 1 is real time, 10 ten times
+    // faster, 0 as fast as the parse path allows.
+    void set_replay_speed(double speed) { replay_speed_ = speed; }
+
+    uint64_t records_replayed() const { return records_replayed_.load(std::memory_order_relaxed); }
+
+    // Per stream name: messages, msgs_per_sec, bytes, avg_parse_ns and max_parse_ns.
+    std::map<std::string, std::map<std::string, double>> get_stream_statistics() const;
+
+private:
+    struct Journal
+    {
+        std::unique_ptr<CaptureReader> reader;
+        std::unique_ptr<StreamProcessor> processor;
+        CaptureRecord record;
+        bool has_record = false;
+    };
+
+    bool open_journals();
+    void replay_record(Journal &journal);
+
+    std::string base_path_;
+    size_t book_depth_;
+    std::thread data_thread_;
+    std::atomic<bool> is_running_;
+    double replay_speed_ = 1.0;
+    std::vector<Journal> journals_;
+    std::vector<char> frame_;     // Padded copy of the frame being parsed
+    double replay_seconds_ = 0.0; // Wall time of the last run, for statistics
+    std::atomic<uint64_t> records_replayed_{0};
+};
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_CAPTUREREPLAYHANDLER_H
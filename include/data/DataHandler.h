@@ -2,6 +2,9 @@
 #define HFT_SYSTEM_DATAHANDLER_H
 
 #include "../core/Component.h"
+#include "../core/EventBus.h"
+#include <chrono>
+#include <thread>
 
 namespace hft_system {
 
@@ -16,6 +19,23 @@ public:
     // For historical data, it reads from a file.
     // For live data, it listens to a websocket.
     virtual void run() = 0;
+
+    // Replays publish one event at a time and wait for the EventBus to have
+    // handled it, and everything it triggered, before the next. Deterministic
+    // where a replay delay only makes a race unlikely.
+    void set_lockstep(bool lockstep) { lockstep_ = lockstep; }
+
+protected:
+    // Between two replayed events: waits out the first in lockstep, then sleeps `delay`.
+    void pace(std::chrono::microseconds delay)
+    {
+        if (lockstep_)
+            event_bus_->wait_until_idle();
+        if (delay.count() > 0)
+            std::this_thread::sleep_for(delay);
+    }
+
+    bool lockstep_ = false;
 };
 
 } // namespace hft_system
@@ -0,0 +1,40 @@
+#ifndef HFT_SYSTEM_DATASET_H
+#define HFT_SYSTEM_DATASET_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace hft_system
+{
+
+    // A decoded, read-only slice of a historical OHLCV file.
+    // Columns are stored contiguously (structure of arrays) so a replay only
+    // touches the columns it needs and many backtests can share one copy.
+    struct Dataset
+    {
+        std::string file_path;
+        int64_t start_time = 0;
+        int64_t end_time = 0;
+
+        std::vector<int64_t> timestamps;
+        std::vector<double> open;
+        std::vector<double> high;
+        std::vector<double> low;
+        std::vector<double> close;
+        std::vector<double> volume;
+
+        size_t size() const { return timestamps.size(); }
+        bool empty() const { return timestamps.empty(); }
+
+        size_t memory_bytes() const
+        {
+            return timestamps.capacity() * sizeof(int64_t) +
+                   (open.capacity() + high.capacity() + low.capacity() + close.capacity() + volume.capacity()) * sizeof(double);
+        }
+    };
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_DATASET_H
@@ -0,0 +1,53 @@
+#ifndef HFT_SYSTEM_DATASETCACHE_H
+#define HFT_SYSTEM_DATASETCACHE_H
+
+#include "../../include/data/Dataset.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <cstdint>
+
+namespace hft_system
+{
+
+    // Process-wide cache of decoded datasets keyed by (file, start, end).
+    // Entries are reference counted: the cache only holds weak references, so a
+    // dataset lives exactly as long as some backtest (or an explicit pin, such
+    // as the Optimizer's) holds the returned pointer. Concurrent requests for
+    // the same key wait for a single load instead of parsing the file twice.
+    class DatasetCache
+    {
+    public:
+        static DatasetCache &get_instance();
+
+        // Returns the dataset for rows with start <= timestamp < end, loading it on
+        // first use. Returns nullptr if the file cannot be read.
+        std::shared_ptr<const Dataset> acquire(const std::string &file_path, int64_t start, int64_t end);
+
+        // Number of times a file was actually parsed (for diagnostics and tests).
+        size_t load_count() const;
+
+    private:
+        DatasetCache() = default;
+        DatasetCache(const DatasetCache &) = delete;
+        DatasetCache &operator=(const DatasetCache &) = delete;
+
+        struct Entry
+        {
+            std::mutex load_mutex;
+            std::weak_ptr<const Dataset> dataset;
+        };
+        using Key = std::tuple<std::string, int64_t, int64_t>;
+
+        static std::shared_ptr<const Dataset> load(const std::string &file_path, int64_t start, int64_t end);
+
+        mutable std::mutex mutex_;
+        std::map<Key, std::shared_ptr<Entry>> entries_;
+        size_t load_count_ = 0;
+    };
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_DATASETCACHE_H
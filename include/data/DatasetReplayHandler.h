@@ -0,0 +1,42 @@
+#ifndef HFT_SYSTEM_DATASETREPLAYHANDLER_H
+#define HFT_SYSTEM_DATASETREPLAYHANDLER_H
+
+#include "../../include/data/DataHandler.h"
+#include "../../include/data/Dataset.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace hft_system {
+
+// Replays an already decoded Dataset (usually shared through the DatasetCache)
+// as MarketEvents, with the same pacing and completion signal as HistoricCSVDataHandler.
+class DatasetReplayHandler : public DataHandler {
+public:
+    DatasetReplayHandler(std::shared_ptr<EventBus> event_bus, std::string symbol, std::shared_ptr<const Dataset> dataset);
+    ~DatasetReplayHandler();
+
+    // Overrides from the Component base class
+    void start() override;
+    void stop() override;
+
+    // Override from the DataHandler base class
+    void run() override;
+
+    // Pause between published events. Zero publishes in batches.
+    void set_replay_delay(std::chrono::microseconds delay) { replay_delay_ = delay; }
+
+private:
+    std::string symbol_;
+    SymbolId symbol_id_;
+    std::shared_ptr<const Dataset> dataset_;
+    std::thread data_thread_;
+    std::atomic<bool> is_running_;
+    std::chrono::microseconds replay_delay_{100};
+};
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_DATASETREPLAYHANDLER_H
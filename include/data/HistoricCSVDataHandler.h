@@ -2,12 +2,25 @@
 #define HFT_SYSTEM_HISTORICCSVDATAHANDLER_H
 
 #include "../../include/data/DataHandler.h"
+#include "../../include/data/PrefetchReader.h"
+#include "../../include/utils/BoundedQueue.h"
+#include "../../include/utils/StageStats.h"
+#include "../../include/core/DataTypes.h"
 #include <string>
+#include <string_view>
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <limits>
+#include <vector>
 
 namespace hft_system {
 
+// Replays a CSV file through a three stage pipeline:
+//   I/O (PrefetchReader thread) -> parse (data thread) -> publish (publisher thread).
+// Each stage records busy/wait time so the bottleneck can be identified.
 class HistoricCSVDataHandler : public DataHandler {
 public:
     HistoricCSVDataHandler(std::shared_ptr<EventBus> event_bus, std::string symbol, std::string file_path);
@@ -20,13 +33,46 @@ public:
     // Override from the DataHandler base class
     void run() override;
 
+    // Pause between published events. Zero publishes each parsed batch in one go.
+    void set_replay_delay(std::chrono::microseconds delay) { replay_delay_ = delay; }
+
+    // Restricts replay to rows with start <= timestamp < end (same units as the file).
+    // The start is located through the file's sidecar TimeIndex instead of a linear scan.
+    void set_time_range(int64_t start, int64_t end);
+
+    // Per-stage utilisation, keyed by stage name ("io", "parse", "publish").
+    std::map<std::string, std::map<std::string, double>> get_stage_statistics() const;
+
+    // Parses one "timestamp,open,high,low,close,volume" row. Returns false if the
+    // row has too few fields; throws std::exception if a field is not a number.
+    static bool parse_row(std::string_view line, Bar &bar);
+
 private:
+    using EventBatch = std::vector<std::shared_ptr<Event>>;
+
+    void parse_stage(BoundedQueue<EventBatch> &batches);
+    void publish_stage(BoundedQueue<EventBatch> &batches);
+    // Returns false once a row at or past the end of the time range is reached
+    // in a file known to be sorted; in any other file such rows are skipped.
+    bool parse_line(std::string_view line, EventBatch &batch);
+
     std::string symbol_;
+    SymbolId symbol_id_;
     std::string file_path_;
     std::thread data_thread_;
     std::atomic<bool> is_running_;
+    std::chrono::microseconds replay_delay_{100};
+    int64_t start_time_ = std::numeric_limits<int64_t>::min();
+    int64_t end_time_ = std::numeric_limits<int64_t>::max();
+
+    std::unique_ptr<PrefetchReader> reader_;
+    StageStats parse_stats_;
+    StageStats publish_stats_;
+    long line_number_ = 0;
+    bool header_skipped_ = false;
+    bool sorted_ = false; // Rows are in timestamp order, per the TimeIndex
 };
 
 } // namespace hft_system
 
-#endif // HFT_SYSTEM_HISTORICCSVDATAHANDLER_H
\ No newline at end of file
+#endif // HFT_SYSTEM_HISTORICCSVDATAHANDLER_H
@@ -0,0 +1,67 @@
+#ifndef HFT_SYSTEM_LOCALORDERBOOK_H
+#define HFT_SYSTEM_LOCALORDERBOOK_H
+
+#include "../core/DataTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hft_system
+{
+
+    // Full-depth book for one symbol maintained from a snapshot plus incremental
+    // diffs (Binance @depth semantics: a quantity of zero removes the level).
+    //
+    // Each side is a flat array sorted so that the best level is at the back:
+    // bids ascending, asks descending. Best-level access is O(1), and updates
+    // near the top, which are the vast majority, only shift a few elements.
+    class LocalOrderBook
+    {
+    public:
+        enum class ApplyResult
+        {
+            APPLIED,
+            STALE,     // Entirely covered by the snapshot or an earlier diff; ignored
+            GAP,       // Sequence ids skipped ahead; the book needs a new snapshot
+            NOT_SYNCED // No snapshot applied yet
+        };
+
+        explicit LocalOrderBook(std::string symbol = "");
+
+        // Replaces the book with a snapshot whose levels may come in any order.
+        void apply_snapshot(const DepthUpdate &snapshot, int64_t last_update_id);
+
+        // Applies a diff covering update ids [first_update_id, final_update_id].
+        ApplyResult apply_diff(const DepthUpdate &diff, int64_t first_update_id, int64_t final_update_id);
+
+        // Writes the best `depth` levels per side (at most MAX_BOOK_DEPTH), best first, into `out`.
+        void top_n(size_t depth, OrderBook &out) const;
+
+        bool is_synced() const { return synced_; }
+        void invalidate() { synced_ = false; }
+        int64_t last_update_id() const { return last_update_id_; }
+        const std::string &symbol() const { return symbol_; }
+        SymbolId symbol_id() const { return symbol_id_; }
+
+        bool has_bid() const { return !bids_.empty(); }
+        bool has_ask() const { return !asks_.empty(); }
+        const OrderBookLevel &best_bid() const { return bids_.back(); }
+        const OrderBookLevel &best_ask() const { return asks_.back(); }
+        size_t bid_depth() const { return bids_.size(); }
+        size_t ask_depth() const { return asks_.size(); }
+
+    private:
+        std::string symbol_;
+        SymbolId symbol_id_ = INVALID_SYMBOL_ID;
+        std::vector<OrderBookLevel> bids_; // Ascending; best at back
+        std::vector<OrderBookLevel> asks_; // Descending; best at back
+        int64_t last_update_id_ = 0;
+        int64_t timestamp_ = 0;
+        bool synced_ = false;
+        bool applied_since_snapshot_ = false;
+    };
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_LOCALORDERBOOK_H
@@ -0,0 +1,123 @@
+#ifndef HFT_SYSTEM_PREFETCHREADER_H
+#define HFT_SYSTEM_PREFETCHREADER_H
+
+#include "../utils/BoundedQueue.h"
+#include "../utils/StageStats.h"
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace hft_system
+{
+
+    // I/O stage of the historical data pipeline.
+    // A dedicated thread fills a small pool of large, page-aligned blocks with
+    // pread() while the consumer parses the previous one (double buffering with
+    // the default of two buffers). The kernel is told the access pattern is
+    // sequential and asked to read ahead of the block currently in flight.
+    class PrefetchReader
+    {
+    public:
+        struct Block
+        {
+            const char *data = nullptr;
+            size_t size = 0;
+            int64_t file_offset = 0;
+            size_t buffer_index = 0;
+        };
+
+        static constexpr size_t DEFAULT_BLOCK_SIZE = 1 << 20; // 1 MiB
+        static constexpr size_t DEFAULT_NUM_BUFFERS = 2;
+
+        PrefetchReader(std::string file_path,
+                       size_t block_size = DEFAULT_BLOCK_SIZE,
+                       size_t num_buffers = DEFAULT_NUM_BUFFERS);
+        ~PrefetchReader();
+
+        PrefetchReader(const PrefetchReader &) = delete;
+        PrefetchReader &operator=(const PrefetchReader &) = delete;
+
+        // Opens the file and starts the I/O thread at `start_offset`.
+        // Returns false if the file cannot be opened.
+        bool start(int64_t start_offset = 0);
+        void stop();
+
+        // Consumer side. Blocks until the next block is filled; returns false at end of file.
+        // Every acquired block must be handed back with release() once it has been parsed.
+        bool acquire(Block &block);
+        void release(const Block &block);
+
+        // Convenience consumer for callers that just want lines: streams every line
+        // (without its '\n') together with its byte offset, reassembling lines that
+        // straddle blocks. `on_line(std::string_view, int64_t)` returns false to stop early.
+        template <typename LineHandler>
+        void for_each_line(LineHandler &&on_line);
+
+        const StageStats &stats() const { return stats_; }
+
+    private:
+        void io_loop();
+
+        std::string file_path_;
+        size_t block_size_;
+        int fd_ = -1;
+        int64_t start_offset_ = 0;
+        std::vector<char *> buffers_;
+        BoundedQueue<size_t> free_buffers_;
+        BoundedQueue<Block> filled_blocks_;
+        std::thread io_thread_;
+        std::atomic<bool> is_running_{false};
+        StageStats stats_;
+    };
+
+    template <typename LineHandler>
+    void PrefetchReader::for_each_line(LineHandler &&on_line)
+    {
+        std::string carry;
+        int64_t carry_offset = 0;
+        Block block;
+        bool keep_going = true;
+        while (keep_going && acquire(block))
+        {
+            const char *cursor = block.data;
+            const char *end = block.data + block.size;
+            while (cursor < end)
+            {
+                int64_t line_offset = block.file_offset + (cursor - block.data);
+                const char *newline = static_cast<const char *>(std::memchr(cursor, '\n', end - cursor));
+                if (!newline)
+                {
+                    if (carry.empty())
+                        carry_offset = line_offset;
+                    carry.append(cursor, end);
+                    break;
+                }
+                if (!carry.empty())
+                {
+                    carry.append(cursor, newline);
+                    keep_going = on_line(std::string_view(carry), carry_offset);
+                    carry.clear();
+                }
+                else
+                {
+                    keep_going = on_line(std::string_view(cursor, newline - cursor), line_offset);
+                }
+                cursor = newline + 1;
+                if (!keep_going)
+                    break;
+            }
+            release(block);
+        }
+        if (keep_going && !carry.empty())
+        {
+            on_line(std::string_view(carry), carry_offset);
+        }
+    }
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_PREFETCHREADER_H
@@ -0,0 +1,96 @@
+#ifndef HFT_SYSTEM_REPLAYSERVER_H
+#define HFT_SYSTEM_REPLAYSERVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+namespace hft_system
+{
+
+    struct ReplayServerOptions
+    {
+        // JSON lines of recorded Binance messages: raw stream payloads
+        // (depthUpdate, trade, bookTicker) or whole combined-stream frames.
+        std::string messages_file;
+        std::string host = "127.0.0.1";
+        unsigned short port = 0; // 0 binds a free port; see ReplayServer::port()
+        // 1 replays at the recorded pace (from "E"), N replays N times faster, 0 sends flat out.
+        double speed = 1.0;
+        int loops = 1;               // Passes over the recording per connection
+        size_t disconnect_after = 0; // Drop each connection after this many messages; 0 never
+        // Indices into the recording that are never sent, to simulate frames lost upstream.
+        std::vector<size_t> drop_messages;
+        bool record_send_times = false;
+    };
+
+    // Plain-WebSocket stand-in for the Binance combined-stream endpoint, so the
+    // LIVE path can be load tested offline. A client connects, sends the usual
+    // SUBSCRIBE request, gets the acknowledgement, and then receives every
+    // recorded message of the streams it subscribed to, wrapped in
+    // {"stream":..,"data":..} envelopes and paced according to the options.
+    // All connections are served asynchronously on one io thread.
+    class ReplayServer
+    {
+    public:
+        struct Message
+        {
+            std::string stream;     // e.g. "btcusdt@depth"
+            int64_t event_time = 0; // Milliseconds, from the payload's "E" where present
+            std::string frame;      // Combined-stream frame as sent
+        };
+
+        struct SendRecord
+        {
+            size_t message;      // Index into messages()
+            int64_t sent_at_ns; // system_clock nanoseconds, comparable with Event::timestamp
+        };
+
+        explicit ReplayServer(ReplayServerOptions options);
+        ~ReplayServer();
+
+        ReplayServer(const ReplayServer &) = delete;
+        ReplayServer &operator=(const ReplayServer &) = delete;
+
+        // Loads the recording, binds and starts serving. Returns false on failure.
+        bool start();
+        void stop();
+
+        unsigned short port() const { return port_; }
+        const std::vector<Message> &messages() const { return messages_; }
+
+        int64_t connections_accepted() const { return connections_accepted_.load(std::memory_order_relaxed); }
+        int64_t messages_sent() const { return messages_sent_.load(std::memory_order_relaxed); }
+        // Only filled when options.record_send_times is set.
+        std::vector<SendRecord> send_records() const;
+
+    private:
+        class Session;
+
+        bool load_messages();
+        void do_accept();
+
+        ReplayServerOptions options_;
+        std::vector<Message> messages_;
+        boost::asio::io_context ioc_;
+        boost::asio::ip::tcp::acceptor acceptor_;
+        std::thread io_thread_;
+        unsigned short port_ = 0;
+        std::vector<std::weak_ptr<Session>> sessions_; // io thread only
+
+        std::atomic<int64_t> connections_accepted_{0};
+        std::atomic<int64_t> messages_sent_{0};
+        mutable std::mutex send_records_mutex_;
+        std::vector<SendRecord> send_records_;
+    };
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_REPLAYSERVER_H
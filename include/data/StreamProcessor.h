@@ -0,0 +1,138 @@
+#ifndef HFT_SYSTEM_STREAMPROCESSOR_H
+#define HFT_SYSTEM_STREAMPROCESSOR_H
+
+#include "../core/EventBus.h"
+#include "BinanceDepthDecoder.h"
+#include "BinanceStreamDecoder.h"
+#include "LocalOrderBook.h"
+#include "TickCodec.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace hft_system
+{
+
+    // Turns the frames of one combined-stream connection into events: routes
+    // them through a BinanceStreamDecoder, maintains the local book of every
+    // depth-subscribed symbol from a snapshot plus diffs, and publishes
+    // OrderBook, Market (trades) and Quote (bookTicker) events.
+    //
+    // While a book waits for a snapshot its depth stream is decoded lazily:
+    // buffered diffs keep their level text, and only those newer than the
+    // snapshot are ever parsed.
+    //
+    // Whenever a book stops being trustworthy (a gap in the U/u update ids, or
+    // the owner resetting a dropped connection) an empty OrderBook is published
+    // for the symbol; consumers must not price off its book until a non-empty
+    // one follows the resynchronisation.
+    //
+    // WebSocketDataHandler drives one per live connection and
+    // CaptureReplayHandler one per captured journal, so recorded frames go
+    // through exactly the same parse path. A processor is driven by one thread.
+    class StreamProcessor
+    {
+    public:
+        static constexpr size_t MAX_PENDING_DIFFS = 10000;
+
+        // State of one symbol.
+        struct Feed
+        {
+            Feed(const std::string &symbol, const InstrumentSpec &spec) : local_book(symbol), snapshot_decoder(spec) {}
+
+            LocalOrderBook local_book;
+            BinanceDepthDecoder snapshot_decoder; // REST snapshots only; diffs come through the stream decoder
+            bool has_depth = false;
+            size_t depth_stream = BinanceStreamDecoder::NO_STREAM;
+            std::deque<RawDepthUpdate> pending_diffs; // Diffs received while waiting for a snapshot
+            bool snapshot_in_flight = false;
+            OrderBook view;                        // Top-N scratch copied into each published event
+            std::unique_ptr<TickWriter> recorder; // Set by the owner to record the published books
+
+            // Bookkeeping of the owner's snapshot fetching.
+            std::string snapshot_file; // Recorded REST response to seed from instead of fetching
+            bool snapshot_file_used = false;
+            std::vector<std::thread> snapshot_threads; // REST fetches, each joined by its own completion
+        };
+
+        // Written by the driving thread only; atomics so stats can be read from elsewhere.
+        struct StreamStats
+        {
+            std::atomic<int64_t> messages{0};
+            std::atomic<int64_t> bytes{0};
+            std::atomic<int64_t> parse_ns{0};
+            std::atomic<int64_t> max_parse_ns{0};
+        };
+
+        // Called when a feed needs a depth snapshot. The answer must come back
+        // through on_snapshot() on the driving thread, now or later.
+        using SnapshotRequest = std::function<void(Feed &)>;
+
+        StreamProcessor(std::shared_ptr<EventBus> event_bus, size_t book_depth, SnapshotRequest request_snapshot);
+
+        // Subscribes a stream such as "btcusdt@depth"; the symbol is its upper-cased
+        // prefix and uses its registered InstrumentSpec. False if the type is unsupported.
+        bool add_stream(std::string_view name);
+
+        Feed *find_feed(std::string_view symbol);
+        const std::vector<std::unique_ptr<Feed>> &feeds() const { return feeds_; }
+        size_t stream_count() const { return decoder_.stream_count(); }
+
+        // {"method":"SUBSCRIBE","params":[...],"id":1} for every added stream.
+        std::string subscribe_message() const;
+
+        // Asks for a snapshot for every depth-subscribed feed.
+        void request_snapshots();
+
+        // `data` must be readable up to `capacity` (size plus simdjson padding).
+        void process_frame(const char *data, size_t size, size_t capacity);
+
+        // Seeds a feed's book from a REST depth snapshot body and replays the
+        // buffered diffs. False if the body is not a usable snapshot.
+        bool on_snapshot(Feed &feed, const std::string &body);
+
+        // Forgets all book state after the connection was lost: books are
+        // invalidated, buffered diffs dropped and snapshot bookkeeping cleared,
+        // ready for request_snapshots() on the next session.
+        void reset();
+
+        // Depth gaps detected since construction.
+        uint64_t gap_count() const { return gaps_.load(std::memory_order_relaxed); }
+
+        // Buffered diffs dropped as stale by a snapshot without their levels being parsed.
+        uint64_t stale_diffs_skipped() const { return stale_diffs_skipped_.load(std::memory_order_relaxed); }
+
+        // Per stream name: messages, msgs_per_sec, bytes, avg_parse_ns and max_parse_ns.
+        void collect_statistics(double seconds, std::map<std::string, std::map<std::string, double>> &out) const;
+
+    private:
+        void request_snapshot(Feed &feed);
+        void on_depth(Feed &feed);
+        void buffer_diff(Feed &feed, RawDepthUpdate diff);
+        void sync_lazy_depth(Feed &feed);
+        void apply_diff(Feed &feed, const DepthUpdate &diff, int64_t first_update_id, int64_t final_update_id);
+        void publish_book(Feed &feed);
+        void publish_unavailable(Feed &feed);
+
+        std::shared_ptr<EventBus> event_bus_;
+        size_t book_depth_;
+        SnapshotRequest request_snapshot_;
+        BinanceStreamDecoder decoder_;
+        std::vector<std::unique_ptr<Feed>> feeds_;
+        std::vector<Feed *> stream_feeds_;   // Feed of each decoder stream
+        std::deque<StreamStats> stream_stats_; // Per decoder stream; deque because atomics cannot move
+        std::atomic<uint64_t> gaps_{0};
+        std::atomic<uint64_t> stale_diffs_skipped_{0};
+    };
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_STREAMPROCESSOR_H
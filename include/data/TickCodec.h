@@ -0,0 +1,211 @@
+#ifndef HFT_SYSTEM_TICKCODEC_H
+#define HFT_SYSTEM_TICKCODEC_H
+
+#include "../core/DataTypes.h"
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace hft_system
+{
+
+    // Compact on-disk encoding for recorded L2 depth updates.
+    //
+    // A tick file is a small header followed by independently decodable blocks.
+    // Inside a block every update is stored as
+    //   varint(zigzag(timestamp delta)) varint(bid count) varint(ask count)
+    // followed by one varint(zigzag(price delta)) varint(quantity) pair per level.
+    // Prices are integer ticks delta-coded against the previous level on the same
+    // side; quantities are integer lots. Delta state resets at every block, so a
+    // reader can start at any block boundary (and skip blocks by their time range).
+    //
+    // Every update is a whole book, best level first on each side: the live
+    // recorder writes the top-N view StreamProcessor publishes, and an update
+    // with no levels records that the book became unavailable. (Version 1 files
+    // held raw depth diffs, which cannot be replayed as books without the
+    // snapshot they applied to.)
+    namespace tick_codec
+    {
+        constexpr char FILE_MAGIC[8] = {'H', 'F', 'T', 'T', 'I', 'C', 'K', 'S'};
+        constexpr uint32_t FILE_VERSION = 2;
+        constexpr uint32_t BLOCK_MAGIC = 0x4B4C4254; // "TBLK"
+        // Decoding reads in whole varints; trailing slack means it never has to bounds-check per byte.
+        constexpr size_t DECODE_PADDING = 32;
+
+        struct FileHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t reserved;
+            double price_tick;
+            double qty_lot;
+            char symbol[32];
+        };
+
+        struct BlockHeader
+        {
+            uint32_t magic;
+            uint32_t update_count;
+            uint32_t level_count;
+            uint32_t payload_bytes;
+            int64_t first_timestamp;
+            int64_t last_timestamp;
+        };
+
+        inline uint64_t zigzag_encode(int64_t value)
+        {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        inline int64_t zigzag_decode(uint64_t value)
+        {
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        inline void write_varint(std::vector<uint8_t> &out, uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        // Most deltas and quantities fit in one or two bytes, so those paths are unrolled.
+        inline uint64_t read_varint(const uint8_t *&cursor)
+        {
+            uint64_t byte = *cursor++;
+            if (byte < 0x80)
+                return byte;
+            uint64_t value = byte & 0x7F;
+            byte = *cursor++;
+            if (byte < 0x80)
+                return value | (byte << 7);
+            value |= (byte & 0x7F) << 7;
+            int shift = 14;
+            do
+            {
+                byte = *cursor++;
+                value |= (byte & 0x7F) << shift;
+                shift += 7;
+            } while ((byte & 0x80) && shift < 64);
+            return value;
+        }
+    } // namespace tick_codec
+
+    // One decoded block, stored column-wise. Levels of update i are
+    // prices/quantities[level_begin[i] .. level_begin[i] + bid_counts[i] + ask_counts[i]),
+    // bids first.
+    struct TickBlock
+    {
+        std::vector<int64_t> timestamps;
+        std::vector<uint32_t> level_begin;
+        std::vector<uint32_t> bid_counts;
+        std::vector<uint32_t> ask_counts;
+        std::vector<int64_t> prices;
+        std::vector<int64_t> quantities;
+
+        size_t update_count() const { return timestamps.size(); }
+        size_t level_count() const { return prices.size(); }
+
+        // Size of the decoded columns, i.e. the logical data the block represents.
+        size_t logical_bytes() const
+        {
+            return timestamps.size() * (sizeof(int64_t) + 3 * sizeof(uint32_t)) +
+                   prices.size() * 2 * sizeof(int64_t);
+        }
+
+        void clear();
+
+        // Rebuilds update `index` as an OrderBook, dropping zero-quantity levels
+        // and keeping at most MAX_BOOK_DEPTH levels per side. An update without
+        // levels gives the empty book that marks the symbol unavailable.
+        // The block's ticks and lots are used as they are, so the symbol's
+        // InstrumentSpec must match the file's price tick and quantity lot.
+        OrderBook to_order_book(size_t index, SymbolId symbol_id) const;
+    };
+
+    // Appends depth updates to a tick file, one block every `updates_per_block` updates.
+    class TickWriter
+    {
+    public:
+        static constexpr size_t DEFAULT_UPDATES_PER_BLOCK = 4096;
+
+        TickWriter(std::string file_path, std::string symbol, double price_tick, double qty_lot,
+                   size_t updates_per_block = DEFAULT_UPDATES_PER_BLOCK);
+        ~TickWriter();
+
+        TickWriter(const TickWriter &) = delete;
+        TickWriter &operator=(const TickWriter &) = delete;
+
+        // Creates (truncates) the file and writes its header. Returns false on I/O failure.
+        bool open();
+        // Levels must already be on this writer's price tick and quantity lot grid.
+        void append(const DepthUpdate &book);
+        void append(const OrderBook &book);
+        void flush();
+        void close();
+
+        uint64_t bytes_written() const { return bytes_written_; }
+        uint64_t updates_written() const { return updates_written_; }
+
+    private:
+        void begin_update(int64_t timestamp, size_t bid_count, size_t ask_count);
+        void append_level(Price price, Quantity quantity, int64_t &last_price);
+        void end_update(int64_t timestamp, size_t level_count);
+
+        std::string file_path_;
+        std::string symbol_;
+        double price_tick_;
+        double qty_lot_;
+        size_t updates_per_block_;
+        std::FILE *file_ = nullptr;
+
+        std::vector<uint8_t> payload_;
+        tick_codec::BlockHeader block_{};
+        int64_t last_timestamp_ = 0;
+        int64_t last_bid_ = 0;
+        int64_t last_ask_ = 0;
+        uint64_t bytes_written_ = 0;
+        uint64_t updates_written_ = 0;
+    };
+
+    // Sequential block reader for tick files.
+    class TickReader
+    {
+    public:
+        explicit TickReader(std::string file_path);
+        ~TickReader();
+
+        TickReader(const TickReader &) = delete;
+        TickReader &operator=(const TickReader &) = delete;
+
+        // Opens the file and validates its header. Returns false if it is missing or not a tick file.
+        bool open();
+
+        // Decodes the next block whose time range reaches `min_timestamp`; blocks
+        // entirely before it are skipped without decoding. Returns false at end of file.
+        // Throws std::runtime_error on a truncated or corrupt block.
+        bool next_block(TickBlock &block, int64_t min_timestamp = std::numeric_limits<int64_t>::min());
+
+        const std::string &symbol() const { return symbol_; }
+        double price_tick() const { return price_tick_; }
+        double qty_lot() const { return qty_lot_; }
+
+        static void decode_block(const tick_codec::BlockHeader &header, const uint8_t *payload, TickBlock &block);
+
+    private:
+        std::string file_path_;
+        std::FILE *file_ = nullptr;
+        std::string symbol_;
+        double price_tick_ = 0.0;
+        double qty_lot_ = 0.0;
+        std::vector<uint8_t> payload_;
+    };
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_TICKCODEC_H
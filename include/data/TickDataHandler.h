@@ -0,0 +1,47 @@
+#ifndef HFT_SYSTEM_TICKDATAHANDLER_H
+#define HFT_SYSTEM_TICKDATAHANDLER_H
+
+#include "../../include/data/DataHandler.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace hft_system {
+
+// Replays a recorded tick file (see TickCodec.h) as OrderBookEvents.
+// Blocks are decoded one at a time, so memory use does not grow with the file.
+class TickDataHandler : public DataHandler {
+public:
+    TickDataHandler(std::shared_ptr<EventBus> event_bus, std::string file_path);
+    ~TickDataHandler();
+
+    // Overrides from the Component base class
+    void start() override;
+    void stop() override;
+
+    // Override from the DataHandler base class
+    void run() override;
+
+    // Pause between published events. Zero publishes each decoded block in one go.
+    void set_replay_delay(std::chrono::microseconds delay) { replay_delay_ = delay; }
+
+    // Restricts replay to updates with start <= timestamp < end. Blocks that end
+    // before `start` are skipped without being decoded.
+    void set_time_range(int64_t start, int64_t end);
+
+private:
+    std::string file_path_;
+    std::thread data_thread_;
+    std::atomic<bool> is_running_;
+    std::chrono::microseconds replay_delay_{100};
+    int64_t start_time_ = std::numeric_limits<int64_t>::min();
+    int64_t end_time_ = std::numeric_limits<int64_t>::max();
+};
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_TICKDATAHANDLER_H
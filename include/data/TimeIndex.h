@@ -0,0 +1,58 @@
+#ifndef HFT_SYSTEM_TIMEINDEX_H
+#define HFT_SYSTEM_TIMEINDEX_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace hft_system
+{
+
+    // Sparse timestamp -> byte offset index for a time-ordered CSV file.
+    // One entry is kept for every `stride` rows, so seeking is a binary search
+    // over the entries followed by a short forward scan of at most `stride` rows.
+    // The index is persisted next to the data file (<file>.tsidx) and rebuilt
+    // automatically when the data file's size or modification time changes.
+    class TimeIndex
+    {
+    public:
+        struct Entry
+        {
+            int64_t timestamp;
+            int64_t offset;
+        };
+
+        static constexpr uint32_t DEFAULT_STRIDE = 1024;
+
+        // Loads the sidecar index for `data_file`, building and saving it first if
+        // it is missing or stale. Throws std::runtime_error if the data file cannot be read.
+        static TimeIndex load_or_build(const std::string &data_file, uint32_t stride = DEFAULT_STRIDE);
+
+        static std::string sidecar_path(const std::string &data_file) { return data_file + ".tsidx"; }
+
+        // Byte offset of a row boundary at or before the first row with timestamp >= `timestamp`.
+        int64_t seek(int64_t timestamp) const;
+
+        // Offset of the first data row (just past the header).
+        int64_t data_offset() const { return data_offset_; }
+        const std::vector<Entry> &entries() const { return entries_; }
+        bool is_sorted() const { return sorted_; }
+        bool loaded_from_disk() const { return loaded_from_disk_; }
+
+    private:
+        static TimeIndex build(const std::string &data_file, uint32_t stride);
+        bool load(const std::string &data_file);
+        void save(const std::string &data_file) const;
+
+        uint32_t stride_ = DEFAULT_STRIDE;
+        uint64_t source_size_ = 0;
+        int64_t source_mtime_ = 0;
+        int64_t data_offset_ = 0;
+        bool sorted_ = true;
+        bool loaded_from_disk_ = false;
+        std::vector<Entry> entries_;
+    };
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_TIMEINDEX_H
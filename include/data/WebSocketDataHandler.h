@@ -3,11 +3,19 @@
 
 #include "DataHandler.h"
 #include "../config/Config.h"
+#include "CaptureJournal.h"
+#include "StreamProcessor.h"
+#include <atomic>
+#include <chrono>
 #include <thread>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 #include <boost/beast/core.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/beast/websocket.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
 
 namespace beast = boost::beast;
@@ -21,6 +29,20 @@ using tcp = boost::asio::ip::tcp;
 namespace hft_system
 {
 
+    // Live market data over Binance combined-stream connections. Every
+    // configured symbol gets its streams (depth, trade, bookTicker) on one
+    // connection; symbols are sharded round-robin across a small pool of
+    // connections, each driven by its own io_context thread, and frames are
+    // routed to per-symbol state by stream name. All state of a symbol is only
+    // touched on its connection's thread.
+    //
+    // A connection that drops, or whose books cannot be resynchronised in
+    // place, is reconnected with exponential backoff; its books are published
+    // as unavailable (empty) until the new session's snapshots land.
+    //
+    // With capture_path set, each connection also journals its raw frames to a
+    // CaptureWriter; CaptureReplayHandler plays such journals back through the
+    // same StreamProcessor.
     class WebSocketDataHandler : public DataHandler, public std::enable_shared_from_this<WebSocketDataHandler>
     {
     public:
@@ -31,23 +53,89 @@ namespace hft_system
         void stop() override;
         void run() override;
 
+        // Upper-case names of the symbols `config` subscribes to.
+        static std::vector<std::string> subscribed_symbols(const WebSocketConfig &config);
+
+        // Per stream name: messages, msgs_per_sec, bytes, avg_parse_ns and max_parse_ns.
+        std::map<std::string, std::map<std::string, double>> get_stream_statistics() const;
+
+        // Totals over all connections since start().
+        int64_t reconnect_count() const;
+        uint64_t gap_count() const;
+
     private:
-        void on_resolve(beast::error_code ec, tcp::resolver::results_type results);
-        void on_connect(beast::error_code ec, tcp::resolver::results_type::iterator endpoint_iter);
-        void on_ssl_handshake(beast::error_code ec);
-        void on_handshake(beast::error_code ec);
-        void on_write(beast::error_code ec, std::size_t bytes_transferred);
-        void on_read(beast::error_code ec, std::size_t bytes_transferred);
-        void on_close(beast::error_code ec);
-        void process_message(const std::string &message);
+        struct Connection
+        {
+            Connection(WebSocketDataHandler &owner, ssl::context &ctx)
+                : resolver(net::make_strand(ioc)),
+                  reconnect_timer(ioc),
+                  processor(owner.event_bus_, static_cast<size_t>(owner.config_.book_depth),
+                            [&owner, this](StreamProcessor::Feed &feed)
+                            { owner.request_snapshot(*this, feed); })
+            {
+                make_stream(ctx, owner.config_.use_tls);
+            }
+
+            // A websocket stream cannot be reopened, so every session gets a fresh one.
+            void make_stream(ssl::context &ctx, bool use_tls)
+            {
+                tls_ws.reset();
+                plain_ws.reset();
+                if (use_tls)
+                    tls_ws = std::make_unique<websocket::stream<beast::ssl_stream<tcp::socket>>>(net::make_strand(ioc), ctx);
+                else
+                    plain_ws = std::make_unique<websocket::stream<tcp::socket>>(net::make_strand(ioc));
+            }
+
+            // Calls `f` with whichever websocket stream this connection uses.
+            template <typename F>
+            void visit_ws(F &&f)
+            {
+                if (tls_ws)
+                    f(*tls_ws);
+                else
+                    f(*plain_ws);
+            }
+
+            size_t index = 0;
+            net::io_context ioc;
+            tcp::resolver resolver;
+            std::unique_ptr<websocket::stream<beast::ssl_stream<tcp::socket>>> tls_ws; // Exchange endpoints
+            std::unique_ptr<websocket::stream<tcp::socket>> plain_ws;                  // Local replay servers
+            beast::flat_buffer buffer;
+            std::thread thread;
+            std::string subscribe_message;
+            net::steady_timer reconnect_timer;
+            uint64_t session = 0;       // Bumped when a session is lost; its late completions are dropped
+            int reconnect_attempts = 0; // Consecutive attempts since the last good handshake
+            std::atomic<int64_t> reconnects{0};
+            StreamProcessor processor;
+            std::unique_ptr<CaptureWriter> capture; // Only set when config.capture_path is configured
+        };
+
+        void on_resolve(Connection *connection, uint64_t session, beast::error_code ec, tcp::resolver::results_type results);
+        void on_connect(Connection *connection, uint64_t session, beast::error_code ec, tcp::resolver::results_type::iterator endpoint_iter);
+        void on_ssl_handshake(Connection *connection, uint64_t session, beast::error_code ec);
+        void websocket_handshake(Connection *connection);
+        void on_handshake(Connection *connection, uint64_t session, beast::error_code ec);
+        void on_write(Connection *connection, uint64_t session, beast::error_code ec, std::size_t bytes_transferred);
+        void on_read(Connection *connection, uint64_t session, beast::error_code ec, std::size_t bytes_transferred);
+
+        // Invalidates the connection's books and reconnects it after a backoff.
+        void schedule_reconnect(Connection *connection, uint64_t session, beast::error_code ec, const char *what);
+        void on_reconnect_timer(Connection *connection, beast::error_code ec);
+        void connect(Connection *connection);
+
+        // Snapshot fetching. Results are delivered on the connection's thread.
+        void request_snapshot(Connection &connection, StreamProcessor::Feed &feed);
+        void deliver_snapshot(Connection &connection, StreamProcessor::Feed &feed, const std::string &body);
+        void capture(Connection &connection, CaptureRecord::Kind kind, std::string_view data);
 
         WebSocketConfig config_;
-        net::io_context ioc_;
         ssl::context ctx_{ssl::context::tlsv12_client};
-        tcp::resolver resolver_;
-        websocket::stream<beast::ssl_stream<tcp::socket>> ws_;
-        beast::flat_buffer buffer_;
-        std::thread ioc_thread_;
+        std::vector<std::unique_ptr<Connection>> connections_;
+        std::chrono::steady_clock::time_point started_at_;
+        std::atomic<bool> running_{false};
     };
 
 } // namespace hft_system
@@ -19,7 +19,10 @@ namespace hft_system
         PORTFOLIO_UPDATE,
         NEWS,
         MARKET_REGIME_CHANGED, // Add this
-        SYSTEM
+        BAR,
+        QUOTE,
+        SYSTEM,
+        SNAPSHOT // Asks the Application to capture component state; carries no data
     };
 
     // This struct holds the current market state
@@ -39,6 +42,8 @@ namespace hft_system
         } trend = Trend::SIDEWAYS;
     };
 
+    // Events identify instruments by SymbolId (see SymbolRegistry); names are
+    // resolved only where they leave the system, e.g. in logs and reports.
     struct Event
     {
         explicit Event(EventType type) : type(type)
@@ -63,66 +68,96 @@ namespace hft_system
     // --- ADD THIS NEW EVENT STRUCT ---
     struct NewsEvent : public Event
     {
-        NewsEvent(std::string symbol, std::string headline, double sentiment_score)
-            : Event(EventType::NEWS), symbol(std::move(symbol)),
+        NewsEvent(SymbolId symbol_id, std::string headline, double sentiment_score)
+            : Event(EventType::NEWS), symbol_id(symbol_id),
               headline(std::move(headline)), sentiment_score(sentiment_score) {}
 
-        const std::string symbol;
+        const SymbolId symbol_id;
         const std::string headline;
         const double sentiment_score; // e.g., -1.0 (very negative) to 1.0 (very positive)
     };
     struct MarketEvent : public Event
     {
-        MarketEvent(std::string symbol, double price)
-            : Event(EventType::MARKET), symbol(std::move(symbol)), price(price) {}
+        MarketEvent(SymbolId symbol_id, double price, long long exchange_time = 0, double volume = 0.0)
+            : Event(EventType::MARKET), symbol_id(symbol_id), price(price),
+              exchange_time(exchange_time), volume(volume) {}
 
-        const std::string symbol;
+        const SymbolId symbol_id;
         const double price;
+        const long long exchange_time; // Nanoseconds since epoch at the source; 0 if unknown
+        const double volume;           // Traded volume behind this price; 0 if unknown
+    };
+
+    // A completed OHLCV bar. bar.timestamp is the window's open time in nanoseconds.
+    struct BarEvent : public Event
+    {
+        BarEvent(SymbolId symbol_id, BarSpec spec, Bar bar)
+            : Event(EventType::BAR), symbol_id(symbol_id), spec(spec), bar(bar) {}
+
+        const SymbolId symbol_id;
+        const BarSpec spec;
+        const Bar bar;
     };
 
     struct OrderBookEvent : public Event
     {
-        OrderBookEvent(OrderBook book)
-            : Event(EventType::ORDER_BOOK), book(std::move(book)) {}
+        OrderBookEvent(const OrderBook &book)
+            : Event(EventType::ORDER_BOOK), book(book) {}
         const OrderBook book;
     };
 
+    // Best bid and ask of a symbol, e.g. from a bookTicker stream.
+    struct QuoteEvent : public Event
+    {
+        QuoteEvent(SymbolId symbol_id, long long update_id, Price bid_price, Quantity bid_quantity,
+                   Price ask_price, Quantity ask_quantity)
+            : Event(EventType::QUOTE), symbol_id(symbol_id), update_id(update_id),
+              bid_price(bid_price), bid_quantity(bid_quantity), ask_price(ask_price), ask_quantity(ask_quantity) {}
+
+        const SymbolId symbol_id;
+        const long long update_id;
+        const Price bid_price;
+        const Quantity bid_quantity;
+        const Price ask_price;
+        const Quantity ask_quantity;
+    };
+
     struct SignalEvent : public Event
     {
-        SignalEvent(std::string symbol, OrderDirection direction)
-            : Event(EventType::SIGNAL), symbol(std::move(symbol)), direction(direction) {}
+        SignalEvent(SymbolId symbol_id, OrderDirection direction)
+            : Event(EventType::SIGNAL), symbol_id(symbol_id), direction(direction) {}
 
-        const std::string symbol;
+        const SymbolId symbol_id;
         const OrderDirection direction;
     };
 
     struct OrderEvent : public Event
     {
-        OrderEvent(std::string symbol, OrderDirection direction, double quantity, double market_price) // Changed int to double
-            : Event(EventType::ORDER), symbol(std::move(symbol)), direction(direction),
+        OrderEvent(SymbolId symbol_id, OrderDirection direction, Quantity quantity, Price market_price)
+            : Event(EventType::ORDER), symbol_id(symbol_id), direction(direction),
               quantity(quantity), market_price(market_price)
         {
         }
 
-        const std::string symbol;
+        const SymbolId symbol_id;
         const OrderDirection direction;
-        const double quantity; // Already correct
-        const double market_price;
+        const Quantity quantity;
+        const Price market_price;
     };
 
     struct FillEvent : public Event
     {
-        FillEvent(std::string symbol, OrderDirection direction, double quantity, double fill_price, double commission) // Changed int to double
-            : Event(EventType::FILL), symbol(std::move(symbol)), direction(direction),
+        FillEvent(SymbolId symbol_id, OrderDirection direction, Quantity quantity, Price fill_price, double commission)
+            : Event(EventType::FILL), symbol_id(symbol_id), direction(direction),
               quantity(quantity), fill_price(fill_price), commission(commission)
         {
         }
 
-        const std::string symbol;
+        const SymbolId symbol_id;
         const OrderDirection direction;
-        const double quantity; // Changed from int to double
-        const double fill_price;
-        const double commission;
+        const Quantity quantity;
+        const Price fill_price;
+        const double commission; // Quote currency
     };
 
     struct PortfolioUpdateEvent : public Event
@@ -0,0 +1,35 @@
+#ifndef HFT_SYSTEM_ORDERSIZING_H
+#define HFT_SYSTEM_ORDERSIZING_H
+
+#include "../core/DataTypes.h"
+
+namespace hft_system
+{
+
+    // Size of the order a signal turns into, as the RiskManager sizes it. The
+    // backtest engines that simulate the RiskManager without the EventBus call
+    // the same function, so their orders match lot for lot.
+    struct OrderSizing
+    {
+        enum class Result
+        {
+            OK,
+            ZERO_QUANTITY,    // No whole lot to send; the positive minimums always ask for one
+            INSUFFICIENT_CASH // The order would cost more than the cash available
+        };
+
+        Result result = Result::OK;
+        double raw_quantity = 0.0; // Risk amount over price, before the exchange minimums
+        Quantity quantity;         // Whole lots
+        double notional = 0.0;     // quantity at `price`
+    };
+
+    // Spends at most `risk_amount` at `price` (which must be positive), in
+    // whole lots rounded down, unless that is below the exchange's minimum
+    // quantity or order value: then the fewest whole lots that meet both. The
+    // order is then checked against `cash`.
+    OrderSizing size_order(double risk_amount, double cash, Price price, const InstrumentSpec &spec);
+
+} // namespace hft_system
+
+#endif // HFT_SYSTEM_ORDERSIZING_H
@@ -4,8 +4,8 @@
 #include "../core/Component.h"
 #include "../config/Config.h"
 #include "../analytics/MLModelManager.h"
-#include <map>
 #include <memory>
+#include <vector>
 
 namespace hft_system {
 
@@ -22,12 +22,17 @@ private:
     void on_portfolio_update(const Event& event);
     // Add a handler for order book events
     void on_order_book(const Event& event);
+    const InstrumentSpec& spec_for(SymbolId symbol_id);
 
     RiskConfig risk_config_;
     std::shared_ptr<MLModelManager> ml_manager_;
     double latest_equity_ = 0.0;
     double latest_cash_ = 0.0;
-    std::map<std::string, double> latest_prices_;
+    // Indexed by SymbolId. Prices stay zero until the first one arrives; specs
+    // are looked up once, when a symbol is first seen.
+    std::vector<Price> latest_prices_;
+    std::vector<InstrumentSpec> specs_;
+    std::vector<uint8_t> book_unavailable_; // Set by an empty OrderBookEvent, cleared by the next real one
 };
 
 } // namespace hft_system
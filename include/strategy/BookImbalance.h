@@ -0,0 +1,165 @@
+#ifndef HFT_SYSTEM_BOOKIMBALANCE_H
+#define HFT_SYSTEM_BOOKIMBALANCE_H
+
+#include "../core/DataTypes.h"
+#include "BookKernels.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace hft_system
+{
+
+    // Weighted bid and ask depth over the top levels of one symbol's book, kept
+    // up to date incrementally. Level i weighs decay^i (decay 1 weighs every
+    // level equally); both sides are summed over the same number of levels, the
+    // shallower side's depth capped at `levels`, as OrderBookImbalanceStrategy
+    // always has.
+    //
+    // Weights are fixed point (WEIGHT_ONE is 1.0), so the sums are exact
+    // integers: adding and removing a level's contribution never drifts, and
+    // the result is bit-for-bit what a recomputation from scratch gives. They
+    // are 128-bit, as a weight times a level's lots overflows 64 bits once the
+    // level holds more than 2^47 lots.
+    // Changed levels are found with book_kernels().changed_levels.
+    class BookImbalance
+    {
+    public:
+        static constexpr int64_t WEIGHT_ONE = int64_t(1) << 16;
+        using Depth = __int128;
+
+        // `levels` is capped at MAX_BOOK_DEPTH; `decay` is clamped to (0, 1].
+        explicit BookImbalance(int levels, double decay = 1.0)
+            : max_levels_(static_cast<size_t>(std::clamp(levels, 0, static_cast<int>(MAX_BOOK_DEPTH))))
+        {
+            if (!(decay > 0.0) || decay > 1.0)
+                decay = 1.0;
+            double weight = 1.0;
+            for (size_t i = 0; i < MAX_BOOK_DEPTH; ++i)
+            {
+                weights_[i] = std::llround(weight * WEIGHT_ONE);
+                weight *= decay;
+            }
+        }
+
+        // Brings the sums up to date with the symbol's next book. Only levels
+        // whose quantity changed are re-weighted; a change in the number of
+        // levels considered recomputes both sides. Returns false, with the sums
+        // cleared, if either side of the book is empty.
+        bool update(const OrderBook &book)
+        {
+            const size_t depth = std::min({book.bids.size(), book.asks.size(), max_levels_});
+            if (depth == 0)
+            {
+                clear();
+                return false;
+            }
+            best_bid_ = book.bids.price[0];
+            best_ask_ = book.asks.price[0];
+            if (depth != depth_)
+            {
+                depth_ = depth;
+                bid_depth_ = 0;
+                ask_depth_ = 0;
+                for (size_t i = 0; i < depth; ++i)
+                {
+                    bid_quantity_[i] = book.bids.quantity[i].value;
+                    ask_quantity_[i] = book.asks.quantity[i].value;
+                    bid_depth_ += Depth(weights_[i]) * bid_quantity_[i];
+                    ask_depth_ += Depth(weights_[i]) * ask_quantity_[i];
+                }
+                level_updates_ += 2 * depth;
+                return true;
+            }
+            for (uint32_t changed = kernels_->changed_levels(lots(book.bids), bid_quantity_, depth); changed != 0; changed &= changed - 1)
+            {
+                const size_t level = static_cast<size_t>(std::countr_zero(changed));
+                set_bid(level, book.bids.quantity[level]);
+            }
+            for (uint32_t changed = kernels_->changed_levels(lots(book.asks), ask_quantity_, depth); changed != 0; changed &= changed - 1)
+            {
+                const size_t level = static_cast<size_t>(std::countr_zero(changed));
+                set_ask(level, book.asks.quantity[level]);
+            }
+            return true;
+        }
+
+        // Replace the quantity of one level already counted (level < levels()),
+        // for callers that know which levels a delta touched. O(1).
+        void set_bid(size_t level, Quantity quantity)
+        {
+            bid_depth_ += Depth(weights_[level]) * (Depth(quantity.value) - bid_quantity_[level]);
+            bid_quantity_[level] = quantity.value;
+            ++level_updates_;
+        }
+        void set_ask(size_t level, Quantity quantity)
+        {
+            ask_depth_ += Depth(weights_[level]) * (Depth(quantity.value) - ask_quantity_[level]);
+            ask_quantity_[level] = quantity.value;
+            ++level_updates_;
+        }
+
+        void clear()
+        {
+            depth_ = 0;
+            bid_depth_ = 0;
+            ask_depth_ = 0;
+        }
+
+        // Weighted depth in lots, scaled by WEIGHT_ONE.
+        Depth bid_depth() const { return bid_depth_; }
+        Depth ask_depth() const { return ask_depth_; }
+
+        // Weighted bid depth over weighted ask depth; 0 without ask depth.
+        double ratio() const
+        {
+            return ask_depth_ > 0 ? static_cast<double>(bid_depth_) / static_cast<double>(ask_depth_) : 0.0;
+        }
+
+        // (bid - ask) / (bid + ask), in [-1, 1]; 0 for an empty book.
+        double imbalance() const
+        {
+            const Depth total = bid_depth_ + ask_depth_;
+            return total > 0 ? static_cast<double>(bid_depth_ - ask_depth_) / static_cast<double>(total) : 0.0;
+        }
+
+        // Top-of-book mid weighted towards the side with less size, in price
+        // ticks (InstrumentSpec converts); 0 for an empty book.
+        double microprice() const
+        {
+            if (depth_ == 0)
+                return 0.0;
+            const double bid_size = static_cast<double>(bid_quantity_[0]);
+            const double ask_size = static_cast<double>(ask_quantity_[0]);
+            if (bid_size + ask_size <= 0.0)
+                return 0.5 * static_cast<double>(best_bid_.value + best_ask_.value);
+            return (static_cast<double>(best_bid_.value) * ask_size + static_cast<double>(best_ask_.value) * bid_size) /
+                   (bid_size + ask_size);
+        }
+
+        // Levels per side the sums currently cover.
+        size_t levels() const { return depth_; }
+        size_t max_levels() const { return max_levels_; }
+        int64_t weight(size_t level) const { return weights_[level]; }
+
+        // Level contributions re-weighted so far, both sides together.
+        uint64_t level_updates() const { return level_updates_; }
+
+    private:
+        const BookKernels *kernels_ = &book_kernels();
+        size_t max_levels_;
+        int64_t weights_[MAX_BOOK_DEPTH];
+        int64_t bid_quantity_[MAX_BOOK_DEPTH] = {};
+        int64_t ask_quantity_[MAX_BOOK_DEPTH] = {};
+        size_t depth_ = 0;
+        Depth bid_depth_ = 0;
+        Depth ask_depth_ = 0;
+        Price best_bid_;
+        Price best_ask_;
+        uint64_t level_updates_ = 0;
+    };
+
+} // namespace hft_system
+#endif // HFT_SYSTEM_BOOKIMBALANCE_H
@@ -0,0 +1,70 @@
+#ifndef HFT_SYSTEM_BOOKKERNELS_H
+#define HFT_SYSTEM_BOOKKERNELS_H
+
+#include "../core/DataTypes.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace hft_system
+{
+
+    // Shape of one book over its top levels. Prices are in ticks and sizes in
+    // lots; InstrumentSpec converts both.
+    struct BookFeatures
+    {
+        size_t bid_levels = 0; // Levels used per side
+        size_t ask_levels = 0;
+        int64_t bid_cumulative[MAX_BOOK_DEPTH] = {}; // Depth curve: size up to and including level i
+        int64_t ask_cumulative[MAX_BOOK_DEPTH] = {};
+        // Mid between the two sides' volume-weighted prices, each weighted by
+        // the other side's depth: the microprice over all levels used.
+        double depth_weighted_mid = 0.0;
+        // Average price of buying (from the asks) or selling (into the bids)
+        // the requested size, over as much of it as the levels hold.
+        double buy_vwap = 0.0;
+        double sell_vwap = 0.0;
+        int64_t buy_fillable = 0;
+        int64_t sell_fillable = 0;
+        // Least-squares slope of the depth curve against distance from the
+        // best price: lots added per tick further from the touch.
+        double bid_slope = 0.0;
+        double ask_slope = 0.0;
+        // Size weighted by the inverse of its distance from the mid,
+        // (bid - ask) / (bid + ask), in [-1, 1].
+        double pressure = 0.0;
+    };
+
+    // One implementation of the order book kernels. They read the BookSide
+    // arrays whole (MAX_BOOK_DEPTH entries, whatever the depth), so vector
+    // versions need no tail handling; entries past the depth never count.
+    struct BookKernels
+    {
+        const char *name;
+
+        // Fills `out` from the best `levels` levels of each side and buys or
+        // sells `vwap_size` lots. False, and `out` reset, if a side is empty.
+        bool (*features)(const OrderBook &book, size_t levels, int64_t vwap_size, BookFeatures &out);
+
+        // Bit i set where a[i] != b[i], for i < count. Both arrays hold
+        // MAX_BOOK_DEPTH values.
+        uint32_t (*changed_levels)(const int64_t *a, const int64_t *b, size_t count);
+    };
+
+    // Portable reference implementation.
+    const BookKernels &scalar_book_kernels();
+
+    // AVX2 implementation, or nullptr if this build or CPU has none.
+    const BookKernels *avx2_book_kernels();
+
+    // The fastest implementation the CPU supports, chosen on first use.
+    const BookKernels &book_kernels();
+
+    // A BookSide's quantities as raw lots, for changed_levels().
+    inline const int64_t *lots(const BookSide &side)
+    {
+        static_assert(sizeof(Quantity) == sizeof(int64_t), "Quantity must be a bare int64_t");
+        return reinterpret_cast<const int64_t *>(side.quantity);
+    }
+
+} // namespace hft_system
+#endif // HFT_SYSTEM_BOOKKERNELS_H
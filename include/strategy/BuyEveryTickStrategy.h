@@ -8,9 +8,11 @@ namespace hft_system {
 // A simple test strategy that generates a BUY signal on every market tick.
 class BuyEveryTickStrategy : public Strategy {
 public:
-    std::unique_ptr<SignalEvent> calculate_signal(const MarketEvent& event) override;
+    static constexpr uint32_t INTERESTS = MARKET;
+    uint32_t interests() const override { return INTERESTS; }
+    void on_market(const MarketEvent& event, SignalSink& signals) override;
 };
 
 } // namespace hft_system
 
-#endif // HFT_SYSTEM_BUYEVERYTICKSTRATEGY_H
\ No newline at end of file
+#endif // HFT_SYSTEM_BUYEVERYTICKSTRATEGY_H
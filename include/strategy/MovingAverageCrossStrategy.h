@@ -0,0 +1,50 @@
+#ifndef HFT_SYSTEM_MOVINGAVERAGECROSSSTRATEGY_H
+#define HFT_SYSTEM_MOVINGAVERAGECROSSSTRATEGY_H
+
+#include "Strategy.h"
+#include "../core/FixedPoint.h"
+#include "../utils/Indicators.h"
+#include <cstdint>
+#include <string>
+
+namespace hft_system {
+
+// Trades crossings of a fast and a slow simple moving average of a symbol's
+// MarketEvent prices: BUY when the fast average moves above the slow one, SELL
+// when it moves below. Prices are summed in ticks of the symbol's
+// InstrumentSpec (looked up at construction), so the averages are exact and
+// VectorBacktester reproduces the signals bit for bit.
+class MovingAverageCrossStrategy : public Strategy {
+public:
+    MovingAverageCrossStrategy(std::string symbol, int fast_period, int slow_period);
+
+    static constexpr uint32_t INTERESTS = MARKET;
+    uint32_t interests() const override { return INTERESTS; }
+
+    void on_market(const MarketEvent& event, SignalSink& signals) override;
+
+    // The prices in both windows and the last trend, so a restart trades at once.
+    uint32_t state_version() const override { return 1; }
+    void save_state(SnapshotWriter& out) const override;
+    bool restore_state(SnapshotReader& in) override;
+
+    // +1 if the fast average is above the slow one, -1 if below, 0 if equal.
+    static int8_t trend(int64_t fast_sum, int fast_period, int64_t slow_sum, int slow_period) {
+        const double fast = static_cast<double>(fast_sum) / fast_period;
+        const double slow = static_cast<double>(slow_sum) / slow_period;
+        return static_cast<int8_t>((fast > slow) - (fast < slow));
+    }
+
+private:
+    std::string symbol_;
+    SymbolId symbol_id_;
+    InstrumentSpec spec_;
+    RingBuffer<int64_t> fast_window_; // Prices in ticks
+    RingBuffer<int64_t> slow_window_;
+    int64_t fast_sum_ = 0;
+    int64_t slow_sum_ = 0;
+    int8_t trend_ = 0;
+};
+
+} // namespace hft_system
+#endif // HFT_SYSTEM_MOVINGAVERAGECROSSSTRATEGY_H
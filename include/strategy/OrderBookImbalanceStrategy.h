@@ -2,29 +2,47 @@
 #define HFT_SYSTEM_ORDERBOOKIMBALANCESTRATEGY_H
 
 #include "Strategy.h"
+#include "BookImbalance.h"
 #include "../events/Event.h" // Include for MarketState
 #include <string>
-#include <map>
+#include <vector>
 
 namespace hft_system {
 
 class OrderBookImbalanceStrategy : public Strategy {
 public:
-    OrderBookImbalanceStrategy(std::string symbol, int levels, double threshold);
+    // Level i of each side weighs level_decay^i in the imbalance ratio;
+    // vwap_size is the fill, in lots, the book features price. The features
+    // are only computed when it is positive.
+    OrderBookImbalanceStrategy(std::string symbol, int levels, double threshold, double level_decay = 1.0,
+                               int64_t vwap_size = 0);
 
-    std::unique_ptr<SignalEvent> calculate_signal(const MarketEvent& event) override;
-    std::unique_ptr<SignalEvent> calculate_signal_from_order_book(const OrderBookEvent& event);
-    void on_news(const NewsEvent& event);
+    static constexpr uint32_t INTERESTS = ORDER_BOOK | NEWS | MARKET_REGIME;
+    uint32_t interests() const override { return INTERESTS; }
 
-    // Add a handler for market regime events
-    void on_market_regime_change(const MarketState& new_state);
+    void on_order_book(const OrderBookEvent& event, SignalSink& signals) override;
+    void on_news(const NewsEvent& event) override;
+    void on_market_regime_change(const MarketState& new_state) override;
+
+    // The regime-adjusted threshold and the sentiment scores, by symbol name.
+    uint32_t state_version() const override { return 1; }
+    void save_state(SnapshotWriter& out) const override;
+    bool restore_state(SnapshotReader& in) override;
+
+    // Features of the symbol's last book over the lookback levels, for
+    // monitoring; the signal does not read them. Reset (no levels) while
+    // either side is empty or without a vwap_size.
+    const BookFeatures& features() const { return features_; }
 
 private:
     std::string symbol_;
-    int lookback_levels_;
+    SymbolId symbol_id_;
+    BookImbalance imbalance_; // Weighted depth over lookback levels, updated per book
+    int64_t vwap_size_;
+    BookFeatures features_;
     double base_imbalance_threshold_; // Base threshold
     double current_imbalance_threshold_; // Adjusted threshold
-    std::map<std::string, double> sentiment_scores_;
+    std::vector<double> sentiment_scores_; // Indexed by SymbolId; 0.0 when no news has arrived
 };
 
 } // namespace hft_system
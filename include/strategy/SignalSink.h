@@ -0,0 +1,55 @@
+#ifndef HFT_SYSTEM_SIGNALSINK_H
+#define HFT_SYSTEM_SIGNALSINK_H
+
+#include "../core/DataTypes.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace hft_system
+{
+
+    // A trading signal as a strategy emits it; becomes a SignalEvent when published.
+    struct Signal
+    {
+        SymbolId symbol_id;
+        OrderDirection direction;
+    };
+
+    // Fixed-capacity, inline buffer a strategy writes its signals into for one
+    // event. The caller owns and reuses it, so emitting a signal never touches
+    // the heap.
+    class SignalSink
+    {
+    public:
+        static constexpr size_t CAPACITY = 8;
+
+        // False, and the signal dropped, if the sink is full.
+        bool emit(SymbolId symbol_id, OrderDirection direction)
+        {
+            if (size_ == CAPACITY)
+            {
+                ++dropped_;
+                return false;
+            }
+            signals_[size_++] = {symbol_id, direction};
+            return true;
+        }
+
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        const Signal *begin() const { return signals_.data(); }
+        const Signal *end() const { return signals_.data() + size_; }
+        void clear() { size_ = 0; }
+
+        // Signals refused because the sink was full, over the sink's lifetime.
+        uint64_t dropped() const { return dropped_; }
+
+    private:
+        std::array<Signal, CAPACITY> signals_;
+        size_t size_ = 0;
+        uint64_t dropped_ = 0;
+    };
+
+} // namespace hft_system
+#endif // HFT_SYSTEM_SIGNALSINK_H
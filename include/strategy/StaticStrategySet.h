@@ -0,0 +1,216 @@
+#ifndef HFT_SYSTEM_STATICSTRATEGYSET_H
+#define HFT_SYSTEM_STATICSTRATEGYSET_H
+
+#include "../core/Component.h"
+#include "../core/Log.h"
+#include "../events/Event.h"
+#include "Strategy.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hft_system
+{
+
+    // Strategy pipeline for deployments whose strategy types are known at
+    // build time; the alternative to StrategyManager. Each event handler is a
+    // fold over the strategy types: types that did not declare the event in
+    // their INTERESTS contribute no code, instances of the others are stored by
+    // value and their hooks are called non-virtually on the concrete type, so
+    // the compiler can inline the dispatch end to end.
+    //
+    // Every type must derive from Strategy and define
+    // `static constexpr uint32_t INTERESTS`. Several instances of a type may be
+    // added, e.g. one per symbol.
+    template <typename... Strategies>
+    class StaticStrategySet : public Component
+    {
+        static_assert((std::is_base_of_v<Strategy, Strategies> && ...), "StaticStrategySet holds Strategy types");
+
+    public:
+        StaticStrategySet(std::shared_ptr<EventBus> event_bus, std::string name)
+            : Component(std::move(event_bus), std::move(name))
+        {
+            // Only events some type handles are subscribed to.
+            if constexpr (interested(Strategy::MARKET))
+                event_bus_->subscribe(EventType::MARKET, [this](const Event &event)
+                                      { on_market_event(event); });
+            if constexpr (interested(Strategy::ORDER_BOOK))
+                event_bus_->subscribe(EventType::ORDER_BOOK, [this](const Event &event)
+                                      { on_order_book_event(event); });
+            if constexpr (interested(Strategy::QUOTE))
+                event_bus_->subscribe(EventType::QUOTE, [this](const Event &event)
+                                      { on_quote_event(event); });
+            if constexpr (interested(Strategy::BAR))
+                event_bus_->subscribe(EventType::BAR, [this](const Event &event)
+                                      { on_bar_event(event); });
+            if constexpr (interested(Strategy::NEWS))
+                event_bus_->subscribe(EventType::NEWS, [this](const Event &event)
+                                      { on_news_event(event); });
+            if constexpr (interested(Strategy::MARKET_REGIME))
+                event_bus_->subscribe(EventType::MARKET_REGIME_CHANGED, [this](const Event &event)
+                                      { on_market_regime_event(event); });
+        }
+
+        void start() override { Log::get_logger()->info("{} started with {} strategies.", name_, strategy_count()); }
+        void stop() override { Log::get_logger()->info("{} stopped.", name_); }
+
+        // Call before events flow, like StrategyManager::add_strategy().
+        template <typename S>
+        void add_strategy(S strategy)
+        {
+            std::get<std::vector<S>>(strategies_).push_back(std::move(strategy));
+        }
+
+        size_t strategy_count() const
+        {
+            return std::apply([](const auto &...lists)
+                              { return (lists.size() + ... + size_t{0}); },
+                              strategies_);
+        }
+
+        // Same section layout as StrategyManager, in type order, then insertion order within a type.
+        void save_snapshot(Snapshot &snapshot) const override
+        {
+            SnapshotWriter &out = snapshot.add_section(name_, STRATEGY_SECTION_VERSION);
+            out.put(static_cast<uint64_t>(strategy_count()));
+            std::apply([&](const auto &...lists)
+                       { (save_list(lists, out), ...); },
+                       strategies_);
+        }
+
+        void restore_snapshot(const Snapshot &snapshot) override
+        {
+            auto in = snapshot.section(name_, STRATEGY_SECTION_VERSION);
+            if (!in)
+                return;
+            uint64_t count = 0;
+            if (!in->get(count) || count != strategy_count())
+            {
+                Log::get_logger()->warn("{}: snapshot holds {} strategies, {} are configured; starting cold.", name_, count, strategy_count());
+                return;
+            }
+            bool readable = std::apply([&](auto &...lists)
+                                       { return (restore_list(lists, *in) && ...); },
+                                       strategies_);
+            if (!readable)
+                Log::get_logger()->warn("{}: unreadable strategy state in snapshot; the rest start cold.", name_);
+        }
+
+        // Event handlers; public so a caller can also drive the set synchronously.
+        void on_market_event(const Event &event)
+        {
+            const auto &market_event = static_cast<const MarketEvent &>(event);
+            for_each<Strategy::MARKET>([&](auto &strategy)
+                                       { using S = std::decay_t<decltype(strategy)>;
+                                         strategy.S::on_market(market_event, sink_); });
+        }
+
+        void on_order_book_event(const Event &event)
+        {
+            const auto &order_book_event = static_cast<const OrderBookEvent &>(event);
+            for_each<Strategy::ORDER_BOOK>([&](auto &strategy)
+                                           { using S = std::decay_t<decltype(strategy)>;
+                                             strategy.S::on_order_book(order_book_event, sink_); });
+        }
+
+        void on_quote_event(const Event &event)
+        {
+            const auto &quote_event = static_cast<const QuoteEvent &>(event);
+            for_each<Strategy::QUOTE>([&](auto &strategy)
+                                      { using S = std::decay_t<decltype(strategy)>;
+                                        strategy.S::on_quote(quote_event, sink_); });
+        }
+
+        void on_bar_event(const Event &event)
+        {
+            const auto &bar_event = static_cast<const BarEvent &>(event);
+            for_each<Strategy::BAR>([&](auto &strategy)
+                                    { using S = std::decay_t<decltype(strategy)>;
+                                      strategy.S::on_bar(bar_event, sink_); });
+        }
+
+        void on_news_event(const Event &event)
+        {
+            const auto &news_event = static_cast<const NewsEvent &>(event);
+            for_each<Strategy::NEWS>([&](auto &strategy)
+                                     { using S = std::decay_t<decltype(strategy)>;
+                                       strategy.S::on_news(news_event); });
+        }
+
+        void on_market_regime_event(const Event &event)
+        {
+            const auto &regime_event = static_cast<const MarketRegimeChangedEvent &>(event);
+            for_each<Strategy::MARKET_REGIME>([&](auto &strategy)
+                                              { using S = std::decay_t<decltype(strategy)>;
+                                                strategy.S::on_market_regime_change(regime_event.state); });
+        }
+
+    private:
+        template <typename S>
+        static void save_list(const std::vector<S> &list, SnapshotWriter &out)
+        {
+            for (const S &strategy : list)
+                save_strategy_state(strategy, out);
+        }
+
+        template <typename S>
+        static bool restore_list(std::vector<S> &list, SnapshotReader &in)
+        {
+            for (S &strategy : list)
+            {
+                if (!restore_strategy_state(strategy, in))
+                    return false;
+            }
+            return true;
+        }
+
+        static constexpr bool interested(uint32_t interest)
+        {
+            return ((Strategies::INTERESTS & interest) || ...);
+        }
+
+        // Calls `hook` on every instance of every type interested in `Interest`,
+        // then publishes the signals they emitted in one batch. The qualified
+        // S:: calls in the hooks bypass the vtable.
+        template <uint32_t Interest, typename Hook>
+        void for_each(Hook &&hook)
+        {
+            (for_each_of<Strategies, Interest>(hook), ...);
+            if (!batch_.empty())
+            {
+                event_bus_->publish_batch(std::move(batch_));
+                batch_.clear();
+            }
+        }
+
+        template <typename S, uint32_t Interest, typename Hook>
+        void for_each_of(Hook &hook)
+        {
+            if constexpr ((S::INTERESTS & Interest) != 0)
+            {
+                for (S &strategy : std::get<std::vector<S>>(strategies_))
+                {
+                    hook(strategy);
+                    if (!sink_.empty())
+                    {
+                        for (const Signal &signal : sink_)
+                            batch_.push_back(std::make_shared<SignalEvent>(signal.symbol_id, signal.direction));
+                        sink_.clear();
+                    }
+                }
+            }
+        }
+
+        std::tuple<std::vector<Strategies>...> strategies_;
+        SignalSink sink_;                           // Reused by every hook call
+        std::vector<std::shared_ptr<Event>> batch_; // Signals of the current event, published together
+    };
+
+} // namespace hft_system
+#endif // HFT_SYSTEM_STATICSTRATEGYSET_H
@@ -1,21 +1,81 @@
-
 #ifndef HFT_SYSTEM_STRATEGY_H
 #define HFT_SYSTEM_STRATEGY_H
 
+#include "../core/Snapshot.h"
 #include "../events/Event.h"
-#include <memory> // For std::unique_ptr
+#include "SignalSink.h"
+#include <cstdint>
+#include <string>
 
 namespace hft_system {
 
 // Abstract base class for all trading strategies.
+//
+// A strategy declares the events it reacts to through interests(), which
+// StrategyManager reads once when the strategy is added, and overrides the
+// matching hooks. Hooks it did not declare are never called. Concrete
+// strategies also expose the mask as `static constexpr uint32_t INTERESTS`
+// so StaticStrategySet can dispatch to them at compile time.
+//
+// Signals are written into the SignalSink passed to a hook rather than
+// returned; the caller publishes them after the hook returns.
 class Strategy {
 public:
-    
+    enum Interest : uint32_t {
+        MARKET = 1u << 0,        // Trades and ticks: on_market()
+        ORDER_BOOK = 1u << 1,    // on_order_book()
+        QUOTE = 1u << 2,         // on_quote()
+        BAR = 1u << 3,           // on_bar()
+        NEWS = 1u << 4,          // on_news()
+        MARKET_REGIME = 1u << 5  // on_market_regime_change()
+    };
+
     virtual ~Strategy() = 0;
 
-    virtual std::unique_ptr<SignalEvent> calculate_signal(const MarketEvent& event) = 0;
+    // Bitmask of Interest values.
+    virtual uint32_t interests() const = 0;
+
+    virtual void on_market(const MarketEvent&, SignalSink&) {}
+    virtual void on_order_book(const OrderBookEvent&, SignalSink&) {}
+    virtual void on_quote(const QuoteEvent&, SignalSink&) {}
+    virtual void on_bar(const BarEvent&, SignalSink&) {}
+    virtual void on_news(const NewsEvent&) {}
+    virtual void on_market_regime_change(const MarketState&) {}
+
+    // Warm-restart state. A strategy with rolling state returns a non-zero
+    // layout version, bumped whenever save_state() changes what it writes;
+    // restore_state() only sees state saved under the same version and
+    // returns false if it cannot use it.
+    virtual uint32_t state_version() const { return 0; }
+    virtual void save_state(SnapshotWriter&) const {}
+    virtual bool restore_state(SnapshotReader&) { return true; }
 };
 
+// Layout of a strategy owner's snapshot section: the strategy count, then one
+// save_strategy_state() entry per strategy.
+constexpr uint32_t STRATEGY_SECTION_VERSION = 1;
+
+// A strategy's entry in its owner's snapshot section: its layout version, then its state.
+inline void save_strategy_state(const Strategy& strategy, SnapshotWriter& out) {
+    SnapshotWriter state;
+    strategy.save_state(state);
+    out.put(strategy.state_version());
+    out.put_string(state.data());
+}
+
+// Restores an entry written by save_strategy_state(). A strategy whose layout
+// version changed is left to re-warm; returns false only if the entry is unreadable.
+inline bool restore_strategy_state(Strategy& strategy, SnapshotReader& in) {
+    uint32_t version = 0;
+    std::string state;
+    if (!in.get(version) || !in.get_string(state))
+        return false;
+    if (version == 0 || version != strategy.state_version())
+        return true;
+    SnapshotReader state_reader(state);
+    return strategy.restore_state(state_reader) && state_reader.ok();
+}
+
 } // namespace hft_system
 
-#endif // HFT_SYSTEM_STRATEGY_H
\ No newline at end of file
+#endif // HFT_SYSTEM_STRATEGY_H
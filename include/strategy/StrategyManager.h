@@ -4,30 +4,70 @@
 #include "../core/Component.h"
 #include "../events/Event.h"
 #include "Strategy.h"
+#include "StrategyWorkerPool.h"
 #include <vector>
 #include <memory>
 
 namespace hft_system
 {
 
+    // Owns the strategies and routes events to them. Each strategy's
+    // interests() are read once in add_strategy() and it is appended to the
+    // dispatch list of every event type it asked for, so an event only visits
+    // the strategies that handle it.
+    //
+    // With more than one worker, market, order book, quote and bar events are
+    // fanned out over a StrategyWorkerPool: each dispatch list is cut into
+    // shards of contiguous strategies, and each strategy writes into its own
+    // SignalSink; the sinks are read in registration order once all shards are
+    // done, so the output does not depend on scheduling. News and regime changes
+    // stay on the EventBus thread; they are cheap and run between fan-outs.
     class StrategyManager : public Component
     {
     public:
-        StrategyManager(std::shared_ptr<EventBus> event_bus, std::string name);
+        // `workers` counts the EventBus thread; 1 runs every strategy on it.
+        StrategyManager(std::shared_ptr<EventBus> event_bus, std::string name, size_t workers = 1);
 
         void start() override;
         void stop() override;
 
+        // Call before events flow; the dispatch lists are not synchronised.
         void add_strategy(std::unique_ptr<Strategy> strategy);
 
-    private:
+        // Event handlers; public so a caller can also drive the manager synchronously.
         void on_market_event(const Event &event);
         void on_order_book_event(const Event &event);
+        void on_quote_event(const Event &event);
+        void on_bar_event(const Event &event);
         void on_news_event(const Event &event);
-        void on_market_regime_event(const Event &event);// Add this missing declaration
+        void on_market_regime_event(const Event &event);
+
+        size_t worker_count() const { return pool_ ? pool_->worker_count() : 1; }
+
+        // Saves every strategy's state in registration order; a snapshot taken
+        // with a different number of strategies is not restored.
+        void save_snapshot(Snapshot &snapshot) const override;
+        void restore_snapshot(const Snapshot &snapshot) override;
+
+    private:
+        template <typename Hook>
+        void dispatch(const std::vector<Strategy *> &strategies, Hook &&hook);
+        void collect(SignalSink &sink);
 
         std::vector<std::unique_ptr<Strategy>> strategies_;
+
+        // Per event type, the strategies interested in it, in registration order.
+        std::vector<Strategy *> market_strategies_;
+        std::vector<Strategy *> order_book_strategies_;
+        std::vector<Strategy *> quote_strategies_;
+        std::vector<Strategy *> bar_strategies_;
+        std::vector<Strategy *> news_strategies_;
+        std::vector<Strategy *> regime_strategies_;
+
+        std::unique_ptr<StrategyWorkerPool> pool_; // Null with a single worker
+        std::vector<SignalSink> sinks_;            // One per strategy of the list being dispatched
+        std::vector<std::shared_ptr<Event>> batch_; // Signals of the current event, published together
     };
 
 } // namespace hft_system
-#endif // HFT_SYSTEM_STRATEGYMANAGER_H
\ No newline at end of file
+#endif // HFT_SYSTEM_STRATEGYMANAGER_H
@@ -0,0 +1,71 @@
+#ifndef HFT_SYSTEM_STRATEGYWORKERPOOL_H
+#define HFT_SYSTEM_STRATEGYWORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hft_system
+{
+
+    // Runs the shards of one event on a fixed set of workers. The calling
+    // thread is worker 0; the others are threads owned by the pool. Shards are
+    // split into contiguous home ranges, one per worker, so the same shard
+    // normally lands on the same worker event after event; a worker that
+    // finishes its own range steals unclaimed shards from the others.
+    //
+    // Each shard is claimed by exactly one worker per run(), and run() returns
+    // only after every worker has checked out, so state touched by a shard is
+    // never accessed concurrently and needs no locks even when a shard moves.
+    class StrategyWorkerPool
+    {
+    public:
+        explicit StrategyWorkerPool(size_t workers);
+        ~StrategyWorkerPool();
+
+        StrategyWorkerPool(const StrategyWorkerPool &) = delete;
+        StrategyWorkerPool &operator=(const StrategyWorkerPool &) = delete;
+
+        size_t worker_count() const { return worker_count_; }
+
+        // Calls task(shard) for every shard in [0, shards) and waits for all of
+        // them. Not reentrant: one run() at a time.
+        template <typename Task>
+        void run(size_t shards, Task &task)
+        {
+            run_erased(shards, [](void *context, size_t shard)
+                       { (*static_cast<Task *>(context))(shard); }, &task);
+        }
+
+    private:
+        struct alignas(64) Range
+        {
+            std::atomic<size_t> next{0};
+            size_t end = 0;
+        };
+
+        void run_erased(size_t shards, void (*invoke)(void *, size_t), void *context);
+        void work(size_t worker);
+        void thread_main(size_t worker);
+
+        size_t worker_count_;
+        std::unique_ptr<Range[]> ranges_;
+        std::vector<std::thread> threads_;
+
+        void (*invoke_)(void *, size_t) = nullptr;
+        void *context_ = nullptr;
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::atomic<uint64_t> generation_{0};
+        std::atomic<size_t> busy_{0}; // Pool threads not yet done with the current run
+        bool stopping_ = false;
+    };
+
+} // namespace hft_system
+#endif // HFT_SYSTEM_STRATEGYWORKERPOOL_H
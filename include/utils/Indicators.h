@@ -0,0 +1,306 @@
+#ifndef HFT_SYSTEM_INDICATORS_H
+#define HFT_SYSTEM_INDICATORS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hft_system
+{
+
+    // Streaming indicators for strategies and regime detection. Every update is
+    // O(1) (amortised for RollingMinMax) and works on buffers sized once at
+    // construction, so feeding a tick never allocates.
+
+    // Fixed-capacity ring of the last `capacity` values.
+    template <typename T>
+    class RingBuffer
+    {
+    public:
+        explicit RingBuffer(size_t capacity) : values_(std::max<size_t>(capacity, 1)) {}
+
+        size_t capacity() const { return values_.size(); }
+        size_t size() const { return size_; }
+        bool full() const { return size_ == values_.size(); }
+
+        // Appends `value`; once full, the oldest value is overwritten and returned.
+        T push(const T &value)
+        {
+            T evicted{};
+            if (full())
+                evicted = values_[head_];
+            else
+                ++size_;
+            values_[head_] = value;
+            head_ = head_ + 1 == values_.size() ? 0 : head_ + 1;
+            return evicted;
+        }
+
+        // i = 0 is the oldest value held, size() - 1 the newest.
+        const T &operator[](size_t i) const
+        {
+            size_t start = full() ? head_ : 0;
+            size_t at = start + i;
+            return values_[at >= values_.size() ? at - values_.size() : at];
+        }
+        const T &back() const { return (*this)[size_ - 1]; }
+
+        void clear()
+        {
+            size_ = 0;
+            head_ = 0;
+        }
+
+    private:
+        std::vector<T> values_;
+        size_t head_ = 0; // Slot the next value goes into
+        size_t size_ = 0;
+    };
+
+    // Mean and population variance of the last `window` values: Welford's
+    // update, with the value leaving the window removed in the same step.
+    // Removal lets rounding error build up, so every `window` evictions the
+    // sums are recomputed from the ring, which keeps the cost O(1) amortised.
+    class RollingStats
+    {
+    public:
+        explicit RollingStats(size_t window) : values_(window) {}
+
+        void push(double value)
+        {
+            if (values_.full())
+            {
+                double evicted = values_.push(value);
+                double old_mean = mean_;
+                mean_ += (value - evicted) / static_cast<double>(values_.size());
+                m2_ += (value - evicted) * (value - mean_ + evicted - old_mean);
+                if (m2_ < 0.0)
+                    m2_ = 0.0; // Rounding can leave a tiny negative for a flat window
+                if (++evictions_ == values_.size())
+                    recompute();
+            }
+            else
+            {
+                values_.push(value);
+                double delta = value - mean_;
+                mean_ += delta / static_cast<double>(values_.size());
+                m2_ += delta * (value - mean_);
+            }
+        }
+
+        size_t window() const { return values_.capacity(); }
+        size_t count() const { return values_.size(); }
+        bool ready() const { return values_.full(); }
+        double mean() const { return mean_; }
+        double variance() const { return values_.size() > 0 ? m2_ / static_cast<double>(values_.size()) : 0.0; }
+        double stddev() const { return std::sqrt(variance()); }
+
+        // Oldest value still in the window; the one the next push() evicts once ready().
+        double oldest() const { return values_[0]; }
+        const RingBuffer<double> &values() const { return values_; }
+
+        void clear()
+        {
+            values_.clear();
+            mean_ = 0.0;
+            m2_ = 0.0;
+            evictions_ = 0;
+        }
+
+    private:
+        void recompute()
+        {
+            const size_t count = values_.size();
+            double sum = 0.0;
+            for (size_t i = 0; i < count; ++i)
+                sum += values_[i];
+            mean_ = sum / static_cast<double>(count);
+            m2_ = 0.0;
+            for (size_t i = 0; i < count; ++i)
+                m2_ += (values_[i] - mean_) * (values_[i] - mean_);
+            evictions_ = 0;
+        }
+
+        RingBuffer<double> values_;
+        double mean_ = 0.0;
+        double m2_ = 0.0;
+        size_t evictions_ = 0;
+    };
+
+    // Exponential moving average with alpha = 2 / (period + 1), seeded with the first value.
+    class Ema
+    {
+    public:
+        explicit Ema(size_t period) : alpha_(2.0 / (static_cast<double>(std::max<size_t>(period, 1)) + 1.0)) {}
+
+        double push(double value)
+        {
+            value_ = seeded_ ? value_ + alpha_ * (value - value_) : value;
+            seeded_ = true;
+            return value_;
+        }
+
+        bool ready() const { return seeded_; }
+        double value() const { return value_; }
+        void clear() { seeded_ = false; }
+
+    private:
+        double alpha_;
+        double value_ = 0.0;
+        bool seeded_ = false;
+    };
+
+    // Minimum and maximum of the last `window` values. Each side is a monotonic
+    // deque of (sequence, value) kept in a ring of `window` slots, so a push
+    // pops at most what it pushed over the window's lifetime.
+    class RollingMinMax
+    {
+    public:
+        explicit RollingMinMax(size_t window)
+            : window_(std::max<size_t>(window, 1)), min_(window_), max_(window_) {}
+
+        void push(double value)
+        {
+            const uint64_t sequence = next_++;
+            min_.push(sequence, value, window_, [](double kept, double incoming)
+                      { return kept >= incoming; });
+            max_.push(sequence, value, window_, [](double kept, double incoming)
+                      { return kept <= incoming; });
+        }
+
+        size_t count() const { return static_cast<size_t>(std::min<uint64_t>(next_, window_)); }
+        bool ready() const { return next_ >= window_; }
+        double min() const { return min_.front(); }
+        double max() const { return max_.front(); }
+
+        void clear()
+        {
+            next_ = 0;
+            min_.clear();
+            max_.clear();
+        }
+
+    private:
+        class MonotonicDeque
+        {
+        public:
+            explicit MonotonicDeque(size_t capacity) : entries_(capacity) {}
+
+            // Drops entries `dominated(kept, value)` from the back, appends, and
+            // expires the front once it falls out of the window.
+            template <typename Dominated>
+            void push(uint64_t sequence, double value, size_t window, Dominated dominated)
+            {
+                while (size_ > 0 && dominated(at(size_ - 1).value, value))
+                    --size_;
+                if (size_ > 0 && at(0).sequence + window <= sequence)
+                {
+                    front_ = front_ + 1 == entries_.size() ? 0 : front_ + 1;
+                    --size_;
+                }
+                at(size_) = {sequence, value};
+                ++size_;
+            }
+
+            double front() const { return size_ > 0 ? at(0).value : 0.0; }
+            void clear()
+            {
+                front_ = 0;
+                size_ = 0;
+            }
+
+        private:
+            struct Entry
+            {
+                uint64_t sequence;
+                double value;
+            };
+
+            Entry &at(size_t i)
+            {
+                size_t slot = front_ + i;
+                return entries_[slot >= entries_.size() ? slot - entries_.size() : slot];
+            }
+            const Entry &at(size_t i) const { return const_cast<MonotonicDeque *>(this)->at(i); }
+
+            std::vector<Entry> entries_;
+            size_t front_ = 0;
+            size_t size_ = 0;
+        };
+
+        size_t window_;
+        uint64_t next_ = 0;
+        MonotonicDeque min_;
+        MonotonicDeque max_;
+    };
+
+    // Volume-weighted average price of the last `window` prints.
+    class RollingVwap
+    {
+    public:
+        explicit RollingVwap(size_t window) : prints_(window) {}
+
+        void push(double price, double volume)
+        {
+            Print evicted = prints_.push({price * volume, volume});
+            notional_ += price * volume - evicted.notional;
+            volume_ += volume - evicted.volume;
+        }
+
+        bool ready() const { return prints_.full(); }
+        double volume() const { return volume_; }
+        // 0 until some volume has traded in the window.
+        double value() const { return volume_ > 0.0 ? notional_ / volume_ : 0.0; }
+
+        void clear()
+        {
+            prints_.clear();
+            notional_ = 0.0;
+            volume_ = 0.0;
+        }
+
+    private:
+        struct Print
+        {
+            double notional;
+            double volume;
+        };
+
+        RingBuffer<Print> prints_;
+        double notional_ = 0.0;
+        double volume_ = 0.0;
+    };
+
+    // Z-score of each new value against the last `window` values, itself included.
+    class ZScore
+    {
+    public:
+        explicit ZScore(size_t window) : stats_(window) {}
+
+        // 0 while the window's deviation is zero.
+        double push(double value)
+        {
+            stats_.push(value);
+            double stddev = stats_.stddev();
+            value_ = stddev > 0.0 ? (value - stats_.mean()) / stddev : 0.0;
+            return value_;
+        }
+
+        bool ready() const { return stats_.ready(); }
+        double value() const { return value_; }
+        const RollingStats &stats() const { return stats_; }
+        void clear()
+        {
+            stats_.clear();
+            value_ = 0.0;
+        }
+
+    private:
+        RollingStats stats_;
+        double value_ = 0.0;
+    };
+
+} // namespace hft_system
+#endif // HFT_SYSTEM_INDICATORS_H
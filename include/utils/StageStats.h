@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace hft_system
+{
+
+    // Busy/wait accounting for one stage of a producer/consumer pipeline.
+    // utilisation close to 100% means the stage is the bottleneck; a stage that
+    // mostly waits is being starved by the one in front of it.
+    struct StageStats
+    {
+        std::atomic<int64_t> busy_ns{0};
+        std::atomic<int64_t> wait_ns{0};
+        std::atomic<int64_t> items{0};
+        std::atomic<int64_t> bytes{0};
+
+        void add_busy(int64_t ns) { busy_ns.fetch_add(ns, std::memory_order_relaxed); }
+        void add_wait(int64_t ns) { wait_ns.fetch_add(ns, std::memory_order_relaxed); }
+        void add_item(int64_t n_bytes = 0)
+        {
+            items.fetch_add(1, std::memory_order_relaxed);
+            bytes.fetch_add(n_bytes, std::memory_order_relaxed);
+        }
+
+        double utilisation() const
+        {
+            double busy = static_cast<double>(busy_ns.load(std::memory_order_relaxed));
+            double total = busy + static_cast<double>(wait_ns.load(std::memory_order_relaxed));
+            return total > 0.0 ? busy / total : 0.0;
+        }
+
+        // Same shape as PerformanceMonitor::get_statistics() entries.
+        std::map<std::string, double> to_map() const
+        {
+            return {
+                {"busy_ms", busy_ns.load(std::memory_order_relaxed) / 1e6},
+                {"wait_ms", wait_ns.load(std::memory_order_relaxed) / 1e6},
+                {"utilisation_pct", utilisation() * 100.0},
+                {"items", static_cast<double>(items.load(std::memory_order_relaxed))},
+                {"bytes", static_cast<double>(bytes.load(std::memory_order_relaxed))}};
+        }
+    };
+
+} // namespace hft_system
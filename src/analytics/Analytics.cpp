@@ -26,24 +26,29 @@ namespace hft_system
     }
 
     std::map<std::string, double> Analytics::generate_report(const std::list<Trade> &trade_log)
+    {
+        return build_report(equity_curve_, trade_log);
+    }
+
+    std::map<std::string, double> Analytics::build_report(const std::vector<double> &equity_curve, const std::list<Trade> &trade_log)
     {
         std::map<std::string, double> report;
-        if (equity_curve_.size() < 2)
+        if (equity_curve.size() < 2)
         {
             Log::get_logger()->warn("Not enough data to generate a performance report.");
             return report;
         }
 
-        double initial_equity = equity_curve_.front();
-        double final_equity = equity_curve_.back();
+        double initial_equity = equity_curve.front();
+        double final_equity = equity_curve.back();
 
         report["initial_equity"] = initial_equity;
         report["final_equity"] = final_equity;
         report["total_return_pct"] = ((final_equity / initial_equity) - 1.0) * 100.0;
 
         // Max Drawdown
-        double max_drawdown = 0.0, peak = equity_curve_[0];
-        for (double equity : equity_curve_)
+        double max_drawdown = 0.0, peak = equity_curve[0];
+        for (double equity : equity_curve)
         {
             peak = std::max(peak, equity);
             max_drawdown = std::max(max_drawdown, (peak - equity) / peak);
@@ -52,9 +57,9 @@ namespace hft_system
 
         // Sharpe & Sortino Ratios
         std::vector<double> returns;
-        for (size_t i = 1; i < equity_curve_.size(); ++i)
+        for (size_t i = 1; i < equity_curve.size(); ++i)
         {
-            returns.push_back((equity_curve_[i] / equity_curve_[i - 1]) - 1.0);
+            returns.push_back((equity_curve[i] / equity_curve[i - 1]) - 1.0);
         }
 
         if (returns.size() > 1)
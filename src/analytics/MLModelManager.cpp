@@ -25,7 +25,7 @@ namespace hft_system
     }
 
     // This is a placeholder for a real model inference call.
-    double MLModelManager::get_trade_confidence(const std::string &symbol)
+    double MLModelManager::get_trade_confidence(SymbolId symbol_id)
     {
         if (!model_loaded_)
         {
@@ -1,14 +1,19 @@
 #include "../../include/analytics/MarketRegimeDetector.h"
 #include "../../include/core/Log.h"
+#include "../../include/core/Snapshot.h"
+#include <algorithm>
 #include <functional>
-#include <numeric>
-#include <cmath>
+#include <vector>
 
 namespace hft_system
 {
 
     MarketRegimeDetector::MarketRegimeDetector(std::shared_ptr<EventBus> event_bus, std::string name, int volatility_period, int trend_period)
-        : Component(event_bus, std::move(name)), volatility_period_(volatility_period), trend_period_(trend_period) {}
+        : Component(event_bus, std::move(name)), volatility_period_(volatility_period), trend_period_(trend_period),
+          returns_(static_cast<size_t>(std::max(volatility_period - 1, 1))),
+          // The halves cover the whole trend window; with an odd period the newer one has the extra price.
+          recent_half_(static_cast<size_t>(std::max(trend_period - trend_period / 2, 1))),
+          earlier_half_(static_cast<size_t>(std::max(trend_period / 2, 1))) {}
 
     void MarketRegimeDetector::start()
     {
@@ -22,19 +27,75 @@ namespace hft_system
         Log::get_logger()->info("{} stopped.", name_);
     }
 
-    void MarketRegimeDetector::on_market_event(const Event &event)
+    namespace
     {
-        const auto &market = static_cast<const MarketEvent &>(event);
-        price_history_.push_back(market.price);
+        constexpr uint32_t REGIME_SECTION_VERSION = 1;
+
+        std::vector<double> window_values(const RollingStats &stats)
+        {
+            std::vector<double> values(stats.count());
+            for (size_t i = 0; i < values.size(); ++i)
+                values[i] = stats.values()[i];
+            return values;
+        }
+
+        void refill(RollingStats &stats, const std::vector<double> &values)
+        {
+            stats.clear();
+            for (double value : values)
+                stats.push(value);
+        }
+    }
+
+    void MarketRegimeDetector::save_snapshot(Snapshot &snapshot) const
+    {
+        SnapshotWriter &out = snapshot.add_section(name_, REGIME_SECTION_VERSION);
+        out.put(last_price_);
+        out.put(static_cast<uint64_t>(prices_seen_));
+        out.put(current_state_);
+        out.put_vector(window_values(returns_));
+        out.put_vector(window_values(recent_half_));
+        out.put_vector(window_values(earlier_half_));
+    }
 
-        // Keep the deque at the max size we need
-        if (price_history_.size() > std::max(volatility_period_, trend_period_))
+    void MarketRegimeDetector::restore_snapshot(const Snapshot &snapshot)
+    {
+        auto in = snapshot.section(name_, REGIME_SECTION_VERSION);
+        if (!in)
+            return;
+        double last_price = 0.0;
+        uint64_t prices_seen = 0;
+        MarketState state;
+        std::vector<double> returns, recent, earlier;
+        if (!in->get(last_price) || !in->get(prices_seen) || !in->get(state) ||
+            !in->get_vector(returns) || !in->get_vector(recent) || !in->get_vector(earlier))
         {
-            price_history_.pop_front();
+            Log::get_logger()->warn("{}: unreadable snapshot section; starting cold.", name_);
+            return;
         }
+        last_price_ = last_price;
+        prices_seen_ = static_cast<size_t>(prices_seen);
+        current_state_ = state;
+        refill(returns_, returns);
+        refill(recent_half_, recent);
+        refill(earlier_half_, earlier);
+        Log::get_logger()->info("{}: restored {} prices of history from snapshot.", name_, prices_seen_);
+    }
+
+    void MarketRegimeDetector::on_market_event(const Event &event)
+    {
+        const auto &market = static_cast<const MarketEvent &>(event);
+        if (prices_seen_ > 0 && last_price_ != 0.0)
+            returns_.push(market.price / last_price_ - 1.0);
+        last_price_ = market.price;
+
+        if (recent_half_.ready())
+            earlier_half_.push(recent_half_.oldest());
+        recent_half_.push(market.price);
+        ++prices_seen_;
 
         // Calculate the new regime, but only if we have enough data
-        if (price_history_.size() >= std::max(volatility_period_, trend_period_))
+        if (prices_seen_ >= static_cast<size_t>(std::max(volatility_period_, trend_period_)))
         {
             calculate_regime();
         }
@@ -42,20 +103,12 @@ namespace hft_system
 
     void MarketRegimeDetector::calculate_regime()
     {
-        // 1. Calculate Volatility (Standard Deviation of returns)
-        std::vector<double> returns;
-        for (size_t i = price_history_.size() - volatility_period_; i < price_history_.size() - 1; ++i)
-        {
-            returns.push_back(price_history_[i + 1] / price_history_[i] - 1.0);
-        }
-        double sum = std::accumulate(returns.begin(), returns.end(), 0.0);
-        double mean = sum / returns.size();
-        double sq_sum = std::inner_product(returns.begin(), returns.end(), returns.begin(), 0.0);
-        double stdev = std::sqrt(sq_sum / returns.size() - mean * mean);
-
-        // 2. Calculate Trend (Simple Moving Average slope)
-        double first_sma = std::accumulate(price_history_.end() - trend_period_, price_history_.end() - (trend_period_ / 2), 0.0) / (trend_period_ / 2);
-        double second_sma = std::accumulate(price_history_.end() - (trend_period_ / 2), price_history_.end(), 0.0) / (trend_period_ / 2);
+        // 1. Volatility: standard deviation of returns
+        double stdev = returns_.stddev();
+
+        // 2. Trend: mean of the newer half of the trend window against the older half
+        double first_sma = earlier_half_.mean();
+        double second_sma = recent_half_.mean();
 
         MarketState new_state;
         // Determine Volatility Regime
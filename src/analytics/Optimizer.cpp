@@ -1,6 +1,9 @@
 #include "../../include/analytics/Optimizer.h"
+#include "../../include/analytics/ImbalanceSweep.h"
 #include "../../include/core/Application.h" // We will run the Application class
 #include "../../include/core/Log.h"
+#include "../../include/data/DatasetCache.h"
+#include <limits>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -24,6 +27,8 @@ void Optimizer::generate_test_configs() {
                     strat.params.imbalance_threshold = threshold;
                 }
             }
+            // Every backtest in the grid replays the same slice, so share one decoded copy.
+            new_config.data.use_dataset_cache = true;
             test_configs_.push_back(new_config);
         }
     }
@@ -31,8 +36,29 @@ void Optimizer::generate_test_configs() {
 
 void Optimizer::run() {
     Log::get_logger()->info("--- Starting Strategy Optimization ---");
+
+    // A threshold grid over order book data only changes the signal comparison,
+    // so one replay evaluates every threshold instead of one backtest each.
+    const auto& ranges = base_config_.optimization.param_ranges;
+    if (ranges.size() == 1 && ranges.count("imbalance_threshold") &&
+        base_config_.optimization.strategy_name == "ORDER_BOOK_IMBALANCE" && ImbalanceSweep::supports(base_config_)) {
+        run_sweep(ranges.at("imbalance_threshold"));
+        return;
+    }
+
     Log::get_logger()->info("Running {} backtests...", test_configs_.size());
 
+    // Pin the dataset for the whole search; otherwise it would be released and
+    // re-parsed between consecutive backtests.
+    const auto& data = base_config_.data;
+    auto dataset = DatasetCache::get_instance().acquire(
+        data.file_path,
+        data.start_time != 0 ? data.start_time : std::numeric_limits<int64_t>::min(),
+        data.end_time != 0 ? data.end_time : std::numeric_limits<int64_t>::max());
+    if (!dataset) {
+        Log::get_logger()->warn("Could not load {} into the dataset cache.", data.file_path);
+    }
+
     for (const auto& config : test_configs_) {
         // Create a temporary Application instance to run a single backtest
         Application backtest_app(config);
@@ -50,6 +76,24 @@ void Optimizer::run() {
     }
 }
 
+void Optimizer::run_sweep(const std::vector<double>& thresholds) {
+    Log::get_logger()->info("Sweeping {} thresholds in one pass...", thresholds.size());
+    ImbalanceSweep sweep(base_config_, thresholds);
+    if (!sweep.run()) {
+        return;
+    }
+    for (size_t lane = 0; lane < sweep.lane_count(); ++lane) {
+        auto report = sweep.report(lane);
+        double sharpe = report.count("sharpe_ratio") ? report.at("sharpe_ratio") : 0.0;
+
+        std::stringstream ss;
+        ss << "threshold:" << sweep.threshold(lane);
+        results_[ss.str()] = sharpe;
+
+        Log::get_logger()->info("Params: {} -> Sharpe Ratio: {:.2f}", ss.str(), sharpe);
+    }
+}
+
 void Optimizer::print_results() const {
     Log::get_logger()->info("--- OPTIMIZATION RESULTS ---");
     if (results_.empty()) {
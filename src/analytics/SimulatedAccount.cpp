@@ -0,0 +1,77 @@
+#include "../../include/analytics/SimulatedAccount.h"
+#include "../../include/analytics/Analytics.h"
+#include "../../include/risk/OrderSizing.h"
+#include <algorithm>
+
+namespace hft_system
+{
+
+    SimulatedAccount::SimulatedAccount(const Config &config, std::string symbol)
+        : risk_(config.risk),
+          execution_(config.execution),
+          symbol_(std::move(symbol)),
+          cash_(config.initial_capital),
+          equity_(config.initial_capital),
+          // The PortfolioManager publishes the starting capital before any fill.
+          equity_curve_{config.initial_capital} {}
+
+    bool SimulatedAccount::on_signal(OrderDirection direction, Price market_price, const InstrumentSpec &spec)
+    {
+        // RiskManager::on_signal
+        if (market_price.value <= 0)
+            return false;
+        const OrderSizing sizing = size_order(equity_ * risk_.risk_per_trade_pct, cash_, market_price, spec);
+        if (sizing.result != OrderSizing::Result::OK)
+            return false;
+        const Quantity order_quantity = sizing.quantity;
+        const double price = spec.to_double(market_price);
+
+        // ExecutionHandler::on_order
+        const double slippage = price * execution_.slippage_pct;
+        const Price fill_price = spec.to_price(direction == OrderDirection::BUY ? price + slippage : price - slippage);
+        const double cost = spec.notional(fill_price, order_quantity);
+        const double commission = cost * execution_.commission_pct;
+
+        // PortfolioManager::on_fill
+        cash_ += direction == OrderDirection::BUY ? -(cost + commission) : cost - commission;
+        if (position_lots_ != 0 && direction != position_direction_)
+        {
+            const int64_t closed = std::min(position_lots_, order_quantity.value);
+            Trade trade;
+            trade.symbol = symbol_;
+            trade.direction = position_direction_;
+            trade.quantity = spec.to_double(Quantity(closed));
+            trade.entry_price = entry_price_;
+            trade.exit_price = spec.to_double(fill_price);
+            if (trade.direction == OrderDirection::BUY)
+                trade.pnl = (trade.exit_price - trade.entry_price) * trade.quantity - commission;
+            else
+                trade.pnl = (trade.entry_price - trade.exit_price) * trade.quantity - commission;
+            trade_log_.push_back(trade);
+
+            position_lots_ -= closed;
+            if (position_lots_ == 0)
+            {
+                position_direction_ = OrderDirection::NONE;
+                entry_price_ = 0.0;
+            }
+        }
+        else
+        {
+            const double total_value = entry_price_ * spec.to_double(Quantity(position_lots_)) + cost;
+            position_lots_ += order_quantity.value;
+            entry_price_ = total_value / spec.to_double(Quantity(position_lots_));
+            position_direction_ = direction;
+        }
+
+        equity_ = cash_ + spec.to_double(Quantity(position_lots_)) * entry_price_;
+        equity_curve_.push_back(equity_);
+        return true;
+    }
+
+    std::map<std::string, double> SimulatedAccount::report() const
+    {
+        return Analytics::build_report(equity_curve_, trade_log_);
+    }
+
+} // namespace hft_system
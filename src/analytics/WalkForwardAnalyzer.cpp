@@ -27,6 +27,12 @@ namespace hft_system
         return std::chrono::system_clock::from_time_t(std::mktime(&tm));
     }
 
+    // Data files are timestamped in epoch seconds.
+    long long to_epoch_seconds(const std::chrono::system_clock::time_point &tp)
+    {
+        return std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch()).count();
+    }
+
     WalkForwardAnalyzer::WalkForwardAnalyzer(Config config) : base_config_(std::move(config)) {}
 
     void WalkForwardAnalyzer::run()
@@ -50,11 +56,11 @@ namespace hft_system
             Log::get_logger()->info("Range: {} to {}", time_point_to_string(in_sample_start), time_point_to_string(in_sample_end));
 
             // 1. Optimize on In-Sample Data
+            // The data handler seeks straight to each slice through the file's time index.
             Config opt_config = base_config_;
-            opt_config.data.file_path = "tests/data/order_book_data.csv"; // Use appropriate full dataset
             opt_config.run_mode = RunMode::OPTIMIZATION;
-            // Note: For a real test, you'd need logic to select the correct historical data slice.
-            // We are simplifying here by running on the full dataset.
+            opt_config.data.start_time = to_epoch_seconds(in_sample_start);
+            opt_config.data.end_time = to_epoch_seconds(in_sample_end);
 
             Optimizer optimizer(opt_config);
             optimizer.run();
@@ -65,8 +71,9 @@ namespace hft_system
 
             // 2. Test on Out-of-Sample Data
             Config test_config = base_config_;
-            test_config.data.file_path = "tests/data/order_book_data.csv";
             test_config.run_mode = RunMode::BACKTEST;
+            test_config.data.start_time = to_epoch_seconds(out_of_sample_start);
+            test_config.data.end_time = to_epoch_seconds(out_of_sample_end);
 
             Application backtest_app(test_config);
             auto report = backtest_app.run_backtest();
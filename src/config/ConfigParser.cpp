@@ -44,6 +44,40 @@ namespace hft_system
             data_obj["data_file"].get_string().get(file_path);
             config.data.symbol = symbol;
             config.data.file_path = file_path;
+            int64_t replay_delay_us;
+            if (data_obj["replay_delay_us"].get_int64().get(replay_delay_us) == simdjson::SUCCESS)
+            {
+                config.data.replay_delay_us = static_cast<int>(replay_delay_us);
+            }
+            bool lockstep;
+            if (data_obj["lockstep"].get_bool().get(lockstep) == simdjson::SUCCESS)
+            {
+                config.data.lockstep = lockstep;
+            }
+            int64_t start_time, end_time;
+            if (data_obj["start_time"].get_int64().get(start_time) == simdjson::SUCCESS)
+            {
+                config.data.start_time = start_time;
+            }
+            if (data_obj["end_time"].get_int64().get(end_time) == simdjson::SUCCESS)
+            {
+                config.data.end_time = end_time;
+            }
+            bool use_dataset_cache;
+            if (data_obj["use_dataset_cache"].get_bool().get(use_dataset_cache) == simdjson::SUCCESS)
+            {
+                config.data.use_dataset_cache = use_dataset_cache;
+            }
+            std::string_view format;
+            if (data_obj["format"].get_string().get(format) == simdjson::SUCCESS)
+            {
+                config.data.format = format;
+            }
+            double replay_speed;
+            if (data_obj["replay_speed"].get_double().get(replay_speed) == simdjson::SUCCESS)
+            {
+                config.data.replay_speed = replay_speed;
+            }
         }
 
         simdjson::ondemand::object exec_obj;
@@ -83,6 +117,132 @@ namespace hft_system
             config.websocket.host = host;
             config.websocket.target = target;
             config.websocket.symbol = symbol;
+            std::string_view record_path;
+            if (ws_obj["record_path"].get_string().get(record_path) == simdjson::SUCCESS)
+            {
+                config.websocket.record_path = record_path;
+            }
+            std::string_view capture_path;
+            if (ws_obj["capture_path"].get_string().get(capture_path) == simdjson::SUCCESS)
+            {
+                config.websocket.capture_path = capture_path;
+            }
+            int64_t capture_segment_bytes, capture_max_segments;
+            if (ws_obj["capture_segment_bytes"].get_int64().get(capture_segment_bytes) == simdjson::SUCCESS)
+            {
+                config.websocket.capture_segment_bytes = static_cast<size_t>(capture_segment_bytes);
+            }
+            if (ws_obj["capture_max_segments"].get_int64().get(capture_max_segments) == simdjson::SUCCESS)
+            {
+                config.websocket.capture_max_segments = static_cast<size_t>(capture_max_segments);
+            }
+            double price_tick, qty_lot;
+            if (ws_obj["price_tick"].get_double().get(price_tick) == simdjson::SUCCESS)
+            {
+                config.websocket.price_tick = price_tick;
+            }
+            if (ws_obj["qty_lot"].get_double().get(qty_lot) == simdjson::SUCCESS)
+            {
+                config.websocket.qty_lot = qty_lot;
+            }
+            std::string_view snapshot_file, rest_url;
+            if (ws_obj["snapshot_file"].get_string().get(snapshot_file) == simdjson::SUCCESS)
+            {
+                config.websocket.snapshot_file = snapshot_file;
+            }
+            if (ws_obj["rest_url"].get_string().get(rest_url) == simdjson::SUCCESS)
+            {
+                config.websocket.rest_url = rest_url;
+            }
+            int64_t snapshot_limit, snapshot_timeout_ms, book_depth;
+            if (ws_obj["snapshot_limit"].get_int64().get(snapshot_limit) == simdjson::SUCCESS)
+            {
+                config.websocket.snapshot_limit = static_cast<int>(snapshot_limit);
+            }
+            if (ws_obj["snapshot_timeout_ms"].get_int64().get(snapshot_timeout_ms) == simdjson::SUCCESS)
+            {
+                config.websocket.snapshot_timeout_ms = static_cast<int>(snapshot_timeout_ms);
+            }
+            if (ws_obj["book_depth"].get_int64().get(book_depth) == simdjson::SUCCESS)
+            {
+                config.websocket.book_depth = static_cast<int>(book_depth);
+            }
+            simdjson::ondemand::array symbols_array, streams_array;
+            if (ws_obj["symbols"].get_array().get(symbols_array) == simdjson::SUCCESS)
+            {
+                for (auto symbol_val : symbols_array)
+                {
+                    std::string_view name;
+                    if (symbol_val.get_string().get(name) == simdjson::SUCCESS)
+                    {
+                        config.websocket.symbols.emplace_back(name);
+                    }
+                }
+            }
+            if (ws_obj["streams"].get_array().get(streams_array) == simdjson::SUCCESS)
+            {
+                config.websocket.streams.clear();
+                for (auto stream_val : streams_array)
+                {
+                    std::string_view stream;
+                    if (stream_val.get_string().get(stream) == simdjson::SUCCESS)
+                    {
+                        config.websocket.streams.emplace_back(stream);
+                    }
+                }
+            }
+            int64_t connections;
+            if (ws_obj["connections"].get_int64().get(connections) == simdjson::SUCCESS)
+            {
+                config.websocket.connections = static_cast<int>(connections);
+            }
+            int64_t reconnect_initial_ms, reconnect_max_ms, max_reconnects;
+            if (ws_obj["reconnect_initial_ms"].get_int64().get(reconnect_initial_ms) == simdjson::SUCCESS)
+            {
+                config.websocket.reconnect_initial_ms = static_cast<int>(reconnect_initial_ms);
+            }
+            if (ws_obj["reconnect_max_ms"].get_int64().get(reconnect_max_ms) == simdjson::SUCCESS)
+            {
+                config.websocket.reconnect_max_ms = static_cast<int>(reconnect_max_ms);
+            }
+            if (ws_obj["max_reconnects"].get_int64().get(max_reconnects) == simdjson::SUCCESS)
+            {
+                config.websocket.max_reconnects = static_cast<int>(max_reconnects);
+            }
+            bool use_tls;
+            if (ws_obj["use_tls"].get_bool().get(use_tls) == simdjson::SUCCESS)
+            {
+                config.websocket.use_tls = use_tls;
+            }
+        }
+
+        simdjson::ondemand::array instruments_array;
+        if (doc["instruments"].get_array().get(instruments_array) == simdjson::SUCCESS)
+        {
+            for (auto instrument_val : instruments_array)
+            {
+                simdjson::ondemand::object instrument_obj;
+                if (instrument_val.get_object().get(instrument_obj) != simdjson::SUCCESS)
+                {
+                    continue;
+                }
+                InstrumentConfig ic;
+                std::string_view symbol;
+                if (instrument_obj["symbol"].get_string().get(symbol) == simdjson::SUCCESS)
+                {
+                    ic.symbol = symbol;
+                }
+                double price_tick, qty_lot;
+                if (instrument_obj["price_tick"].get_double().get(price_tick) == simdjson::SUCCESS)
+                {
+                    ic.price_tick = price_tick;
+                }
+                if (instrument_obj["qty_lot"].get_double().get(qty_lot) == simdjson::SUCCESS)
+                {
+                    ic.qty_lot = qty_lot;
+                }
+                config.instruments.push_back(ic);
+            }
         }
 
         simdjson::ondemand::array strategies_array;
@@ -104,10 +264,35 @@ namespace hft_system
                     params_obj["lookback_levels"].get_int64().get(lookback_val);
                     sc.params.lookback_levels = static_cast<int>(lookback_val);
                     params_obj["imbalance_threshold"].get_double().get(sc.params.imbalance_threshold);
+                    double level_decay;
+                    if (params_obj["level_decay"].get_double().get(level_decay) == simdjson::SUCCESS)
+                        sc.params.level_decay = level_decay;
+                    int64_t vwap_size;
+                    if (params_obj["vwap_size"].get_int64().get(vwap_size) == simdjson::SUCCESS)
+                    {
+                        if (vwap_size < 0)
+                            throw std::runtime_error("strategy " + sc.name + ": vwap_size cannot be negative");
+                        sc.params.vwap_size = vwap_size;
+                    }
+                    int64_t period;
+                    if (params_obj["fast_period"].get_int64().get(period) == simdjson::SUCCESS)
+                        sc.params.fast_period = static_cast<int>(period);
+                    if (params_obj["slow_period"].get_int64().get(period) == simdjson::SUCCESS)
+                        sc.params.slow_period = static_cast<int>(period);
                 }
                 config.strategies.push_back(sc);
             }
         }
+        std::string_view strategy_dispatch;
+        if (doc["strategy_dispatch"].get_string().get(strategy_dispatch) == simdjson::SUCCESS)
+        {
+            config.strategy_dispatch = strategy_dispatch;
+        }
+        int64_t strategy_workers;
+        if (doc["strategy_workers"].get_int64().get(strategy_workers) == simdjson::SUCCESS && strategy_workers > 0)
+        {
+            config.strategy_workers = static_cast<int>(strategy_workers);
+        }
 
         simdjson::ondemand::object opt_obj;
         if (doc["optimization"].get_object().get(opt_obj) == simdjson::SUCCESS)
@@ -160,6 +345,50 @@ namespace hft_system
             config.machine_learning.model_path = model_path;
         }
 
+        simdjson::ondemand::object bars_obj;
+        if (doc["bars"].get_object().get(bars_obj) == simdjson::SUCCESS)
+        {
+            std::string_view source;
+            if (bars_obj["source"].get_string().get(source) == simdjson::SUCCESS)
+            {
+                config.bars.use_book_mid = source == "book_mid";
+            }
+            simdjson::ondemand::array seconds_array;
+            if (bars_obj["time_windows_s"].get_array().get(seconds_array) == simdjson::SUCCESS)
+            {
+                for (auto seconds : seconds_array)
+                {
+                    config.bars.windows.push_back({BarSpec::Kind::TIME, double(seconds.get_double()) * 1e9});
+                }
+            }
+            simdjson::ondemand::array volume_array;
+            if (bars_obj["volume_windows"].get_array().get(volume_array) == simdjson::SUCCESS)
+            {
+                for (auto volume : volume_array)
+                {
+                    // Book mids carry no traded volume, so a volume bar over them would never close.
+                    if (config.bars.use_book_mid)
+                        throw std::runtime_error("bars: volume_windows cannot be used with \"source\": \"book_mid\"");
+                    config.bars.windows.push_back({BarSpec::Kind::VOLUME, double(volume.get_double())});
+                }
+            }
+        }
+
+        simdjson::ondemand::object snapshot_obj;
+        if (doc["snapshot"].get_object().get(snapshot_obj) == simdjson::SUCCESS)
+        {
+            std::string_view path;
+            if (snapshot_obj["path"].get_string().get(path) == simdjson::SUCCESS)
+            {
+                config.snapshot.path = path;
+            }
+            int64_t interval_s;
+            if (snapshot_obj["interval_s"].get_int64().get(interval_s) == simdjson::SUCCESS && interval_s > 0)
+            {
+                config.snapshot.interval_s = static_cast<int>(interval_s);
+            }
+        }
+
         return config;
     }
 
@@ -1,12 +1,25 @@
 #include "../../include/core/Application.h"
 #include "../../include/core/Log.h"
+#include "../../include/core/SymbolRegistry.h"
+#include "../../include/core/Snapshot.h"
+#include "../../include/utils/PerformanceMonitor.h"
+#include "../../include/utils/Timer.h"
+#include <algorithm>
 #include <future>
+#include <limits>
 
 // Include full definitions of all components
 #include "../../include/data/HistoricCSVDataHandler.h"
+#include "../../include/data/DatasetCache.h"
+#include "../../include/data/DatasetReplayHandler.h"
+#include "../../include/data/TickDataHandler.h"
+#include "../../include/data/CaptureReplayHandler.h"
+#include "../../include/data/BarAggregator.h"
 #include "../../include/data/WebSocketDataHandler.h"
 #include "../../include/strategy/StrategyManager.h"
+#include "../../include/strategy/StaticStrategySet.h"
 #include "../../include/strategy/OrderBookImbalanceStrategy.h"
+#include "../../include/strategy/MovingAverageCrossStrategy.h"
 #include "../../include/core/PortfolioManager.h"
 #include "../../include/risk/RiskManager.h"
 #include "../../include/execution/ExecutionHandler.h"
@@ -15,21 +28,91 @@
 
 namespace hft_system
 {
+    namespace
+    {
+        // Strategy types compiled into the "static" strategy_dispatch pipeline.
+        using ProductionStrategySet = StaticStrategySet<OrderBookImbalanceStrategy, MovingAverageCrossStrategy>;
+    }
 
     Application::Application(Config config)
         : config_(std::move(config))
     {
         event_bus_ = std::make_shared<EventBus>();
 
+        // Tick and lot grids must be known before any price or quantity is parsed.
+        for (const auto &instrument : config_.instruments)
+        {
+            if (instrument.price_tick <= 0.0 || instrument.qty_lot <= 0.0)
+            {
+                Log::get_logger()->error("Ignoring instrument {}: tick and lot sizes must be positive.", instrument.symbol);
+                continue;
+            }
+            SymbolRegistry::get_instance().set_spec(intern_symbol(instrument.symbol),
+                                                    InstrumentSpec::from(instrument.price_tick, instrument.qty_lot));
+        }
+
+        const bool replay_capture = config_.run_mode != RunMode::LIVE && config_.data.format == "capture";
+        if (config_.run_mode == RunMode::LIVE || replay_capture)
+        {
+            // Subscribed symbols without an instruments entry use the websocket section's grid.
+            for (const auto &symbol : WebSocketDataHandler::subscribed_symbols(config_.websocket))
+            {
+                bool listed = std::any_of(config_.instruments.begin(), config_.instruments.end(),
+                                          [&](const InstrumentConfig &instrument)
+                                          { return instrument.symbol == symbol; });
+                if (!listed)
+                {
+                    SymbolRegistry::get_instance().set_spec(intern_symbol(symbol),
+                                                            InstrumentSpec::from(config_.websocket.price_tick, config_.websocket.qty_lot));
+                }
+            }
+        }
+
         // **THE FIX IS HERE:** Create the DataHandler in the constructor, on the main thread.
         if (config_.run_mode == RunMode::LIVE)
         {
             data_handler_ = std::make_shared<WebSocketDataHandler>(event_bus_, config_.websocket);
         }
+        else if (replay_capture)
+        {
+            // A capture replays with the grids it was recorded with: the websocket section it was taken under.
+            auto capture_handler = std::make_shared<CaptureReplayHandler>(event_bus_, config_.data.file_path,
+                                                                          static_cast<size_t>(config_.websocket.book_depth));
+            capture_handler->set_replay_speed(config_.data.replay_speed);
+            data_handler_ = capture_handler;
+        }
+        else if (config_.data.format == "ticks")
+        {
+            auto tick_handler = std::make_shared<TickDataHandler>(event_bus_, config_.data.file_path);
+            tick_handler->set_replay_delay(std::chrono::microseconds(config_.data.replay_delay_us));
+            if (config_.data.start_time != 0 || config_.data.end_time != 0)
+            {
+                tick_handler->set_time_range(config_.data.start_time,
+                                             config_.data.end_time != 0 ? config_.data.end_time : std::numeric_limits<int64_t>::max());
+            }
+            data_handler_ = tick_handler;
+        }
+        else if (config_.data.use_dataset_cache)
+        {
+            int64_t start = config_.data.start_time != 0 ? config_.data.start_time : std::numeric_limits<int64_t>::min();
+            int64_t end = config_.data.end_time != 0 ? config_.data.end_time : std::numeric_limits<int64_t>::max();
+            auto dataset = DatasetCache::get_instance().acquire(config_.data.file_path, start, end);
+            auto replay_handler = std::make_shared<DatasetReplayHandler>(event_bus_, config_.data.symbol, std::move(dataset));
+            replay_handler->set_replay_delay(std::chrono::microseconds(config_.data.replay_delay_us));
+            data_handler_ = replay_handler;
+        }
         else
         {
-            data_handler_ = std::make_shared<HistoricCSVDataHandler>(event_bus_, config_.data.symbol, config_.data.file_path);
+            auto csv_handler = std::make_shared<HistoricCSVDataHandler>(event_bus_, config_.data.symbol, config_.data.file_path);
+            csv_handler->set_replay_delay(std::chrono::microseconds(config_.data.replay_delay_us));
+            if (config_.data.start_time != 0 || config_.data.end_time != 0)
+            {
+                csv_handler->set_time_range(config_.data.start_time,
+                                            config_.data.end_time != 0 ? config_.data.end_time : std::numeric_limits<int64_t>::max());
+            }
+            data_handler_ = csv_handler;
         }
+        data_handler_->set_lockstep(config_.data.lockstep);
     }
 
     Application::~Application()
@@ -86,27 +169,66 @@ namespace hft_system
         try
         {
             // Create all other components
-            strategy_manager_ = std::make_shared<StrategyManager>(event_bus_, "StrategyManager");
+            if (config_.strategy_dispatch == "static")
+            {
+                auto pipeline = std::make_shared<ProductionStrategySet>(event_bus_, "StaticStrategySet");
+                for (const auto &sc : config_.strategies)
+                {
+                    if (sc.name == "ORDER_BOOK_IMBALANCE")
+                    {
+                        pipeline->add_strategy(OrderBookImbalanceStrategy(sc.symbol, sc.params.lookback_levels, sc.params.imbalance_threshold, sc.params.level_decay, sc.params.vwap_size));
+                    }
+                    else if (sc.name == "MA_CROSSOVER")
+                    {
+                        pipeline->add_strategy(MovingAverageCrossStrategy(sc.symbol, sc.params.fast_period, sc.params.slow_period));
+                    }
+                }
+                strategy_manager_ = pipeline;
+            }
+            else
+            {
+                auto manager = std::make_shared<StrategyManager>(event_bus_, "StrategyManager", config_.strategy_workers);
+                for (const auto &sc : config_.strategies)
+                {
+                    if (sc.name == "ORDER_BOOK_IMBALANCE")
+                    {
+                        manager->add_strategy(std::make_unique<OrderBookImbalanceStrategy>(sc.symbol, sc.params.lookback_levels, sc.params.imbalance_threshold, sc.params.level_decay, sc.params.vwap_size));
+                    }
+                    else if (sc.name == "MA_CROSSOVER")
+                    {
+                        manager->add_strategy(std::make_unique<MovingAverageCrossStrategy>(sc.symbol, sc.params.fast_period, sc.params.slow_period));
+                    }
+                }
+                strategy_manager_ = manager;
+            }
+
             portfolio_manager_ = std::make_shared<PortfolioManager>(event_bus_, "PortfolioManager", config_.initial_capital);
             ml_manager_ = std::make_shared<MLModelManager>(event_bus_, "MLModelManager", config_.machine_learning);
             risk_manager_ = std::make_shared<RiskManager>(event_bus_, "RiskManager", config_, ml_manager_);
             execution_handler_ = std::make_shared<ExecutionHandler>(event_bus_, "ExecutionHandler", config_.execution);
             analytics_ = std::make_shared<Analytics>(event_bus_, "Analytics", config_.analytics);
-
-            for (const auto &sc : config_.strategies)
+            if (!config_.bars.windows.empty())
             {
-                if (sc.name == "ORDER_BOOK_IMBALANCE")
-                {
-                    strategy_manager_->add_strategy(std::make_unique<OrderBookImbalanceStrategy>(sc.symbol, sc.params.lookback_levels, sc.params.imbalance_threshold));
-                }
+                bar_aggregator_ = std::make_shared<BarAggregator>(event_bus_, "BarAggregator", config_.bars);
             }
 
             std::promise<void> promise;
             auto future = promise.get_future();
             event_bus_->subscribe(EventType::SYSTEM, [&](const Event &e)
                                   {
+            // The data handler has run out of data, so the bars still open are complete.
+            if (bar_aggregator_)
+                bar_aggregator_->flush();
             try { promise.set_value(); } catch (const std::future_error& e) {} });
 
+            const bool snapshots = config_.run_mode == RunMode::LIVE && !config_.snapshot.path.empty();
+            if (snapshots)
+            {
+                restore_snapshot();
+                event_bus_->subscribe(EventType::SNAPSHOT, [this](const Event &)
+                                      { capture_snapshot(); });
+            }
+
             event_bus_->start();
             portfolio_manager_->start();
             strategy_manager_->start();
@@ -114,6 +236,8 @@ namespace hft_system
             ml_manager_->start();
             execution_handler_->start();
             analytics_->start();
+            if (bar_aggregator_)
+                bar_aggregator_->start();
 
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
@@ -126,13 +250,23 @@ namespace hft_system
             }
             else
             {
+                const auto interval = std::chrono::seconds(config_.snapshot.interval_s);
+                auto next_snapshot = std::chrono::steady_clock::now() + interval;
                 while (is_running_.load())
                 {
                     std::this_thread::sleep_for(std::chrono::seconds(1));
+                    if (snapshots && std::chrono::steady_clock::now() >= next_snapshot)
+                    {
+                        // Queued behind the market data, so the capture sees a consistent state.
+                        event_bus_->publish(std::make_shared<Event>(EventType::SNAPSHOT));
+                        next_snapshot += interval;
+                    }
                 }
             }
 
             data_handler_->stop();
+            if (bar_aggregator_)
+                bar_aggregator_->stop();
             analytics_->stop();
             execution_handler_->stop();
             risk_manager_->stop();
@@ -140,6 +274,8 @@ namespace hft_system
             strategy_manager_->stop();
             portfolio_manager_->stop();
             event_bus_->stop();
+            if (snapshots)
+                write_final_snapshot();
         }
         catch (const std::exception &e)
         {
@@ -148,4 +284,53 @@ namespace hft_system
         is_running_.store(false);
     }
 
-} // namespace hft_system
\ No newline at end of file
+    std::vector<std::shared_ptr<Component>> Application::stateful_components() const
+    {
+        return {strategy_manager_, portfolio_manager_};
+    }
+
+    void Application::restore_snapshot()
+    {
+        Timer restore_timer;
+        Snapshot snapshot;
+        if (!snapshot.load(config_.snapshot.path))
+        {
+            Log::get_logger()->info("No usable snapshot at {}; starting cold.", config_.snapshot.path);
+            return;
+        }
+        for (const auto &component : stateful_components())
+            component->restore_snapshot(snapshot);
+        Log::get_logger()->info("Restored {} snapshot sections from {} in {:.3f} ms.",
+                                snapshot.section_count(), config_.snapshot.path, restore_timer.elapsed_nanoseconds() / 1e6);
+    }
+
+    void Application::capture_snapshot()
+    {
+        // A write still in flight means the disk is slower than the interval; skip this round.
+        if (snapshot_write_.valid() && snapshot_write_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            Log::get_logger()->warn("Previous snapshot is still being written; skipping this one.");
+            return;
+        }
+        Timer capture_timer;
+        Snapshot snapshot;
+        for (const auto &component : stateful_components())
+            component->save_snapshot(snapshot);
+        PerformanceMonitor::get_instance().record_metric("Application_snapshot_capture", capture_timer.elapsed_nanoseconds());
+        snapshot_write_ = std::async(std::launch::async, [snapshot = std::move(snapshot), path = config_.snapshot.path]
+                                     { return snapshot.save(path); });
+    }
+
+    void Application::write_final_snapshot()
+    {
+        // The EventBus is stopped, so the state can be read from this thread.
+        if (snapshot_write_.valid())
+            snapshot_write_.wait();
+        Snapshot snapshot;
+        for (const auto &component : stateful_components())
+            component->save_snapshot(snapshot);
+        if (snapshot.save(config_.snapshot.path))
+            Log::get_logger()->info("Wrote snapshot to {}.", config_.snapshot.path);
+    }
+
+} // namespace hft_system
@@ -28,10 +28,33 @@ namespace hft_system
         {
             std::lock_guard<std::mutex> lock(queue_mutex_);
             event_queue_.push(std::move(event));
+            ++pending_;
         }
         queue_cond_.notify_one();
     }
 
+    void EventBus::publish_batch(std::vector<std::shared_ptr<Event>> events)
+    {
+        if (events.empty())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            for (auto &event : events)
+            {
+                event_queue_.push(std::move(event));
+            }
+            pending_ += events.size();
+        }
+        queue_cond_.notify_one();
+    }
+
+    void EventBus::wait_until_idle()
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        idle_cond_.wait(lock, [this]
+                        { return pending_ == 0; });
+    }
+
     void EventBus::start()
     {
         if (is_running_.load())
@@ -122,9 +145,15 @@ namespace hft_system
                 case EventType::MARKET_REGIME_CHANGED:
                     event_type_str = "MARKET_REGIME_CHANGED";
                     break;
+                case EventType::QUOTE:
+                    event_type_str = "QUOTE";
+                    break;
                 case EventType::SYSTEM:
                     event_type_str = "SYSTEM";
                     break;
+                case EventType::SNAPSHOT:
+                    event_type_str = "SNAPSHOT";
+                    break;
                 default:
                     event_type_str = "UNKNOWN";
                     break;
@@ -148,6 +177,13 @@ namespace hft_system
                 PerformanceMonitor::get_instance().record_metric(
                     "EventBus_dispatch_" + event_type_str, event_timer.elapsed_nanoseconds());
             }
+
+            // Anything the subscribers published was counted before this event is uncounted.
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex_);
+                if (--pending_ == 0)
+                    idle_cond_.notify_all();
+            }
         }
         Log::get_logger()->info("EventBus dispatch loop finished.");
     }
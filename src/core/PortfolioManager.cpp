@@ -1,5 +1,7 @@
 #include "../../include/core/PortfolioManager.h"
 #include "../../include/core/Log.h"
+#include "../../include/core/SymbolRegistry.h"
+#include "../../include/core/Snapshot.h"
 #include "../../include/utils/Timer.h"
 #include "../../include/utils/PerformanceMonitor.h"
 #include <functional>
@@ -21,7 +23,8 @@ namespace hft_system
     void PortfolioManager::start()
     {
         Log::get_logger()->info("{} started.", name_);
-        auto initial_update = std::make_shared<PortfolioUpdateEvent>(capital_, cash_);
+        // Equals the initial capital unless positions were restored from a snapshot.
+        auto initial_update = std::make_shared<PortfolioUpdateEvent>(total_equity(), cash_);
         event_bus_->publish(initial_update);
     }
 
@@ -36,7 +39,8 @@ namespace hft_system
 
         const auto &fill = static_cast<const FillEvent &>(event);
 
-        double cost = fill.fill_price * fill.quantity;
+        const InstrumentSpec spec = instrument_spec(fill.symbol_id);
+        double cost = spec.notional(fill.fill_price, fill.quantity);
         if (fill.direction == OrderDirection::BUY)
         {
             cash_ -= (cost + fill.commission);
@@ -46,17 +50,20 @@ namespace hft_system
             cash_ += (cost - fill.commission);
         }
 
-        Position &position = positions_[fill.symbol];
-        bool is_closing_trade = (position.quantity != 0) && (fill.direction != position.direction);
+        if (fill.symbol_id >= positions_.size())
+            positions_.resize(fill.symbol_id + 1);
+        Position &position = positions_[fill.symbol_id];
+        bool is_closing_trade = (position.quantity.value != 0) && (fill.direction != position.direction);
 
         if (is_closing_trade)
         {
             Trade trade;
-            trade.symbol = fill.symbol;
+            trade.symbol = symbol_name(fill.symbol_id);
             trade.direction = position.direction;
-            trade.quantity = std::min(position.quantity, fill.quantity);
+            const Quantity closed = std::min(position.quantity, fill.quantity);
+            trade.quantity = spec.to_double(closed);
             trade.entry_price = position.entry_price;
-            trade.exit_price = fill.fill_price;
+            trade.exit_price = spec.to_double(fill.fill_price);
 
             if (trade.direction == OrderDirection::BUY)
             {
@@ -69,30 +76,94 @@ namespace hft_system
             trade_log_.push_back(trade);
             Log::get_logger()->info("Closed trade for {}. P&L: ${:.2f}", trade.symbol, trade.pnl);
 
-            position.quantity -= trade.quantity;
-            if (position.quantity < 1e-9) // Check for near-zero quantity
+            position.quantity -= closed;
+            if (position.quantity.value == 0)
             {
-                positions_.erase(fill.symbol);
+                position = Position{};
             }
         }
         else
         {
-            double total_value = (position.entry_price * position.quantity) + cost;
+            double total_value = (position.entry_price * spec.to_double(position.quantity)) + cost;
             position.quantity += fill.quantity;
-            position.entry_price = total_value / position.quantity;
+            position.entry_price = total_value / spec.to_double(position.quantity);
             position.direction = fill.direction;
-            position.symbol = fill.symbol;
+            position.symbol_id = fill.symbol_id;
         }
 
+        auto update_event = std::make_shared<PortfolioUpdateEvent>(total_equity(), cash_);
+        event_bus_->publish(update_event);
+    }
+
+    double PortfolioManager::total_equity() const
+    {
         double open_positions_value = 0;
-        for (const auto &[symbol, pos] : positions_)
+        for (const auto &pos : positions_)
         {
-            open_positions_value += pos.quantity * pos.entry_price;
+            if (pos.quantity.value != 0)
+                open_positions_value += instrument_spec(pos.symbol_id).to_double(pos.quantity) * pos.entry_price;
         }
-        double total_equity = cash_ + open_positions_value;
+        return cash_ + open_positions_value;
+    }
 
-        auto update_event = std::make_shared<PortfolioUpdateEvent>(total_equity, cash_);
-        event_bus_->publish(update_event);
+    namespace
+    {
+        constexpr uint32_t PORTFOLIO_SECTION_VERSION = 1;
+    }
+
+    void PortfolioManager::save_snapshot(Snapshot &snapshot) const
+    {
+        SnapshotWriter &out = snapshot.add_section(name_, PORTFOLIO_SECTION_VERSION);
+        out.put(capital_);
+        out.put(cash_);
+        uint64_t open = std::count_if(positions_.begin(), positions_.end(), [](const Position &position)
+                                      { return position.quantity.value != 0; });
+        out.put(open);
+        for (const auto &position : positions_)
+        {
+            if (position.quantity.value == 0)
+                continue;
+            // SymbolIds are assigned per process; the name and lot count are what survive a restart.
+            out.put_string(symbol_name(position.symbol_id));
+            out.put(position.direction);
+            out.put(position.quantity.value);
+            out.put(position.entry_price);
+        }
+    }
+
+    void PortfolioManager::restore_snapshot(const Snapshot &snapshot)
+    {
+        auto in = snapshot.section(name_, PORTFOLIO_SECTION_VERSION);
+        if (!in)
+            return;
+        double capital = 0.0, cash = 0.0;
+        uint64_t open = 0;
+        if (!in->get(capital) || !in->get(cash) || !in->get(open))
+        {
+            Log::get_logger()->warn("{}: unreadable snapshot section; starting from the configured capital.", name_);
+            return;
+        }
+        std::vector<Position> positions;
+        for (uint64_t i = 0; i < open; ++i)
+        {
+            std::string symbol;
+            Position position;
+            int64_t lots = 0;
+            if (!in->get_string(symbol) || !in->get(position.direction) || !in->get(lots) || !in->get(position.entry_price))
+            {
+                Log::get_logger()->warn("{}: unreadable snapshot section; starting from the configured capital.", name_);
+                return;
+            }
+            position.symbol_id = intern_symbol(symbol);
+            position.quantity = Quantity(lots);
+            if (position.symbol_id >= positions.size())
+                positions.resize(position.symbol_id + 1);
+            positions[position.symbol_id] = position;
+        }
+        capital_ = capital;
+        cash_ = cash;
+        positions_ = std::move(positions);
+        Log::get_logger()->info("{}: restored cash ${:.2f} and {} open positions from snapshot.", name_, cash_, open);
     }
 
     const std::list<hft_system::Trade> &PortfolioManager::get_trade_log() const
@@ -0,0 +1,169 @@
+#include "../../include/core/Snapshot.h"
+#include "../../include/core/Log.h"
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+namespace hft_system
+{
+    namespace
+    {
+        constexpr char SNAPSHOT_MAGIC[8] = {'H', 'F', 'T', 'S', 'N', 'A', 'P', 'S'};
+        constexpr uint32_t SNAPSHOT_FORMAT_VERSION = 1;
+        constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+        struct SnapshotHeader
+        {
+            char magic[8];
+            uint32_t format_version;
+            uint32_t byte_order;
+            uint64_t section_count;
+        };
+
+        uint64_t fnv1a(const std::string &data)
+        {
+            uint64_t hash = 14695981039346656037ULL;
+            for (unsigned char byte : data)
+            {
+                hash ^= byte;
+                hash *= 1099511628211ULL;
+            }
+            return hash;
+        }
+
+        // Writes `data` to `path` and fsyncs it, so it is whole on disk before
+        // anything is renamed over the last good file. False on any error.
+        bool write_synced(const std::string &path, const std::string &data)
+        {
+            const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0)
+                return false;
+            const char *next = data.data();
+            size_t left = data.size();
+            while (left > 0)
+            {
+                const ssize_t written = ::write(fd, next, left);
+                if (written < 0 && errno == EINTR)
+                    continue;
+                if (written <= 0)
+                {
+                    ::close(fd);
+                    return false;
+                }
+                next += written;
+                left -= static_cast<size_t>(written);
+            }
+            const bool synced = ::fsync(fd) == 0;
+            return ::close(fd) == 0 && synced;
+        }
+    }
+
+    SnapshotWriter &Snapshot::add_section(const std::string &name, uint32_t version)
+    {
+        Section &section = sections_[name];
+        section.version = version;
+        section.writer = SnapshotWriter();
+        return section.writer;
+    }
+
+    std::optional<SnapshotReader> Snapshot::section(const std::string &name, uint32_t version) const
+    {
+        auto it = sections_.find(name);
+        if (it == sections_.end())
+        {
+            Log::get_logger()->warn("Snapshot has no {} section; it starts cold.", name);
+            return std::nullopt;
+        }
+        if (it->second.version != version)
+        {
+            Log::get_logger()->warn("Ignoring {} snapshot section: layout version {}, expected {}.",
+                                    name, it->second.version, version);
+            return std::nullopt;
+        }
+        return SnapshotReader(it->second.writer.data());
+    }
+
+    bool Snapshot::save(const std::string &path) const
+    {
+        SnapshotWriter body;
+        SnapshotHeader header{};
+        std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+        header.format_version = SNAPSHOT_FORMAT_VERSION;
+        header.byte_order = BYTE_ORDER_MARK;
+        header.section_count = sections_.size();
+        body.put(header);
+        for (const auto &[name, section] : sections_)
+        {
+            body.put_string(name);
+            body.put(section.version);
+            body.put_string(section.writer.data());
+        }
+        body.put(fnv1a(body.data()));
+
+        std::string tmp_path = path + ".tmp";
+        if (!write_synced(tmp_path, body.data()))
+        {
+            Log::get_logger()->error("Snapshot: cannot write {}", tmp_path);
+            std::remove(tmp_path.c_str());
+            return false;
+        }
+        if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+        {
+            Log::get_logger()->error("Snapshot: cannot replace {}", path);
+            return false;
+        }
+        return true;
+    }
+
+    bool Snapshot::load(const std::string &path)
+    {
+        sections_.clear();
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+            return false;
+        std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        SnapshotHeader header;
+        uint64_t checksum = 0;
+        if (contents.size() < sizeof(header) + sizeof(checksum))
+        {
+            Log::get_logger()->warn("Snapshot {} is truncated; ignoring it.", path);
+            return false;
+        }
+        std::memcpy(&header, contents.data(), sizeof(header));
+        if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+            header.format_version != SNAPSHOT_FORMAT_VERSION || header.byte_order != BYTE_ORDER_MARK)
+        {
+            Log::get_logger()->warn("Snapshot {} has an incompatible format; ignoring it.", path);
+            return false;
+        }
+        std::memcpy(&checksum, contents.data() + contents.size() - sizeof(checksum), sizeof(checksum));
+        contents.resize(contents.size() - sizeof(checksum));
+        if (fnv1a(contents) != checksum)
+        {
+            Log::get_logger()->warn("Snapshot {} is corrupt; ignoring it.", path);
+            return false;
+        }
+
+        SnapshotReader reader(std::string_view(contents).substr(sizeof(header)));
+        for (uint64_t i = 0; i < header.section_count; ++i)
+        {
+            std::string name;
+            Section section;
+            if (!reader.get_string(name) || !reader.get(section.version) || !reader.get_string(section.writer.data()))
+                break;
+            sections_[name] = std::move(section);
+        }
+        if (!reader.ok() || !reader.at_end())
+        {
+            Log::get_logger()->warn("Snapshot {} is malformed; ignoring it.", path);
+            sections_.clear();
+            return false;
+        }
+        return true;
+    }
+
+} // namespace hft_system
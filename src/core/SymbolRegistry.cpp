@@ -0,0 +1,65 @@
+#include "../../include/core/SymbolRegistry.h"
+#include <mutex>
+
+namespace hft_system
+{
+    SymbolRegistry &SymbolRegistry::get_instance()
+    {
+        static SymbolRegistry instance;
+        return instance;
+    }
+
+    SymbolId SymbolRegistry::intern(std::string_view name)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = ids_.find(name);
+            if (it != ids_.end())
+                return it->second;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end())
+            return it->second; // Registered by another thread in the meantime
+        SymbolId id = static_cast<SymbolId>(names_.size());
+        names_.emplace_back(name);
+        specs_.emplace_back();
+        ids_.emplace(names_.back(), id);
+        return id;
+    }
+
+    SymbolId SymbolRegistry::find(std::string_view name) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        return it != ids_.end() ? it->second : INVALID_SYMBOL_ID;
+    }
+
+    const std::string &SymbolRegistry::name(SymbolId id) const
+    {
+        static const std::string unknown;
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return id < names_.size() ? names_[id] : unknown;
+    }
+
+    void SymbolRegistry::set_spec(SymbolId id, const InstrumentSpec &spec)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        if (id < specs_.size())
+            specs_[id] = spec;
+    }
+
+    InstrumentSpec SymbolRegistry::spec(SymbolId id) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return id < specs_.size() ? specs_[id] : InstrumentSpec{};
+    }
+
+    size_t SymbolRegistry::size() const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return names_.size();
+    }
+
+} // namespace hft_system
@@ -0,0 +1,131 @@
+#include "../../include/data/BarAggregator.h"
+#include "../../include/core/Log.h"
+#include "../../include/core/SymbolRegistry.h"
+#include <algorithm>
+#include <functional>
+
+namespace hft_system
+{
+    namespace
+    {
+        // Floor division, so ticks before the epoch still land in the right window.
+        int64_t window_index(int64_t time, int64_t width)
+        {
+            int64_t index = time / width;
+            return (time % width != 0 && time < 0) ? index - 1 : index;
+        }
+    }
+
+    BarAggregator::BarAggregator(std::shared_ptr<EventBus> event_bus, std::string name, BarConfig config)
+        : Component(event_bus, std::move(name)), config_(std::move(config))
+    {
+        using namespace std::placeholders;
+        if (config_.use_book_mid)
+        {
+            event_bus_->subscribe(EventType::ORDER_BOOK, std::bind(&BarAggregator::on_order_book_event, this, _1));
+        }
+        else
+        {
+            event_bus_->subscribe(EventType::MARKET, std::bind(&BarAggregator::on_market_event, this, _1));
+        }
+    }
+
+    void BarAggregator::start() { Log::get_logger()->info("{} started with {} bar windows.", name_, config_.windows.size()); }
+    void BarAggregator::stop() { Log::get_logger()->info("{} stopped.", name_); }
+
+    void BarAggregator::on_market_event(const Event &event)
+    {
+        const auto &market_event = static_cast<const MarketEvent &>(event);
+        int64_t time = market_event.exchange_time != 0 ? market_event.exchange_time : market_event.timestamp;
+        on_tick(market_event.symbol_id, time, market_event.price, market_event.volume);
+    }
+
+    void BarAggregator::on_order_book_event(const Event &event)
+    {
+        const auto &book = static_cast<const OrderBookEvent &>(event).book;
+        if (book.bids.empty() || book.asks.empty())
+            return;
+
+        Price best_bid = *std::max_element(book.bids.price, book.bids.price + book.bids.size());
+        Price best_ask = *std::min_element(book.asks.price, book.asks.price + book.asks.size());
+        // Book timestamps are exchange milliseconds.
+        int64_t time = book.timestamp != 0 ? book.timestamp * 1000000 : event.timestamp;
+        const InstrumentSpec spec = instrument_spec(book.symbol_id);
+        on_tick(book.symbol_id, time, (spec.to_double(best_bid) + spec.to_double(best_ask)) / 2.0, 0.0);
+    }
+
+    std::vector<BarAggregator::WindowState> &BarAggregator::windows_for(SymbolId symbol_id)
+    {
+        if (symbol_id >= windows_.size())
+            windows_.resize(symbol_id + 1);
+        auto &states = windows_[symbol_id];
+        if (states.empty() && !config_.windows.empty())
+        {
+            states.resize(config_.windows.size());
+            for (size_t i = 0; i < states.size(); ++i)
+            {
+                states[i].spec = config_.windows[i];
+            }
+        }
+        return states;
+    }
+
+    void BarAggregator::on_tick(SymbolId symbol_id, int64_t time_ns, double price, double volume)
+    {
+        for (auto &state : windows_for(symbol_id))
+        {
+            if (state.spec.kind == BarSpec::Kind::TIME)
+            {
+                int64_t width = std::max<int64_t>(static_cast<int64_t>(state.spec.size), 1);
+                int64_t bucket = window_index(time_ns, width);
+                if (state.open && bucket != state.bucket)
+                {
+                    publish_bar(symbol_id, state);
+                }
+                if (!state.open)
+                {
+                    state.bucket = bucket;
+                    state.bar = Bar{bucket * width, price, price, price, price, 0.0};
+                    state.open = true;
+                }
+            }
+            else if (!state.open)
+            {
+                state.bar = Bar{time_ns, price, price, price, price, 0.0};
+                state.open = true;
+            }
+
+            state.bar.high = std::max(state.bar.high, price);
+            state.bar.low = std::min(state.bar.low, price);
+            state.bar.close = price;
+            state.bar.volume += volume;
+
+            if (state.spec.kind == BarSpec::Kind::VOLUME && state.bar.volume >= state.spec.size)
+            {
+                publish_bar(symbol_id, state);
+            }
+        }
+    }
+
+    void BarAggregator::flush()
+    {
+        for (SymbolId symbol_id = 0; symbol_id < windows_.size(); ++symbol_id)
+        {
+            auto &states = windows_[symbol_id];
+            for (auto &state : states)
+            {
+                if (state.open)
+                {
+                    publish_bar(symbol_id, state);
+                }
+            }
+        }
+    }
+
+    void BarAggregator::publish_bar(SymbolId symbol_id, WindowState &state)
+    {
+        state.open = false;
+        event_bus_->publish(std::make_shared<BarEvent>(symbol_id, state.spec, state.bar));
+    }
+
+} // namespace hft_system
@@ -0,0 +1,263 @@
+#include "../../include/data/BinanceDepthDecoder.h"
+
+namespace hft_system
+{
+    namespace
+    {
+        // Appends every [price, qty] pair of a JSON array of levels.
+        bool decode_levels(simdjson::ondemand::value levels_value, const InstrumentSpec &spec, std::vector<OrderBookLevel> &levels)
+        {
+            simdjson::ondemand::array levels_array;
+            if (levels_value.get_array().get(levels_array) != simdjson::SUCCESS)
+                return false;
+
+            for (auto level_value : levels_array)
+            {
+                simdjson::ondemand::array level;
+                if (level_value.get_array().get(level) != simdjson::SUCCESS)
+                    return false;
+
+                OrderBookLevel parsed{};
+                int index = 0;
+                for (auto element : level)
+                {
+                    std::string_view text;
+                    if (element.get_string().get(text) != simdjson::SUCCESS)
+                        return false;
+                    if (index == 0 && !spec.parse_price(text, parsed.price))
+                        return false;
+                    if (index == 1 && !spec.parse_quantity(text, parsed.quantity))
+                        return false;
+                    ++index;
+                }
+                if (index < 2)
+                    return false;
+                levels.push_back(parsed);
+            }
+            return true;
+        }
+
+        // Records the [price, qty] strings of a JSON array of levels without parsing them.
+        bool index_levels(simdjson::ondemand::value levels_value, std::string &text, std::vector<RawDepthUpdate::LevelText> &levels)
+        {
+            simdjson::ondemand::array levels_array;
+            if (levels_value.get_array().get(levels_array) != simdjson::SUCCESS)
+                return false;
+
+            for (auto level_value : levels_array)
+            {
+                simdjson::ondemand::array level;
+                if (level_value.get_array().get(level) != simdjson::SUCCESS)
+                    return false;
+
+                RawDepthUpdate::LevelText indexed{};
+                int index = 0;
+                for (auto element : level)
+                {
+                    std::string_view value;
+                    if (element.get_string().get(value) != simdjson::SUCCESS || value.empty())
+                        return false;
+                    if (index == 0)
+                    {
+                        indexed.price_offset = static_cast<uint32_t>(text.size());
+                        indexed.price_size = static_cast<uint32_t>(value.size());
+                        text.append(value);
+                    }
+                    else if (index == 1)
+                    {
+                        indexed.quantity_offset = static_cast<uint32_t>(text.size());
+                        indexed.quantity_size = static_cast<uint32_t>(value.size());
+                        text.append(value);
+                    }
+                    ++index;
+                }
+                if (index < 2)
+                    return false;
+                levels.push_back(indexed);
+            }
+            return true;
+        }
+
+        // Walks the fields of a depthUpdate payload; `on_levels(value, is_bid)`
+        // consumes the "b" and "a" arrays.
+        template <typename OnLevels>
+        BinanceDepthDecoder::Result walk_fields(simdjson::ondemand::object &object, DepthUpdate &book,
+                                                int64_t &first_update_id, int64_t &final_update_id, OnLevels &&on_levels)
+        {
+            using Result = BinanceDepthDecoder::Result;
+            first_update_id = 0;
+            final_update_id = 0;
+
+            // Fields are visited in the order Binance sends them, so on-demand parsing
+            // makes a single forward pass over the frame.
+            bool is_depth_update = false;
+            for (auto field : object)
+            {
+                std::string_view key;
+                if (field.unescaped_key().get(key) != simdjson::SUCCESS)
+                    return Result::ERROR;
+                simdjson::ondemand::value value;
+                if (field.value().get(value) != simdjson::SUCCESS)
+                    return Result::ERROR;
+
+                if (key == "result" || key == "id")
+                {
+                    return Result::SUBSCRIPTION_ACK;
+                }
+                else if (key == "e")
+                {
+                    std::string_view event_type;
+                    if (value.get_string().get(event_type) != simdjson::SUCCESS || event_type != "depthUpdate")
+                        return Result::IGNORED;
+                    is_depth_update = true;
+                }
+                else if (key == "E")
+                {
+                    int64_t event_time;
+                    if (value.get_int64().get(event_time) != simdjson::SUCCESS)
+                        return Result::ERROR;
+                    book.timestamp = event_time;
+                }
+                else if (key == "s")
+                {
+                    std::string_view symbol;
+                    if (value.get_string().get(symbol) != simdjson::SUCCESS)
+                        return Result::ERROR;
+                    book.symbol.assign(symbol.data(), symbol.size());
+                }
+                else if (key == "U")
+                {
+                    if (value.get_int64().get(first_update_id) != simdjson::SUCCESS)
+                        return Result::ERROR;
+                }
+                else if (key == "u")
+                {
+                    if (value.get_int64().get(final_update_id) != simdjson::SUCCESS)
+                        return Result::ERROR;
+                }
+                else if (key == "b" || key == "a")
+                {
+                    if (!on_levels(value, key == "b"))
+                        return Result::ERROR;
+                }
+            }
+            return is_depth_update ? Result::DEPTH_UPDATE : Result::IGNORED;
+        }
+    }
+
+    void RawDepthUpdate::clear()
+    {
+        update_.bids.clear();
+        update_.asks.clear();
+        first_update_id_ = 0;
+        final_update_id_ = 0;
+        text_.clear();
+        bid_text_.clear();
+        ask_text_.clear();
+        decoded_ = false;
+    }
+
+    bool RawDepthUpdate::decode_side(const std::vector<LevelText> &text, const InstrumentSpec &spec, std::vector<OrderBookLevel> &levels) const
+    {
+        levels.clear();
+        levels.reserve(text.size());
+        for (const LevelText &level : text)
+        {
+            OrderBookLevel parsed{};
+            if (!spec.parse_price(std::string_view(text_).substr(level.price_offset, level.price_size), parsed.price) ||
+                !spec.parse_quantity(std::string_view(text_).substr(level.quantity_offset, level.quantity_size), parsed.quantity))
+                return false;
+            levels.push_back(parsed);
+        }
+        return true;
+    }
+
+    bool RawDepthUpdate::decode(const InstrumentSpec &spec)
+    {
+        if (decoded_)
+            return true;
+        if (!decode_side(bid_text_, spec, update_.bids) || !decode_side(ask_text_, spec, update_.asks))
+        {
+            update_.bids.clear();
+            update_.asks.clear();
+            return false;
+        }
+        decoded_ = true;
+        return true;
+    }
+
+    BinanceDepthDecoder::Result BinanceDepthDecoder::decode(const char *data, size_t size, size_t capacity, DepthUpdate &book)
+    {
+        book.bids.clear();
+        book.asks.clear();
+        first_update_id_ = 0;
+        final_update_id_ = 0;
+
+        simdjson::ondemand::document doc;
+        if (parser_.iterate(data, size, capacity).get(doc) != simdjson::SUCCESS)
+            return Result::ERROR;
+
+        simdjson::ondemand::object object;
+        if (doc.get_object().get(object) != simdjson::SUCCESS)
+            return Result::ERROR;
+
+        return decode_fields(object, spec_, book, first_update_id_, final_update_id_);
+    }
+
+    BinanceDepthDecoder::Result BinanceDepthDecoder::decode_fields(simdjson::ondemand::object &object, const InstrumentSpec &spec,
+                                                                   DepthUpdate &book, int64_t &first_update_id, int64_t &final_update_id)
+    {
+        book.bids.clear();
+        book.asks.clear();
+        return walk_fields(object, book, first_update_id, final_update_id,
+                           [&](simdjson::ondemand::value value, bool is_bid)
+                           { return decode_levels(value, spec, is_bid ? book.bids : book.asks); });
+    }
+
+    BinanceDepthDecoder::Result BinanceDepthDecoder::index_fields(simdjson::ondemand::object &object, RawDepthUpdate &update)
+    {
+        update.clear();
+        return walk_fields(object, update.update_, update.first_update_id_, update.final_update_id_,
+                           [&](simdjson::ondemand::value value, bool is_bid)
+                           { return index_levels(value, update.text_, is_bid ? update.bid_text_ : update.ask_text_); });
+    }
+
+    bool BinanceDepthDecoder::decode_snapshot(const char *data, size_t size, size_t capacity, DepthUpdate &book, int64_t &last_update_id)
+    {
+        book.bids.clear();
+        book.asks.clear();
+        last_update_id = -1;
+
+        simdjson::ondemand::document doc;
+        simdjson::ondemand::object object;
+        if (parser_.iterate(data, size, capacity).get(doc) != simdjson::SUCCESS ||
+            doc.get_object().get(object) != simdjson::SUCCESS)
+            return false;
+
+        for (auto field : object)
+        {
+            std::string_view key;
+            simdjson::ondemand::value value;
+            if (field.unescaped_key().get(key) != simdjson::SUCCESS || field.value().get(value) != simdjson::SUCCESS)
+                return false;
+
+            if (key == "lastUpdateId")
+            {
+                if (value.get_int64().get(last_update_id) != simdjson::SUCCESS)
+                    return false;
+            }
+            else if (key == "bids")
+            {
+                if (!decode_levels(value, spec_, book.bids))
+                    return false;
+            }
+            else if (key == "asks")
+            {
+                if (!decode_levels(value, spec_, book.asks))
+                    return false;
+            }
+        }
+        return last_update_id >= 0;
+    }
+
+} // namespace hft_system
@@ -0,0 +1,198 @@
+#include "../../include/data/BinanceStreamDecoder.h"
+
+namespace hft_system
+{
+
+    bool BinanceStreamDecoder::parse_kind(std::string_view name, StreamKind &kind)
+    {
+        size_t at = name.find('@');
+        if (at == std::string_view::npos || at == 0)
+            return false;
+        std::string_view type = name.substr(at + 1);
+        type = type.substr(0, type.find('@')); // "depth@100ms" is still a depth stream
+
+        if (type == "depth")
+            kind = StreamKind::DEPTH;
+        else if (type == "trade")
+            kind = StreamKind::TRADE;
+        else if (type == "bookTicker")
+            kind = StreamKind::BOOK_TICKER;
+        else
+            return false;
+        return true;
+    }
+
+    size_t BinanceStreamDecoder::add_stream(std::string_view name, const InstrumentSpec &spec)
+    {
+        StreamKind kind;
+        if (!parse_kind(name, kind))
+            return NO_STREAM;
+        auto it = index_.find(name);
+        if (it != index_.end())
+            return it->second;
+
+        streams_.push_back({std::string(name), kind, spec});
+        index_.emplace(streams_.back().name, streams_.size() - 1);
+        return streams_.size() - 1;
+    }
+
+    BinanceStreamDecoder::Result BinanceStreamDecoder::decode(const char *data, size_t size, size_t capacity)
+    {
+        stream_ = NO_STREAM;
+
+        simdjson::ondemand::document doc;
+        simdjson::ondemand::object object;
+        if (parser_.iterate(data, size, capacity).get(doc) != simdjson::SUCCESS ||
+            doc.get_object().get(object) != simdjson::SUCCESS)
+            return Result::ERROR;
+
+        for (auto field : object)
+        {
+            std::string_view key;
+            simdjson::ondemand::value value;
+            if (field.unescaped_key().get(key) != simdjson::SUCCESS || field.value().get(value) != simdjson::SUCCESS)
+                return Result::ERROR;
+
+            if (key == "result" || key == "id")
+            {
+                return Result::SUBSCRIPTION_ACK;
+            }
+            else if (key == "stream")
+            {
+                std::string_view name;
+                if (value.get_string().get(name) != simdjson::SUCCESS)
+                    return Result::ERROR;
+                auto it = index_.find(name);
+                if (it == index_.end())
+                    return Result::IGNORED;
+                stream_ = it->second;
+            }
+            else if (key == "data")
+            {
+                // Binance always sends the stream name first, which lets the
+                // payload be decoded in place without buffering it.
+                if (stream_ == NO_STREAM)
+                    return Result::ERROR;
+                simdjson::ondemand::object payload;
+                if (value.get_object().get(payload) != simdjson::SUCCESS)
+                    return Result::ERROR;
+                return decode_payload(payload, streams_[stream_]);
+            }
+        }
+        return Result::IGNORED;
+    }
+
+    BinanceStreamDecoder::Result BinanceStreamDecoder::decode_payload(simdjson::ondemand::object &payload, const Stream &stream)
+    {
+        switch (stream.kind)
+        {
+        case StreamKind::DEPTH:
+        {
+            depth_is_raw_ = stream.lazy_depth;
+            BinanceDepthDecoder::Result result;
+            if (depth_is_raw_)
+            {
+                result = BinanceDepthDecoder::index_fields(payload, raw_depth_);
+                first_update_id_ = raw_depth_.first_update_id();
+                final_update_id_ = raw_depth_.final_update_id();
+            }
+            else
+            {
+                result = BinanceDepthDecoder::decode_fields(payload, stream.spec, depth_, first_update_id_, final_update_id_);
+            }
+            switch (result)
+            {
+            case BinanceDepthDecoder::Result::DEPTH_UPDATE:
+                return Result::DEPTH_UPDATE;
+            case BinanceDepthDecoder::Result::ERROR:
+                return Result::ERROR;
+            default:
+                return Result::IGNORED;
+            }
+        }
+        case StreamKind::TRADE:
+            return decode_trade(payload, stream.spec) ? Result::TRADE : Result::ERROR;
+        case StreamKind::BOOK_TICKER:
+            return decode_book_ticker(payload, stream.spec) ? Result::BOOK_TICKER : Result::ERROR;
+        }
+        return Result::IGNORED;
+    }
+
+    bool BinanceStreamDecoder::decode_trade(simdjson::ondemand::object &payload, const InstrumentSpec &spec)
+    {
+        trade_ = TradeUpdate{};
+        bool has_price = false, has_quantity = false;
+        for (auto field : payload)
+        {
+            std::string_view key;
+            simdjson::ondemand::value value;
+            if (field.unescaped_key().get(key) != simdjson::SUCCESS || field.value().get(value) != simdjson::SUCCESS)
+                return false;
+
+            std::string_view text;
+            if (key == "t")
+            {
+                if (value.get_int64().get(trade_.trade_id) != simdjson::SUCCESS)
+                    return false;
+            }
+            else if (key == "T")
+            {
+                if (value.get_int64().get(trade_.trade_time) != simdjson::SUCCESS)
+                    return false;
+            }
+            else if (key == "p")
+            {
+                if (value.get_string().get(text) != simdjson::SUCCESS || !spec.parse_price(text, trade_.price))
+                    return false;
+                has_price = true;
+            }
+            else if (key == "q")
+            {
+                if (value.get_string().get(text) != simdjson::SUCCESS || !spec.parse_quantity(text, trade_.quantity))
+                    return false;
+                has_quantity = true;
+            }
+            else if (key == "m")
+            {
+                if (value.get_bool().get(trade_.buyer_is_maker) != simdjson::SUCCESS)
+                    return false;
+            }
+        }
+        return has_price && has_quantity;
+    }
+
+    bool BinanceStreamDecoder::decode_book_ticker(simdjson::ondemand::object &payload, const InstrumentSpec &spec)
+    {
+        book_ticker_ = BookTickerUpdate{};
+        int fields = 0;
+        for (auto field : payload)
+        {
+            std::string_view key;
+            simdjson::ondemand::value value;
+            if (field.unescaped_key().get(key) != simdjson::SUCCESS || field.value().get(value) != simdjson::SUCCESS)
+                return false;
+
+            if (key == "u")
+            {
+                if (value.get_int64().get(book_ticker_.update_id) != simdjson::SUCCESS)
+                    return false;
+                continue;
+            }
+            if (key.size() != 1 || (key[0] != 'b' && key[0] != 'B' && key[0] != 'a' && key[0] != 'A'))
+                continue;
+
+            std::string_view text;
+            if (value.get_string().get(text) != simdjson::SUCCESS)
+                return false;
+            bool ok = key[0] == 'b'   ? spec.parse_price(text, book_ticker_.bid_price)
+                      : key[0] == 'B' ? spec.parse_quantity(text, book_ticker_.bid_quantity)
+                      : key[0] == 'a' ? spec.parse_price(text, book_ticker_.ask_price)
+                                      : spec.parse_quantity(text, book_ticker_.ask_quantity);
+            if (!ok)
+                return false;
+            ++fields;
+        }
+        return fields == 4;
+    }
+
+} // namespace hft_system
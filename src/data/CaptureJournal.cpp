@@ -0,0 +1,365 @@
+#include "../../include/data/CaptureJournal.h"
+#include "../../include/core/Log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hft_system
+{
+    namespace
+    {
+        constexpr char MAGIC[8] = {'H', 'F', 'T', 'C', 'A', 'P', '0', '1'};
+        constexpr uint32_t VERSION = 1;
+        constexpr size_t SEGMENT_HEADER_BYTES = 32;
+        constexpr size_t RECORD_HEADER_BYTES = 16;
+        constexpr uint32_t WRAP_MARKER = 0xFFFFFFFFu; // Ring only: the rest of the ring is unused
+
+        constexpr size_t align8(size_t bytes) { return (bytes + 7) & ~size_t(7); }
+
+        struct RecordHeader
+        {
+            uint32_t size;
+            uint16_t kind;
+            uint16_t reserved;
+            int64_t receive_time;
+        };
+        static_assert(sizeof(RecordHeader) == RECORD_HEADER_BYTES);
+
+        size_t round_up_pow2(size_t bytes)
+        {
+            size_t capacity = 4096;
+            while (capacity < bytes)
+                capacity <<= 1;
+            return capacity;
+        }
+
+        // Indices of the <base>.NNNNNN segments on disk, ascending.
+        std::vector<uint32_t> find_segments(const std::string &base_path)
+        {
+            namespace fs = std::filesystem;
+            const fs::path base(base_path);
+            const fs::path directory = base.has_parent_path() ? base.parent_path() : fs::path(".");
+            const std::string prefix = base.filename().string() + ".";
+
+            std::vector<uint32_t> segments;
+            std::error_code ec;
+            for (const auto &entry : fs::directory_iterator(directory, ec))
+            {
+                const std::string name = entry.path().filename().string();
+                if (name.size() != prefix.size() + 6 || name.compare(0, prefix.size(), prefix) != 0)
+                    continue;
+                const std::string digits = name.substr(prefix.size());
+                if (std::all_of(digits.begin(), digits.end(), [](unsigned char c)
+                                { return std::isdigit(c); }))
+                    segments.push_back(static_cast<uint32_t>(std::stoul(digits)));
+            }
+            std::sort(segments.begin(), segments.end());
+            return segments;
+        }
+    }
+
+    // --- CaptureWriter ---
+
+    CaptureWriter::CaptureWriter(Options options)
+        : options_(std::move(options))
+    {
+        ring_capacity_ = round_up_pow2(options_.buffer_bytes);
+        ring_ = std::make_unique<char[]>(ring_capacity_);
+        options_.segment_bytes = std::max(options_.segment_bytes, size_t(1) << 16);
+    }
+
+    CaptureWriter::~CaptureWriter()
+    {
+        stop();
+    }
+
+    std::string CaptureWriter::segment_path(const std::string &base_path, uint32_t index)
+    {
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), ".%06u", index);
+        return base_path + suffix;
+    }
+
+    size_t CaptureWriter::remove_journal(const std::string &base_path)
+    {
+        size_t removed = 0;
+        for (uint32_t index : find_segments(base_path))
+        {
+            std::error_code ec;
+            removed += std::filesystem::remove(segment_path(base_path, index), ec) ? 1 : 0;
+        }
+        return removed;
+    }
+
+    bool CaptureWriter::start()
+    {
+        if (running_.load())
+            return true;
+        // Segments left by an earlier, longer capture would otherwise be read as this one's tail.
+        if (size_t stale = remove_journal(options_.base_path))
+            Log::get_logger()->info("CaptureWriter: removed {} segments of an earlier capture at {}.", stale, options_.base_path);
+        if (!open_segment(0))
+            return false;
+        running_.store(true);
+        writer_thread_ = std::thread(&CaptureWriter::writer_loop, this);
+        return true;
+    }
+
+    void CaptureWriter::stop()
+    {
+        running_.store(false);
+        if (writer_thread_.joinable())
+        {
+            writer_thread_.join();
+        }
+        close_segment();
+    }
+
+    bool CaptureWriter::append(CaptureRecord::Kind kind, int64_t receive_time, std::string_view data)
+    {
+        const size_t total = align8(RECORD_HEADER_BYTES + data.size());
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        const uint64_t tail = tail_.load(std::memory_order_acquire);
+        size_t position = head & (ring_capacity_ - 1);
+        const size_t contiguous = ring_capacity_ - position;
+        const size_t needed = total + (contiguous < total ? contiguous : 0);
+        if (total > ring_capacity_ / 2 || ring_capacity_ - (head - tail) < needed)
+        {
+            records_dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        uint64_t next_head = head;
+        if (contiguous < total)
+        {
+            // Records never straddle the end of the ring.
+            std::memcpy(ring_.get() + position, &WRAP_MARKER, sizeof(WRAP_MARKER));
+            next_head += contiguous;
+            position = 0;
+        }
+
+        RecordHeader header{static_cast<uint32_t>(data.size()), static_cast<uint16_t>(kind), 0, receive_time};
+        char *out = ring_.get() + position;
+        std::memcpy(out, &header, sizeof(header));
+        std::memcpy(out + RECORD_HEADER_BYTES, data.data(), data.size());
+        std::memset(out + RECORD_HEADER_BYTES + data.size(), 0, total - RECORD_HEADER_BYTES - data.size());
+        head_.store(next_head + total, std::memory_order_release);
+        return true;
+    }
+
+    void CaptureWriter::writer_loop()
+    {
+        while (running_.load(std::memory_order_relaxed))
+        {
+            if (!drain())
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        drain(); // Whatever the producer appended before stop()
+    }
+
+    bool CaptureWriter::drain()
+    {
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        const uint64_t head = head_.load(std::memory_order_acquire);
+        if (tail == head)
+            return false;
+
+        while (tail != head)
+        {
+            const size_t position = tail & (ring_capacity_ - 1);
+            const char *record = ring_.get() + position;
+            uint32_t size;
+            std::memcpy(&size, record, sizeof(size));
+            if (size == WRAP_MARKER)
+            {
+                tail += ring_capacity_ - position;
+                continue;
+            }
+            const size_t total = align8(RECORD_HEADER_BYTES + size);
+            if (write_record(record, total))
+                records_written_.fetch_add(1, std::memory_order_relaxed);
+            else
+                records_dropped_.fetch_add(1, std::memory_order_relaxed);
+            tail += total;
+            tail_.store(tail, std::memory_order_release);
+        }
+        tail_.store(tail, std::memory_order_release);
+        return true;
+    }
+
+    bool CaptureWriter::write_record(const char *record, size_t record_bytes)
+    {
+        if (!map_)
+            return false;
+        if (SEGMENT_HEADER_BYTES + record_bytes > map_bytes_)
+        {
+            Log::get_logger()->warn("CaptureWriter: {}-byte record does not fit in a segment; dropped.", record_bytes);
+            return false;
+        }
+        if (offset_ + record_bytes > map_bytes_)
+        {
+            close_segment();
+            if (!open_segment(segment_index_ + 1))
+                return false;
+        }
+        std::memcpy(map_ + offset_, record, record_bytes);
+        offset_ += record_bytes;
+        return true;
+    }
+
+    bool CaptureWriter::open_segment(uint32_t index)
+    {
+        const std::string path = segment_path(options_.base_path, index);
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0)
+        {
+            Log::get_logger()->error("CaptureWriter: cannot create {}", path);
+            return false;
+        }
+        // Reserve the blocks up front so appends never wait on the filesystem allocating them.
+        if (::posix_fallocate(fd_, 0, static_cast<off_t>(options_.segment_bytes)) != 0 &&
+            ::ftruncate(fd_, static_cast<off_t>(options_.segment_bytes)) != 0)
+        {
+            Log::get_logger()->error("CaptureWriter: cannot size {}", path);
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        void *map = ::mmap(nullptr, options_.segment_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (map == MAP_FAILED)
+        {
+            Log::get_logger()->error("CaptureWriter: cannot map {}", path);
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+
+        map_ = static_cast<char *>(map);
+        map_bytes_ = options_.segment_bytes;
+        segment_index_ = index;
+        segments_opened_.fetch_add(1, std::memory_order_relaxed);
+
+        std::memcpy(map_, MAGIC, sizeof(MAGIC));
+        std::memcpy(map_ + 8, &VERSION, sizeof(VERSION));
+        std::memcpy(map_ + 12, &index, sizeof(index));
+        int64_t created = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::system_clock::now().time_since_epoch())
+                              .count();
+        std::memcpy(map_ + 16, &created, sizeof(created));
+        offset_ = SEGMENT_HEADER_BYTES;
+
+        if (options_.max_segments != 0 && index >= options_.max_segments)
+        {
+            std::error_code ec;
+            std::filesystem::remove(segment_path(options_.base_path, index - static_cast<uint32_t>(options_.max_segments)), ec);
+        }
+        return true;
+    }
+
+    void CaptureWriter::close_segment()
+    {
+        if (map_)
+        {
+            ::munmap(map_, map_bytes_);
+            map_ = nullptr;
+        }
+        if (fd_ >= 0)
+        {
+            // Give back the unused preallocation.
+            if (::ftruncate(fd_, static_cast<off_t>(offset_)) != 0)
+                Log::get_logger()->warn("CaptureWriter: cannot trim segment {}", segment_index_);
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    // --- CaptureReader ---
+
+    CaptureReader::CaptureReader(std::string base_path)
+        : base_path_(std::move(base_path)) {}
+
+    CaptureReader::~CaptureReader()
+    {
+        unmap_segment();
+    }
+
+    bool CaptureReader::open()
+    {
+        segments_ = find_segments(base_path_);
+        current_ = 0;
+        return !segments_.empty() && map_segment(0);
+    }
+
+    bool CaptureReader::map_segment(size_t position)
+    {
+        unmap_segment();
+        for (current_ = position; current_ < segments_.size(); ++current_)
+        {
+            const std::string path = CaptureWriter::segment_path(base_path_, segments_[current_]);
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                continue;
+            struct stat st;
+            void *map = MAP_FAILED;
+            if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= SEGMENT_HEADER_BYTES)
+                map = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (map == MAP_FAILED)
+                continue;
+
+            map_ = static_cast<const char *>(map);
+            map_bytes_ = static_cast<size_t>(st.st_size);
+            if (std::memcmp(map_, MAGIC, sizeof(MAGIC)) != 0)
+            {
+                Log::get_logger()->warn("CaptureReader: {} is not a capture segment; skipped.", path);
+                unmap_segment();
+                continue;
+            }
+            ::madvise(const_cast<char *>(map_), map_bytes_, MADV_SEQUENTIAL);
+            offset_ = SEGMENT_HEADER_BYTES;
+            return true;
+        }
+        return false;
+    }
+
+    void CaptureReader::unmap_segment()
+    {
+        if (map_)
+        {
+            ::munmap(const_cast<char *>(map_), map_bytes_);
+            map_ = nullptr;
+            map_bytes_ = 0;
+        }
+    }
+
+    bool CaptureReader::next(CaptureRecord &record)
+    {
+        while (map_)
+        {
+            RecordHeader header{};
+            if (offset_ + RECORD_HEADER_BYTES <= map_bytes_)
+                std::memcpy(&header, map_ + offset_, sizeof(header));
+            const size_t total = align8(RECORD_HEADER_BYTES + header.size);
+            if (header.kind == 0 || offset_ + total > map_bytes_)
+            {
+                // End of this segment (or a record cut short by a crash): move on.
+                if (!map_segment(current_ + 1))
+                    return false;
+                continue;
+            }
+            record.kind = static_cast<CaptureRecord::Kind>(header.kind);
+            record.receive_time = header.receive_time;
+            record.data = std::string_view(map_ + offset_ + RECORD_HEADER_BYTES, header.size);
+            offset_ += total;
+            return true;
+        }
+        return false;
+    }
+
+} // namespace hft_system
@@ -0,0 +1,183 @@
+#include "../../include/data/CaptureReplayHandler.h"
+#include "../../include/core/Log.h"
+#include <chrono>
+#include <cstring>
+
+namespace hft_system
+{
+    CaptureReplayHandler::CaptureReplayHandler(std::shared_ptr<EventBus> event_bus, std::string base_path, size_t book_depth)
+        : DataHandler(event_bus, "CaptureReplayHandler"),
+          base_path_(std::move(base_path)),
+          book_depth_(book_depth),
+          is_running_(false) {}
+
+    CaptureReplayHandler::~CaptureReplayHandler()
+    {
+        if (is_running_.load())
+        {
+            stop();
+        }
+    }
+
+    void CaptureReplayHandler::start()
+    {
+        is_running_.store(true);
+        data_thread_ = std::thread(&CaptureReplayHandler::run, this);
+    }
+
+    void CaptureReplayHandler::stop()
+    {
+        is_running_.store(false);
+        if (data_thread_.joinable())
+        {
+            data_thread_.join();
+        }
+    }
+
+    bool CaptureReplayHandler::open_journals()
+    {
+        journals_.clear();
+        for (size_t index = 0;; ++index)
+        {
+            auto reader = std::make_unique<CaptureReader>(base_path_ + "." + std::to_string(index));
+            if (!reader->open())
+                break;
+            journals_.push_back({std::move(reader), nullptr, {}, false});
+        }
+        if (journals_.empty())
+        {
+            auto reader = std::make_unique<CaptureReader>(base_path_);
+            if (reader->open())
+                journals_.push_back({std::move(reader), nullptr, {}, false});
+        }
+
+        for (auto &journal : journals_)
+        {
+            // Snapshots come from the journal's own SNAPSHOT records, in the order they were applied live.
+            journal.processor = std::make_unique<StreamProcessor>(event_bus_, book_depth_, [](StreamProcessor::Feed &) {});
+            journal.has_record = journal.reader->next(journal.record);
+        }
+        return !journals_.empty();
+    }
+
+    void CaptureReplayHandler::run()
+    {
+        Log::get_logger()->info("CaptureReplayHandler thread started for {}.", base_path_);
+        if (!open_journals())
+        {
+            Log::get_logger()->error("No capture journal found at {}", base_path_);
+            // Still signal completion so a waiting backtest does not hang.
+            event_bus_->publish(std::make_shared<Event>(EventType::SYSTEM));
+            return;
+        }
+
+        const auto wall_start = std::chrono::steady_clock::now();
+        int64_t first_receive_time = 0;
+        bool first = true;
+        while (is_running_.load())
+        {
+            // Merge the connections' journals by receive time.
+            Journal *next = nullptr;
+            for (auto &journal : journals_)
+            {
+                if (journal.has_record && (!next || journal.record.receive_time < next->record.receive_time))
+                    next = &journal;
+            }
+            if (!next)
+                break;
+
+            if (first)
+            {
+                first_receive_time = next->record.receive_time;
+                first = false;
+            }
+            if (replay_speed_ > 0.0)
+            {
+                auto offset = std::chrono::nanoseconds(static_cast<int64_t>(
+                    (next->record.receive_time - first_receive_time) / replay_speed_));
+                std::this_thread::sleep_until(wall_start + offset);
+            }
+
+            replay_record(*next);
+            records_replayed_.fetch_add(1, std::memory_order_relaxed);
+            next->has_record = next->reader->next(next->record);
+        }
+        replay_seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+        Log::get_logger()->info("CaptureReplayHandler finished {}: {} records from {} journals in {:.3f} s.",
+                                base_path_, records_replayed(), journals_.size(), replay_seconds_);
+        for (const auto &[stream, stats] : get_stream_statistics())
+        {
+            Log::get_logger()->info("  {}: {} messages, parse avg {:.0f} ns, max {:.0f} ns",
+                                    stream, static_cast<long>(stats.at("messages")),
+                                    stats.at("avg_parse_ns"), stats.at("max_parse_ns"));
+        }
+
+        // Signal system completion
+        event_bus_->publish(std::make_shared<Event>(EventType::SYSTEM));
+    }
+
+    void CaptureReplayHandler::replay_record(Journal &journal)
+    {
+        const CaptureRecord &record = journal.record;
+        StreamProcessor &processor = *journal.processor;
+        switch (record.kind)
+        {
+        case CaptureRecord::Kind::FRAME:
+        {
+            // The mapped record is not followed by simdjson's padding, so parse a padded copy.
+            const size_t capacity = BinanceStreamDecoder::padded_capacity(record.data.size());
+            if (frame_.size() < capacity)
+                frame_.resize(capacity);
+            std::memcpy(frame_.data(), record.data.data(), record.data.size());
+            std::memset(frame_.data() + record.data.size(), 0, capacity - record.data.size());
+            processor.process_frame(frame_.data(), record.data.size(), capacity);
+            return;
+        }
+        case CaptureRecord::Kind::SNAPSHOT:
+        {
+            size_t separator = record.data.find('\0');
+            if (separator == std::string_view::npos)
+                return;
+            StreamProcessor::Feed *feed = processor.find_feed(record.data.substr(0, separator));
+            if (feed)
+                processor.on_snapshot(*feed, std::string(record.data.substr(separator + 1)));
+            return;
+        }
+        case CaptureRecord::Kind::SUBSCRIBE:
+        {
+            // A later subscription is a reconnect: the live handler dropped its books at that point too.
+            if (processor.stream_count() > 0)
+                processor.reset();
+            simdjson::ondemand::parser parser;
+            simdjson::padded_string message(record.data);
+            simdjson::ondemand::document doc;
+            simdjson::ondemand::array params;
+            if (parser.iterate(message).get(doc) != simdjson::SUCCESS || doc["params"].get_array().get(params) != simdjson::SUCCESS)
+            {
+                Log::get_logger()->error("Unreadable subscription in capture: {}", record.data);
+                return;
+            }
+            for (auto param : params)
+            {
+                std::string_view name;
+                if (param.get_string().get(name) == simdjson::SUCCESS && !processor.add_stream(name))
+                    Log::get_logger()->error("Ignoring unsupported stream {}", name);
+            }
+            return;
+        }
+        }
+    }
+
+    std::map<std::string, std::map<std::string, double>> CaptureReplayHandler::get_stream_statistics() const
+    {
+        std::map<std::string, std::map<std::string, double>> results;
+        for (const auto &journal : journals_)
+        {
+            if (journal.processor)
+                journal.processor->collect_statistics(replay_seconds_, results);
+        }
+        return results;
+    }
+
+} // namespace hft_system
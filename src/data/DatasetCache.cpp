@@ -0,0 +1,141 @@
+#include "../../include/data/DatasetCache.h"
+#include "../../include/data/HistoricCSVDataHandler.h"
+#include "../../include/data/PrefetchReader.h"
+#include "../../include/data/TimeIndex.h"
+#include "../../include/core/Log.h"
+#include "../../include/utils/Timer.h"
+#include <limits>
+#include <string_view>
+
+namespace hft_system
+{
+    DatasetCache &DatasetCache::get_instance()
+    {
+        static DatasetCache instance;
+        return instance;
+    }
+
+    std::shared_ptr<const Dataset> DatasetCache::acquire(const std::string &file_path, int64_t start, int64_t end)
+    {
+        std::shared_ptr<Entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto &slot = entries_[Key{file_path, start, end}];
+            if (!slot)
+            {
+                slot = std::make_shared<Entry>();
+            }
+            entry = slot;
+        }
+
+        // Only callers of the same key serialise here; other files load in parallel.
+        std::lock_guard<std::mutex> load_lock(entry->load_mutex);
+        if (auto dataset = entry->dataset.lock())
+        {
+            return dataset;
+        }
+
+        auto dataset = load(file_path, start, end);
+        if (dataset)
+        {
+            entry->dataset = dataset;
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++load_count_;
+        }
+        return dataset;
+    }
+
+    size_t DatasetCache::load_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return load_count_;
+    }
+
+    std::shared_ptr<const Dataset> DatasetCache::load(const std::string &file_path, int64_t start, int64_t end)
+    {
+        Timer load_timer;
+        auto dataset = std::make_shared<Dataset>();
+        dataset->file_path = file_path;
+        dataset->start_time = start;
+        dataset->end_time = end;
+
+        int64_t start_offset = 0;
+        bool sorted = false; // Only a sorted file can stop at the first row past `end`
+        if (start != std::numeric_limits<int64_t>::min() || end != std::numeric_limits<int64_t>::max())
+        {
+            try
+            {
+                const TimeIndex index = TimeIndex::load_or_build(file_path);
+                sorted = index.is_sorted();
+                if (start != std::numeric_limits<int64_t>::min())
+                    start_offset = index.seek(start);
+            }
+            catch (const std::exception &e)
+            {
+                Log::get_logger()->warn("DatasetCache: time index unavailable ({}); scanning {} from the start.", e.what(), file_path);
+            }
+        }
+
+        PrefetchReader reader(file_path);
+        if (!reader.start(start_offset))
+        {
+            Log::get_logger()->error("DatasetCache: failed to open file: {}", file_path);
+            return nullptr;
+        }
+
+        bool header_skipped = start_offset > 0;
+        long line_number = 0;
+        Bar bar;
+        reader.for_each_line([&](std::string_view line, int64_t)
+                             {
+            ++line_number;
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (line.empty())
+                return true;
+            if (!header_skipped)
+            {
+                header_skipped = true;
+                return true;
+            }
+            try
+            {
+                if (!HistoricCSVDataHandler::parse_row(line, bar))
+                {
+                    Log::get_logger()->error("DatasetCache: line {}: Not enough fields: {}", line_number, line);
+                    return true;
+                }
+            }
+            catch (const std::exception &e)
+            {
+                Log::get_logger()->error("DatasetCache: line {}: Failed to parse line: '{}'. Error: {}", line_number, line, e.what());
+                return true;
+            }
+            if (bar.timestamp < start)
+                return true;
+            if (bar.timestamp >= end)
+                return !sorted;
+
+            dataset->timestamps.push_back(bar.timestamp);
+            dataset->open.push_back(bar.open);
+            dataset->high.push_back(bar.high);
+            dataset->low.push_back(bar.low);
+            dataset->close.push_back(bar.close);
+            dataset->volume.push_back(bar.volume);
+            return true; });
+        reader.stop();
+
+        dataset->timestamps.shrink_to_fit();
+        dataset->open.shrink_to_fit();
+        dataset->high.shrink_to_fit();
+        dataset->low.shrink_to_fit();
+        dataset->close.shrink_to_fit();
+        dataset->volume.shrink_to_fit();
+
+        Log::get_logger()->info("DatasetCache: loaded {} rows ({:.1f} KiB) from {} in {:.2f} ms.",
+                                dataset->size(), dataset->memory_bytes() / 1024.0, file_path,
+                                load_timer.elapsed_nanoseconds() / 1e6);
+        return dataset;
+    }
+
+} // namespace hft_system
@@ -0,0 +1,84 @@
+#include "../../include/data/DatasetReplayHandler.h"
+#include "../../include/core/Log.h"
+#include "../../include/core/SymbolRegistry.h"
+#include "../../include/utils/PerformanceMonitor.h"
+#include "../../include/utils/Timer.h"
+#include <algorithm>
+#include <vector>
+
+namespace hft_system
+{
+    DatasetReplayHandler::DatasetReplayHandler(std::shared_ptr<EventBus> event_bus, std::string symbol, std::shared_ptr<const Dataset> dataset)
+        : DataHandler(event_bus, "DatasetReplayHandler"),
+          symbol_(std::move(symbol)),
+          symbol_id_(intern_symbol(symbol_)),
+          dataset_(std::move(dataset)),
+          is_running_(false) {}
+
+    DatasetReplayHandler::~DatasetReplayHandler()
+    {
+        if (is_running_.load())
+        {
+            stop();
+        }
+    }
+
+    void DatasetReplayHandler::start()
+    {
+        is_running_.store(true);
+        data_thread_ = std::thread(&DatasetReplayHandler::run, this);
+    }
+
+    void DatasetReplayHandler::stop()
+    {
+        is_running_.store(false);
+        if (data_thread_.joinable())
+        {
+            data_thread_.join();
+        }
+    }
+
+    void DatasetReplayHandler::run()
+    {
+        constexpr size_t BATCH_SIZE = 1024;
+        const size_t rows = dataset_ ? dataset_->size() : 0;
+        Log::get_logger()->info("DatasetReplayHandler started for symbol {}: replaying {} cached rows.", symbol_, rows);
+
+        Timer replay_timer;
+        const double *close = dataset_ ? dataset_->close.data() : nullptr;
+        const double *volume = dataset_ ? dataset_->volume.data() : nullptr;
+        const int64_t *timestamps = dataset_ ? dataset_->timestamps.data() : nullptr;
+        if (replay_delay_.count() > 0 || lockstep_)
+        {
+            // Throttled replay: give the rest of the system time to react to each tick.
+            for (size_t i = 0; i < rows && is_running_.load(); ++i)
+            {
+                event_bus_->publish(std::make_shared<MarketEvent>(symbol_id_, close[i], timestamps[i] * 1000000000LL, volume[i]));
+                pace(replay_delay_);
+            }
+        }
+        else
+        {
+            std::vector<std::shared_ptr<Event>> batch;
+            for (size_t begin = 0; begin < rows && is_running_.load(); begin += BATCH_SIZE)
+            {
+                size_t end = std::min(rows, begin + BATCH_SIZE);
+                batch.reserve(end - begin);
+                for (size_t i = begin; i < end; ++i)
+                {
+                    batch.push_back(std::make_shared<MarketEvent>(symbol_id_, close[i], timestamps[i] * 1000000000LL, volume[i]));
+                }
+                event_bus_->publish_batch(std::move(batch));
+                batch = std::vector<std::shared_ptr<Event>>();
+            }
+        }
+        PerformanceMonitor::get_instance().record_metric("DatasetReplayHandler_replay", replay_timer.elapsed_nanoseconds());
+
+        Log::get_logger()->info("DatasetReplayHandler finished replaying {} rows for {}.", rows, symbol_);
+
+        // Signal system completion
+        auto system_event = std::make_shared<Event>(EventType::SYSTEM);
+        event_bus_->publish(system_event);
+    }
+
+} // namespace hft_system
@@ -1,20 +1,23 @@
 #include "../../include/data/HistoricCSVDataHandler.h"
+#include "../../include/data/TimeIndex.h"
 #include "../../include/core/Log.h"
+#include "../../include/core/SymbolRegistry.h"
 #include "../../include/utils/Timer.h"
 #include "../../include/utils/PerformanceMonitor.h"
 #include "simdjson.h"
-#include <fstream>
 #include <string>
-#include <sstream>
 #include <vector>
+#include <cstring>
 
 namespace hft_system
 {
     HistoricCSVDataHandler::HistoricCSVDataHandler(std::shared_ptr<EventBus> event_bus, std::string symbol, std::string file_path)
         : DataHandler(event_bus, "HistoricCSVDataHandler"),
           symbol_(std::move(symbol)),
+          symbol_id_(intern_symbol(symbol_)),
           file_path_(std::move(file_path)),
-          is_running_(false) {}
+          is_running_(false),
+          reader_(std::make_unique<PrefetchReader>(file_path_)) {}
 
     HistoricCSVDataHandler::~HistoricCSVDataHandler()
     {
@@ -40,7 +43,7 @@ namespace hft_system
     }
 
     // Add a CSV parsing function that handles quotes properly
-    std::vector<std::string> parse_csv_line(const std::string &line)
+    std::vector<std::string> parse_csv_line(std::string_view line)
     {
         std::vector<std::string> fields;
         std::string field;
@@ -78,77 +81,262 @@ namespace hft_system
         return fields;
     }
 
+    void HistoricCSVDataHandler::set_time_range(int64_t start, int64_t end)
+    {
+        start_time_ = start;
+        end_time_ = end;
+    }
+
+    std::map<std::string, std::map<std::string, double>> HistoricCSVDataHandler::get_stage_statistics() const
+    {
+        return {
+            {"io", reader_->stats().to_map()},
+            {"parse", parse_stats_.to_map()},
+            {"publish", publish_stats_.to_map()}};
+    }
+
     void HistoricCSVDataHandler::run()
     {
         Log::get_logger()->info("DataHandler thread started for symbol {} from file {}.", symbol_, file_path_);
 
-        std::ifstream file(file_path_);
-        if (!file.is_open())
+        int64_t start_offset = 0;
+        if (start_time_ != std::numeric_limits<int64_t>::min() || end_time_ != std::numeric_limits<int64_t>::max())
+        {
+            try
+            {
+                const TimeIndex index = TimeIndex::load_or_build(file_path_);
+                // Only a sorted file can stop at the first row past the range.
+                sorted_ = index.is_sorted();
+                if (start_time_ != std::numeric_limits<int64_t>::min())
+                {
+                    start_offset = index.seek(start_time_);
+                    // Seeking always lands on a data row, past the header.
+                    header_skipped_ = start_offset > 0;
+                    Log::get_logger()->info("Seeking to byte {} for time range [{}, {}).", start_offset, start_time_, end_time_);
+                }
+            }
+            catch (const std::exception &e)
+            {
+                Log::get_logger()->warn("Time index unavailable ({}); scanning {} from the start.", e.what(), file_path_);
+            }
+        }
+
+        if (!reader_->start(start_offset))
         {
             Log::get_logger()->error("Failed to open file: {}", file_path_);
+            // Still signal completion so a waiting backtest does not hang.
+            event_bus_->publish(std::make_shared<Event>(EventType::SYSTEM));
             return;
         }
 
-        std::string line;
-        int line_number = 0;
-        bool header_skipped = false;
+        // A few batches of slack lets parsing run ahead of a throttled publisher.
+        BoundedQueue<EventBatch> batches(4);
+        std::thread publisher(&HistoricCSVDataHandler::publish_stage, this, std::ref(batches));
 
-        while (is_running_.load() && std::getline(file, line))
+        parse_stage(batches);
+        batches.close();
+        publisher.join();
+        reader_->stop();
+
+        Log::get_logger()->info("DataHandler finished processing file: {}. Processed {} lines.",
+                                file_path_, line_number_);
+        for (const auto &[stage, stats] : get_stage_statistics())
         {
-            ++line_number;
+            Log::get_logger()->info("  {} stage: utilisation {:.1f}%, busy {:.2f} ms, wait {:.2f} ms, items {}",
+                                    stage, stats.at("utilisation_pct"), stats.at("busy_ms"),
+                                    stats.at("wait_ms"), static_cast<long>(stats.at("items")));
+        }
 
-            if (line.empty())
+        // Signal system completion
+        auto system_event = std::make_shared<Event>(EventType::SYSTEM);
+        event_bus_->publish(system_event);
+    }
+
+    void HistoricCSVDataHandler::parse_stage(BoundedQueue<EventBatch> &batches)
+    {
+        constexpr size_t BATCH_SIZE = 1024;
+
+        std::string carry; // Partial line spanning two blocks
+        EventBatch batch;
+        batch.reserve(BATCH_SIZE);
+
+        auto flush = [&]()
+        {
+            if (batch.empty())
+                return true;
+            Timer wait_timer;
+            bool accepted = batches.push(std::move(batch));
+            parse_stats_.add_wait(wait_timer.elapsed_nanoseconds());
+            batch = EventBatch();
+            batch.reserve(BATCH_SIZE);
+            return accepted;
+        };
+
+        PrefetchReader::Block block;
+        while (is_running_.load())
+        {
+            Timer wait_timer;
+            if (!reader_->acquire(block))
+                break;
+            parse_stats_.add_wait(wait_timer.elapsed_nanoseconds());
+
+            Timer busy_timer;
+            const char *cursor = block.data;
+            const char *end = block.data + block.size;
+            bool keep_going = true;
+            while (cursor < end && keep_going)
             {
-                continue; // Skip empty lines
+                const char *newline = static_cast<const char *>(std::memchr(cursor, '\n', end - cursor));
+                if (!newline)
+                {
+                    carry.append(cursor, end);
+                    break;
+                }
+                bool in_range;
+                if (!carry.empty())
+                {
+                    carry.append(cursor, newline);
+                    in_range = parse_line(carry, batch);
+                    carry.clear();
+                }
+                else
+                {
+                    in_range = parse_line(std::string_view(cursor, newline - cursor), batch);
+                }
+                cursor = newline + 1;
+
+                if (!in_range)
+                {
+                    keep_going = false;
+                }
+                else if (batch.size() >= BATCH_SIZE)
+                {
+                    int64_t busy = busy_timer.elapsed_nanoseconds();
+                    keep_going = flush();
+                    busy_timer.restart();
+                    parse_stats_.add_busy(busy);
+                }
             }
+            reader_->release(block);
 
-            if (!header_skipped)
+            int64_t busy = busy_timer.elapsed_nanoseconds();
+            parse_stats_.add_busy(busy);
+            parse_stats_.add_item(static_cast<int64_t>(block.size));
+            PerformanceMonitor::get_instance().record_metric("HistoricCSVDataHandler_parse_block", busy);
+
+            if (!keep_going)
+                break;
+            if (!flush())
+                return;
+        }
+
+        // The last line of a file does not need a trailing newline.
+        if (!carry.empty() && is_running_.load())
+        {
+            parse_line(carry, batch);
+        }
+        flush();
+    }
+
+    bool HistoricCSVDataHandler::parse_line(std::string_view line, EventBatch &batch)
+    {
+        ++line_number_;
+
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+
+        if (line.empty())
+        {
+            return true; // Skip empty lines
+        }
+
+        if (!header_skipped_)
+        {
+            header_skipped_ = true;
+            return true; // Skip header row
+        }
+
+        try
+        {
+            Bar bar;
+            if (!parse_row(line, bar))
             {
-                header_skipped = true;
-                continue; // Skip header row
+                Log::get_logger()->error("Line {}: Not enough fields: {}", line_number_, line);
+                return true;
             }
 
-            try
-            {
-                TIME_FUNCTION("HistoricCSVDataHandler_process_line");
+            if (bar.timestamp < start_time_)
+                return true;
+            if (bar.timestamp >= end_time_)
+                return !sorted_;
 
-                auto fields = parse_csv_line(line);
+            // File timestamps are epoch seconds.
+            batch.push_back(std::make_shared<MarketEvent>(symbol_id_, bar.close, bar.timestamp * 1000000000LL, bar.volume));
+        }
+        catch (const std::exception &e)
+        {
+            Log::get_logger()->error("Line {}: Failed to parse line: '{}'. Error: {}",
+                                     line_number_, line, e.what());
+        }
+        return true;
+    }
 
-                if (fields.size() < 6)
-                {
-                    Log::get_logger()->error("Line {}: Not enough fields: {}", line_number, line);
-                    continue;
-                }
+    bool HistoricCSVDataHandler::parse_row(std::string_view line, Bar &bar)
+    {
+        auto fields = parse_csv_line(line);
+        if (fields.size() < 6)
+            return false;
 
-                // Process the fields and create a market event
-                long timestamp = std::stol(fields[0]);
-                double open = std::stod(fields[1]);
-                double high = std::stod(fields[2]);
-                double low = std::stod(fields[3]);
-                double close = std::stod(fields[4]);
-                double volume = std::stod(fields[5]);
+        bar.timestamp = std::stoll(fields[0]);
+        bar.open = std::stod(fields[1]);
+        bar.high = std::stod(fields[2]);
+        bar.low = std::stod(fields[3]);
+        bar.close = std::stod(fields[4]);
+        bar.volume = std::stod(fields[5]);
+        return true;
+    }
 
-                auto market_event = std::make_shared<MarketEvent>(symbol_, close);
+    void HistoricCSVDataHandler::publish_stage(BoundedQueue<EventBatch> &batches)
+    {
+        EventBatch batch;
+        while (true)
+        {
+            Timer wait_timer;
+            if (!batches.pop(batch))
+                break;
+            publish_stats_.add_wait(wait_timer.elapsed_nanoseconds());
 
-                event_bus_->publish(market_event);
+            Timer busy_timer;
+            size_t batch_size = batch.size();
+            if (replay_delay_.count() > 0 || lockstep_)
+            {
+                // Throttled replay: give the rest of the system time to react to each tick.
+                for (auto &event : batch)
+                {
+                    if (!is_running_.load())
+                        break;
+                    event_bus_->publish(std::move(event));
+                    pace(replay_delay_);
+                }
             }
-            catch (const std::exception &e)
+            else
             {
-                Log::get_logger()->error("Line {}: Failed to parse line: '{}'. Error: {}",
-                                         line_number, line, e.what());
-                continue;
+                event_bus_->publish_batch(std::move(batch));
             }
+            batch = EventBatch();
 
-            // Add a small delay to prevent overwhelming the system
-            std::this_thread::sleep_for(std::chrono::microseconds(100));
-        }
-
-        Log::get_logger()->info("DataHandler finished processing file: {}. Processed {} lines.",
-                                file_path_, line_number);
+            int64_t busy = busy_timer.elapsed_nanoseconds();
+            publish_stats_.add_busy(busy);
+            publish_stats_.add_item(static_cast<int64_t>(batch_size));
+            PerformanceMonitor::get_instance().record_metric("HistoricCSVDataHandler_publish_batch", busy);
 
-        // Signal system completion
-        auto system_event = std::make_shared<Event>(EventType::SYSTEM);
-        event_bus_->publish(system_event);
+            if (!is_running_.load())
+                break;
+        }
+        // Unblocks the parse stage if we stopped early.
+        batches.close();
     }
 
-} // namespace hft_system
\ No newline at end of file
+} // namespace hft_system
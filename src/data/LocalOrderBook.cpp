@@ -0,0 +1,108 @@
+#include "../../include/data/LocalOrderBook.h"
+#include "../../include/core/SymbolRegistry.h"
+#include <algorithm>
+#include <functional>
+
+namespace hft_system
+{
+    namespace
+    {
+        // `Worse` orders levels from worst to best, so the best level ends up at the back.
+        template <typename Worse>
+        void update_level(std::vector<OrderBookLevel> &side, const OrderBookLevel &level, Worse worse)
+        {
+            auto it = std::lower_bound(side.begin(), side.end(), level.price,
+                                       [&](const OrderBookLevel &existing, Price price)
+                                       { return worse(existing.price, price); });
+            bool found = it != side.end() && it->price == level.price;
+            if (level.quantity.value <= 0)
+            {
+                if (found)
+                    side.erase(it);
+            }
+            else if (found)
+            {
+                it->quantity = level.quantity;
+            }
+            else
+            {
+                side.insert(it, level);
+            }
+        }
+
+        template <typename Worse>
+        void load_side(std::vector<OrderBookLevel> &side, const std::vector<OrderBookLevel> &levels, Worse worse)
+        {
+            side.clear();
+            for (const auto &level : levels)
+            {
+                if (level.quantity.value > 0)
+                    side.push_back(level);
+            }
+            std::sort(side.begin(), side.end(), [&](const OrderBookLevel &a, const OrderBookLevel &b)
+                      { return worse(a.price, b.price); });
+        }
+    }
+
+    LocalOrderBook::LocalOrderBook(std::string symbol) : symbol_(std::move(symbol))
+    {
+        if (!symbol_.empty())
+            symbol_id_ = intern_symbol(symbol_);
+    }
+
+    void LocalOrderBook::apply_snapshot(const DepthUpdate &snapshot, int64_t last_update_id)
+    {
+        if (!snapshot.symbol.empty() && snapshot.symbol != symbol_)
+        {
+            symbol_ = snapshot.symbol;
+            symbol_id_ = intern_symbol(symbol_);
+        }
+        load_side(bids_, snapshot.bids, std::less<Price>());
+        load_side(asks_, snapshot.asks, std::greater<Price>());
+        last_update_id_ = last_update_id;
+        timestamp_ = snapshot.timestamp;
+        synced_ = true;
+        applied_since_snapshot_ = false;
+    }
+
+    LocalOrderBook::ApplyResult LocalOrderBook::apply_diff(const DepthUpdate &diff, int64_t first_update_id, int64_t final_update_id)
+    {
+        if (!synced_)
+            return ApplyResult::NOT_SYNCED;
+        if (final_update_id <= last_update_id_)
+            return ApplyResult::STALE;
+
+        // The first diff after a snapshot only has to straddle it; after that ids must be contiguous.
+        bool contiguous = applied_since_snapshot_ ? first_update_id == last_update_id_ + 1
+                                                  : first_update_id <= last_update_id_ + 1;
+        if (!contiguous)
+        {
+            synced_ = false;
+            return ApplyResult::GAP;
+        }
+
+        for (const auto &level : diff.bids)
+            update_level(bids_, level, std::less<Price>());
+        for (const auto &level : diff.asks)
+            update_level(asks_, level, std::greater<Price>());
+
+        last_update_id_ = final_update_id;
+        timestamp_ = diff.timestamp;
+        applied_since_snapshot_ = true;
+        return ApplyResult::APPLIED;
+    }
+
+    void LocalOrderBook::top_n(size_t depth, OrderBook &out) const
+    {
+        out.symbol_id = symbol_id_;
+        out.timestamp = timestamp_;
+        depth = std::min(depth, MAX_BOOK_DEPTH);
+        out.bids.clear();
+        for (auto it = bids_.rbegin(); it != bids_.rend() && out.bids.size() < depth; ++it)
+            out.bids.push_back(it->price, it->quantity);
+        out.asks.clear();
+        for (auto it = asks_.rbegin(); it != asks_.rend() && out.asks.size() < depth; ++it)
+            out.asks.push_back(it->price, it->quantity);
+    }
+
+} // namespace hft_system
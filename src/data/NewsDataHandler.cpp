@@ -1,5 +1,6 @@
 #include "../../include/data/NewsDataHandler.h"
 #include "../../include/core/Log.h"
+#include "../../include/core/SymbolRegistry.h"
 #include <vector>
 #include <string>
 #include <algorithm>
@@ -78,7 +79,7 @@ namespace hft_system
 
                     // For simplicity, we'll assign the news to a default symbol.
                     // A more advanced system would parse entities from the headline.
-                    auto news_event = std::make_shared<NewsEvent>("GENERIC", headline, sentiment);
+                    auto news_event = std::make_shared<NewsEvent>(intern_symbol("GENERIC"), headline, sentiment);
                     event_bus_->publish(news_event);
                     Log::get_logger()->info("Published NewsEvent. Sentiment: {:.2f}, Headline: {}", sentiment, headline);
                 }
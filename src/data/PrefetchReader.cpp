@@ -0,0 +1,149 @@
+#include "../../include/data/PrefetchReader.h"
+#include "../../include/core/Log.h"
+#include "../../include/utils/Timer.h"
+#include "../../include/utils/PerformanceMonitor.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+namespace hft_system
+{
+    namespace
+    {
+        constexpr size_t IO_ALIGNMENT = 4096;
+    }
+
+    PrefetchReader::PrefetchReader(std::string file_path, size_t block_size, size_t num_buffers)
+        : file_path_(std::move(file_path)),
+          // Round the block size up to whole pages so every pread() is page aligned.
+          block_size_(((std::max<size_t>(block_size, 1) + IO_ALIGNMENT - 1) / IO_ALIGNMENT) * IO_ALIGNMENT),
+          free_buffers_(std::max<size_t>(num_buffers, 1)),
+          filled_blocks_(std::max<size_t>(num_buffers, 1))
+    {
+        buffers_.resize(std::max<size_t>(num_buffers, 1), nullptr);
+    }
+
+    PrefetchReader::~PrefetchReader()
+    {
+        stop();
+        for (char *buffer : buffers_)
+        {
+            std::free(buffer);
+        }
+    }
+
+    bool PrefetchReader::start(int64_t start_offset)
+    {
+        for (char *&buffer : buffers_)
+        {
+            if (!buffer)
+                buffer = static_cast<char *>(std::aligned_alloc(IO_ALIGNMENT, block_size_));
+            if (!buffer)
+            {
+                Log::get_logger()->error("PrefetchReader: cannot allocate {} byte buffers for {}", block_size_, file_path_);
+                return false;
+            }
+        }
+
+        fd_ = ::open(file_path_.c_str(), O_RDONLY);
+        if (fd_ < 0)
+        {
+            Log::get_logger()->error("PrefetchReader: failed to open {}: {}", file_path_, std::strerror(errno));
+            return false;
+        }
+
+        // We stream the file front to back exactly once.
+        start_offset_ = std::max<int64_t>(start_offset, 0);
+        ::posix_fadvise(fd_, start_offset_, 0, POSIX_FADV_SEQUENTIAL);
+
+        for (size_t i = 0; i < buffers_.size(); ++i)
+            free_buffers_.push(i);
+
+        is_running_.store(true);
+        io_thread_ = std::thread(&PrefetchReader::io_loop, this);
+        return true;
+    }
+
+    void PrefetchReader::stop()
+    {
+        is_running_.store(false);
+        free_buffers_.close();
+        filled_blocks_.close();
+        if (io_thread_.joinable())
+        {
+            io_thread_.join();
+        }
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    bool PrefetchReader::acquire(Block &block)
+    {
+        return filled_blocks_.pop(block);
+    }
+
+    void PrefetchReader::release(const Block &block)
+    {
+        free_buffers_.push(block.buffer_index);
+    }
+
+    void PrefetchReader::io_loop()
+    {
+        int64_t offset = start_offset_;
+        while (is_running_.load())
+        {
+            Timer wait_timer;
+            size_t index;
+            if (!free_buffers_.pop(index))
+                break;
+            stats_.add_wait(wait_timer.elapsed_nanoseconds());
+
+            Timer busy_timer;
+            char *buffer = buffers_[index];
+            size_t filled = 0;
+            bool failed = false;
+            while (filled < block_size_)
+            {
+                ssize_t n = ::pread(fd_, buffer + filled, block_size_ - filled, offset + static_cast<int64_t>(filled));
+                if (n < 0)
+                {
+                    if (errno == EINTR)
+                        continue;
+                    Log::get_logger()->error("PrefetchReader: read error on {}: {}", file_path_, std::strerror(errno));
+                    failed = true;
+                    break;
+                }
+                if (n == 0)
+                    break; // End of file
+                filled += static_cast<size_t>(n);
+            }
+
+            if (failed || filled == 0)
+                break;
+
+            // Ask the kernel to start fetching what we will want once this block is consumed.
+            ::posix_fadvise(fd_, offset + static_cast<int64_t>(filled),
+                            static_cast<off_t>(block_size_ * buffers_.size()), POSIX_FADV_WILLNEED);
+
+            int64_t busy = busy_timer.elapsed_nanoseconds();
+            stats_.add_busy(busy);
+            stats_.add_item(static_cast<int64_t>(filled));
+            PerformanceMonitor::get_instance().record_metric("PrefetchReader_read_block", busy);
+
+            if (!filled_blocks_.push({buffer, filled, offset, index}))
+                break;
+            offset += static_cast<int64_t>(filled);
+
+            if (filled < block_size_)
+                break; // Short read means we hit the end of the file.
+        }
+        filled_blocks_.close();
+    }
+
+} // namespace hft_system
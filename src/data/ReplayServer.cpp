@@ -0,0 +1,338 @@
+#include "../../include/data/ReplayServer.h"
+#include "../../include/core/Log.h"
+#include "simdjson.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <unordered_set>
+#include <boost/beast/core.hpp>
+#include <boost/beast/websocket.hpp>
+
+namespace hft_system
+{
+    namespace beast = boost::beast;
+    namespace websocket = beast::websocket;
+    namespace net = boost::asio;
+    using tcp = boost::asio::ip::tcp;
+
+    namespace
+    {
+        std::string to_lower(std::string_view text)
+        {
+            std::string lower(text);
+            std::transform(lower.begin(), lower.end(), lower.begin(),
+                           [](unsigned char c)
+                           { return std::tolower(c); });
+            return lower;
+        }
+
+        int64_t system_now_ns()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                .count();
+        }
+    }
+
+    // One client connection: handshake, SUBSCRIBE, then the paced replay.
+    // Reads stay outstanding throughout so pings and the client's close are answered.
+    class ReplayServer::Session : public std::enable_shared_from_this<ReplayServer::Session>
+    {
+    public:
+        Session(ReplayServer &server, tcp::socket socket)
+            : server_(server), ws_(std::move(socket)), timer_(ws_.get_executor()) {}
+
+        void start()
+        {
+            ws_.async_accept(beast::bind_front_handler(&Session::on_accept, shared_from_this()));
+        }
+
+        void close()
+        {
+            beast::error_code ec;
+            timer_.cancel();
+            beast::get_lowest_layer(ws_).close(ec);
+        }
+
+    private:
+        void on_accept(beast::error_code ec)
+        {
+            if (ec)
+                return;
+            ws_.async_read(buffer_, beast::bind_front_handler(&Session::on_subscribe, shared_from_this()));
+        }
+
+        void on_subscribe(beast::error_code ec, std::size_t)
+        {
+            if (ec)
+                return;
+
+            // {"method":"SUBSCRIBE","params":["btcusdt@depth",...],"id":1}
+            simdjson::padded_string request(beast::buffers_to_string(buffer_.data()));
+            buffer_.consume(buffer_.size());
+            simdjson::dom::parser parser;
+            simdjson::dom::element doc;
+            simdjson::dom::array params;
+            int64_t id = 0;
+            if (parser.parse(request).get(doc) != simdjson::SUCCESS || doc["params"].get_array().get(params) != simdjson::SUCCESS)
+            {
+                Log::get_logger()->warn("ReplayServer: ignoring malformed subscription {}", request.data());
+                return close();
+            }
+            if (doc["id"].get_int64().get(id) != simdjson::SUCCESS)
+                id = 1;
+
+            std::unordered_set<std::string> streams;
+            for (auto param : params)
+            {
+                std::string_view stream;
+                if (param.get_string().get(stream) == simdjson::SUCCESS)
+                    streams.emplace(stream);
+            }
+            const auto &messages = server_.messages_;
+            const auto &dropped = server_.options_.drop_messages;
+            for (size_t i = 0; i < messages.size(); ++i)
+            {
+                if (streams.count(messages[i].stream) && std::find(dropped.begin(), dropped.end(), i) == dropped.end())
+                    selected_.push_back(i);
+            }
+            Log::get_logger()->info("ReplayServer: client subscribed to {} streams; replaying {} messages x {}.",
+                                    streams.size(), selected_.size(), server_.options_.loops);
+
+            ack_ = R"({"result":null,"id":)" + std::to_string(id) + "}";
+            ws_.text(true);
+            ws_.async_write(net::buffer(ack_), beast::bind_front_handler(&Session::on_ack, shared_from_this()));
+        }
+
+        void on_ack(beast::error_code ec, std::size_t)
+        {
+            if (ec)
+                return;
+            ws_.async_read(buffer_, beast::bind_front_handler(&Session::on_read, shared_from_this()));
+            begin_pass();
+            send_next();
+        }
+
+        void on_read(beast::error_code ec, std::size_t)
+        {
+            if (ec)
+                return close(); // Client closed or the server is shutting down
+            buffer_.consume(buffer_.size());
+            ws_.async_read(buffer_, beast::bind_front_handler(&Session::on_read, shared_from_this()));
+        }
+
+        void begin_pass()
+        {
+            next_ = 0;
+            pass_start_ = std::chrono::steady_clock::now();
+            if (!selected_.empty())
+                first_event_time_ = server_.messages_[selected_.front()].event_time;
+        }
+
+        void send_next()
+        {
+            if (next_ == selected_.size())
+            {
+                if (++pass_ >= server_.options_.loops || selected_.empty())
+                    return; // Done; the connection stays open like an idle exchange stream
+                begin_pass();
+            }
+
+            const double speed = server_.options_.speed;
+            if (speed > 0.0)
+            {
+                const Message &message = server_.messages_[selected_[next_]];
+                auto due = pass_start_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                             std::chrono::duration<double, std::milli>((message.event_time - first_event_time_) / speed));
+                if (due > std::chrono::steady_clock::now())
+                {
+                    timer_.expires_at(due);
+                    timer_.async_wait(beast::bind_front_handler(&Session::on_timer, shared_from_this()));
+                    return;
+                }
+            }
+            write_next();
+        }
+
+        void on_timer(beast::error_code ec)
+        {
+            if (ec)
+                return;
+            write_next();
+        }
+
+        void write_next()
+        {
+            size_t index = selected_[next_];
+            if (server_.options_.record_send_times)
+            {
+                std::lock_guard<std::mutex> lock(server_.send_records_mutex_);
+                server_.send_records_.push_back({index, system_now_ns()});
+            }
+            ws_.async_write(net::buffer(server_.messages_[index].frame),
+                            beast::bind_front_handler(&Session::on_write, shared_from_this()));
+        }
+
+        void on_write(beast::error_code ec, std::size_t)
+        {
+            if (ec)
+                return;
+            server_.messages_sent_.fetch_add(1, std::memory_order_relaxed);
+            ++next_;
+            if (server_.options_.disconnect_after != 0 && ++sent_ >= server_.options_.disconnect_after)
+            {
+                Log::get_logger()->info("ReplayServer: dropping connection after {} messages.", sent_);
+                return close();
+            }
+            send_next();
+        }
+
+        ReplayServer &server_;
+        websocket::stream<tcp::socket> ws_;
+        net::steady_timer timer_;
+        beast::flat_buffer buffer_;
+        std::string ack_;
+        std::vector<size_t> selected_; // Indices of the subscribed streams' messages
+        size_t next_ = 0;
+        size_t sent_ = 0;
+        int pass_ = 0;
+        std::chrono::steady_clock::time_point pass_start_;
+        int64_t first_event_time_ = 0;
+    };
+
+    ReplayServer::ReplayServer(ReplayServerOptions options)
+        : options_(std::move(options)), acceptor_(ioc_) {}
+
+    ReplayServer::~ReplayServer()
+    {
+        stop();
+    }
+
+    bool ReplayServer::load_messages()
+    {
+        std::ifstream in(options_.messages_file);
+        if (!in)
+        {
+            Log::get_logger()->error("ReplayServer: cannot open {}", options_.messages_file);
+            return false;
+        }
+
+        simdjson::dom::parser parser;
+        std::string line;
+        int64_t last_event_time = 0;
+        size_t line_number = 0;
+        while (std::getline(in, line))
+        {
+            ++line_number;
+            if (line.find_first_not_of(" \t\r") == std::string::npos)
+                continue;
+
+            simdjson::dom::element doc;
+            if (parser.parse(line).get(doc) != simdjson::SUCCESS)
+            {
+                Log::get_logger()->warn("ReplayServer: skipping malformed line {}", line_number);
+                continue;
+            }
+
+            Message message;
+            simdjson::dom::element payload = doc;
+            std::string_view stream;
+            if (doc["stream"].get_string().get(stream) == simdjson::SUCCESS)
+            {
+                // Already a combined-stream frame.
+                message.stream = stream;
+                message.frame = line;
+                if (doc["data"].get(payload) != simdjson::SUCCESS)
+                    continue;
+            }
+            else
+            {
+                std::string_view event_type, symbol;
+                if (doc["s"].get_string().get(symbol) != simdjson::SUCCESS)
+                {
+                    Log::get_logger()->warn("ReplayServer: line {} has no symbol; skipped.", line_number);
+                    continue;
+                }
+                if (doc["e"].get_string().get(event_type) == simdjson::SUCCESS)
+                    message.stream = to_lower(symbol) + (event_type == "depthUpdate" ? "@depth" : "@" + std::string(event_type));
+                else
+                    message.stream = to_lower(symbol) + "@bookTicker"; // The only stream without an event type
+                message.frame = R"({"stream":")" + message.stream + R"(","data":)" + line + "}";
+            }
+
+            int64_t event_time;
+            if (payload["E"].get_int64().get(event_time) == simdjson::SUCCESS)
+                last_event_time = event_time;
+            message.event_time = last_event_time;
+            messages_.push_back(std::move(message));
+        }
+        Log::get_logger()->info("ReplayServer: loaded {} messages from {}", messages_.size(), options_.messages_file);
+        return true;
+    }
+
+    bool ReplayServer::start()
+    {
+        if (!load_messages())
+            return false;
+
+        beast::error_code ec;
+        tcp::endpoint endpoint(net::ip::make_address(options_.host, ec), options_.port);
+        if (!ec)
+            acceptor_.open(endpoint.protocol(), ec);
+        if (!ec)
+            acceptor_.set_option(net::socket_base::reuse_address(true), ec);
+        if (!ec)
+            acceptor_.bind(endpoint, ec);
+        if (!ec)
+            acceptor_.listen(net::socket_base::max_listen_connections, ec);
+        if (ec)
+        {
+            Log::get_logger()->error("ReplayServer: cannot listen on {}:{}: {}", options_.host, options_.port, ec.message());
+            return false;
+        }
+        port_ = acceptor_.local_endpoint().port();
+        Log::get_logger()->info("ReplayServer: listening on ws://{}:{}", options_.host, port_);
+
+        do_accept();
+        io_thread_ = std::thread([this]()
+                                 { ioc_.run(); });
+        return true;
+    }
+
+    void ReplayServer::do_accept()
+    {
+        acceptor_.async_accept(ioc_, [this](beast::error_code ec, tcp::socket socket)
+                               {
+            if (ec)
+                return; // Acceptor closed
+            connections_accepted_.fetch_add(1, std::memory_order_relaxed);
+            auto session = std::make_shared<Session>(*this, std::move(socket));
+            sessions_.push_back(session);
+            session->start();
+            do_accept(); });
+    }
+
+    void ReplayServer::stop()
+    {
+        if (!io_thread_.joinable())
+            return;
+        net::post(ioc_, [this]()
+                  {
+            beast::error_code ec;
+            acceptor_.close(ec);
+            for (auto &weak : sessions_)
+            {
+                if (auto session = weak.lock())
+                    session->close();
+            }
+            ioc_.stop(); });
+        io_thread_.join();
+    }
+
+    std::vector<ReplayServer::SendRecord> ReplayServer::send_records() const
+    {
+        std::lock_guard<std::mutex> lock(send_records_mutex_);
+        return send_records_;
+    }
+
+} // namespace hft_system
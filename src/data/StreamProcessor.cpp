@@ -0,0 +1,286 @@
+#include "../../include/data/StreamProcessor.h"
+#include "../../include/core/Log.h"
+#include "../../include/core/SymbolRegistry.h"
+#include "../../include/utils/Timer.h"
+#include <algorithm>
+#include <iterator>
+
+namespace hft_system
+{
+
+    StreamProcessor::StreamProcessor(std::shared_ptr<EventBus> event_bus, size_t book_depth, SnapshotRequest request_snapshot)
+        : event_bus_(std::move(event_bus)), book_depth_(book_depth), request_snapshot_(std::move(request_snapshot)) {}
+
+    bool StreamProcessor::add_stream(std::string_view name)
+    {
+        BinanceStreamDecoder::StreamKind kind;
+        size_t at = name.find('@');
+        if (!BinanceStreamDecoder::parse_kind(name, kind))
+            return false;
+
+        // Stream names are lower case; symbols in payloads and REST calls are upper case.
+        std::string symbol(name.substr(0, at));
+        std::transform(symbol.begin(), symbol.end(), symbol.begin(),
+                       [](unsigned char c)
+                       { return std::toupper(c); });
+
+        Feed *feed = find_feed(symbol);
+        if (!feed)
+        {
+            feeds_.push_back(std::make_unique<Feed>(symbol, instrument_spec(intern_symbol(symbol))));
+            feed = feeds_.back().get();
+        }
+
+        size_t stream = decoder_.add_stream(name, feed->snapshot_decoder.spec());
+        if (stream < stream_feeds_.size())
+            return true; // Already subscribed
+        stream_feeds_.push_back(feed);
+        stream_stats_.emplace_back();
+        if (kind == BinanceStreamDecoder::StreamKind::DEPTH)
+        {
+            feed->has_depth = true;
+            feed->depth_stream = stream;
+            sync_lazy_depth(*feed);
+        }
+        return true;
+    }
+
+    StreamProcessor::Feed *StreamProcessor::find_feed(std::string_view symbol)
+    {
+        for (auto &feed : feeds_)
+        {
+            if (feed->local_book.symbol() == symbol)
+                return feed.get();
+        }
+        return nullptr;
+    }
+
+    std::string StreamProcessor::subscribe_message() const
+    {
+        std::string params;
+        for (size_t stream = 0; stream < decoder_.stream_count(); ++stream)
+            params += (params.empty() ? "\"" : ",\"") + decoder_.stream_name(stream) + "\"";
+        return R"({"method":"SUBSCRIBE","params":[)" + params + R"(],"id":1})";
+    }
+
+    void StreamProcessor::request_snapshots()
+    {
+        for (auto &feed : feeds_)
+        {
+            if (feed->has_depth)
+                request_snapshot(*feed);
+        }
+    }
+
+    void StreamProcessor::request_snapshot(Feed &feed)
+    {
+        if (feed.snapshot_in_flight)
+            return;
+        feed.snapshot_in_flight = true;
+        request_snapshot_(feed);
+    }
+
+    void StreamProcessor::process_frame(const char *data, size_t size, size_t capacity)
+    {
+        Timer parse_timer;
+        BinanceStreamDecoder::Result result = decoder_.decode(data, size, capacity);
+        int64_t parse_ns = parse_timer.elapsed_nanoseconds();
+
+        size_t stream = decoder_.stream();
+        if (stream != BinanceStreamDecoder::NO_STREAM)
+        {
+            StreamStats &stats = stream_stats_[stream];
+            stats.messages.fetch_add(1, std::memory_order_relaxed);
+            stats.bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+            stats.parse_ns.fetch_add(parse_ns, std::memory_order_relaxed);
+            if (parse_ns > stats.max_parse_ns.load(std::memory_order_relaxed))
+                stats.max_parse_ns.store(parse_ns, std::memory_order_relaxed);
+        }
+
+        switch (result)
+        {
+        case BinanceStreamDecoder::Result::SUBSCRIPTION_ACK:
+            Log::get_logger()->info("Subscription confirmed.");
+            return;
+        case BinanceStreamDecoder::Result::IGNORED:
+            return; // Unsubscribed stream or an event we do not use
+        case BinanceStreamDecoder::Result::ERROR:
+            Log::get_logger()->error("Error parsing WebSocket message: {}", std::string_view(data, size));
+            return;
+        case BinanceStreamDecoder::Result::DEPTH_UPDATE:
+            on_depth(*stream_feeds_[stream]);
+            return;
+        case BinanceStreamDecoder::Result::TRADE:
+        {
+            const Feed &feed = *stream_feeds_[stream];
+            const InstrumentSpec &spec = feed.snapshot_decoder.spec();
+            const TradeUpdate &trade = decoder_.trade();
+            event_bus_->publish(std::make_shared<MarketEvent>(feed.local_book.symbol_id(), spec.to_double(trade.price),
+                                                              trade.trade_time * 1'000'000LL, spec.to_double(trade.quantity)));
+            return;
+        }
+        case BinanceStreamDecoder::Result::BOOK_TICKER:
+        {
+            const BookTickerUpdate &quote = decoder_.book_ticker();
+            event_bus_->publish(std::make_shared<QuoteEvent>(stream_feeds_[stream]->local_book.symbol_id(), quote.update_id,
+                                                             quote.bid_price, quote.bid_quantity, quote.ask_price, quote.ask_quantity));
+            return;
+        }
+        }
+    }
+
+    void StreamProcessor::on_depth(Feed &feed)
+    {
+        if (decoder_.depth_is_raw())
+        {
+            // The book is waiting for a snapshot (see sync_lazy_depth()), and most
+            // of what is buffered now will be stale by then.
+            buffer_diff(feed, decoder_.raw_depth());
+            return;
+        }
+
+        const DepthUpdate &diff = decoder_.depth();
+        apply_diff(feed, diff, decoder_.first_update_id(), decoder_.final_update_id());
+        sync_lazy_depth(feed);
+    }
+
+    void StreamProcessor::buffer_diff(Feed &feed, RawDepthUpdate diff)
+    {
+        if (feed.pending_diffs.size() >= MAX_PENDING_DIFFS)
+            feed.pending_diffs.pop_front();
+        feed.pending_diffs.push_back(std::move(diff));
+    }
+
+    void StreamProcessor::sync_lazy_depth(Feed &feed)
+    {
+        if (feed.depth_stream != BinanceStreamDecoder::NO_STREAM)
+            decoder_.set_lazy_depth(feed.depth_stream, !feed.local_book.is_synced());
+    }
+
+    void StreamProcessor::apply_diff(Feed &feed, const DepthUpdate &diff, int64_t first_update_id, int64_t final_update_id)
+    {
+        LocalOrderBook &local_book = feed.local_book;
+        switch (local_book.apply_diff(diff, first_update_id, final_update_id))
+        {
+        case LocalOrderBook::ApplyResult::APPLIED:
+            publish_book(feed);
+            break;
+        case LocalOrderBook::ApplyResult::STALE:
+            break;
+        case LocalOrderBook::ApplyResult::GAP:
+            Log::get_logger()->warn("{}: depth gap (book at {}, diff {}..{}); resynchronising from a new snapshot.",
+                                    local_book.symbol(), local_book.last_update_id(), first_update_id, final_update_id);
+            gaps_.fetch_add(1, std::memory_order_relaxed);
+            publish_unavailable(feed);
+            feed.pending_diffs.clear();
+            buffer_diff(feed, RawDepthUpdate(diff, first_update_id, final_update_id));
+            request_snapshot(feed);
+            break;
+        case LocalOrderBook::ApplyResult::NOT_SYNCED:
+            buffer_diff(feed, RawDepthUpdate(diff, first_update_id, final_update_id));
+            break;
+        }
+    }
+
+    void StreamProcessor::publish_book(Feed &feed)
+    {
+        feed.local_book.top_n(book_depth_, feed.view);
+        if (feed.recorder)
+            feed.recorder->append(feed.view);
+        event_bus_->publish(std::make_shared<OrderBookEvent>(feed.view));
+    }
+
+    void StreamProcessor::publish_unavailable(Feed &feed)
+    {
+        feed.view.symbol_id = feed.local_book.symbol_id();
+        feed.view.bids.clear();
+        feed.view.asks.clear();
+        if (feed.recorder)
+            feed.recorder->append(feed.view);
+        event_bus_->publish(std::make_shared<OrderBookEvent>(feed.view));
+    }
+
+    void StreamProcessor::reset()
+    {
+        for (auto &feed : feeds_)
+        {
+            if (feed->local_book.is_synced())
+                publish_unavailable(*feed);
+            feed->local_book.invalidate();
+            feed->pending_diffs.clear();
+            feed->snapshot_in_flight = false;
+            feed->snapshot_file_used = false;
+            sync_lazy_depth(*feed);
+        }
+    }
+
+    bool StreamProcessor::on_snapshot(Feed &feed, const std::string &body)
+    {
+        feed.snapshot_in_flight = false;
+        LocalOrderBook &local_book = feed.local_book;
+
+        simdjson::padded_string padded(body);
+        DepthUpdate snapshot;
+        int64_t last_update_id;
+        if (body.empty() || !feed.snapshot_decoder.decode_snapshot(padded.data(), padded.size(), padded.size() + simdjson::SIMDJSON_PADDING,
+                                                                    snapshot, last_update_id))
+        {
+            Log::get_logger()->error("{}: no usable depth snapshot; the local book stays unsynchronised.", local_book.symbol());
+            return false;
+        }
+
+        snapshot.symbol = local_book.symbol();
+        local_book.apply_snapshot(snapshot, last_update_id);
+        Log::get_logger()->info("{}: local book seeded at update {} ({} bids, {} asks); replaying {} buffered diffs.",
+                                local_book.symbol(), last_update_id, local_book.bid_depth(), local_book.ask_depth(),
+                                feed.pending_diffs.size());
+
+        std::deque<RawDepthUpdate> pending;
+        pending.swap(feed.pending_diffs);
+        for (auto it = pending.begin(); it != pending.end(); ++it)
+        {
+            if (it->final_update_id() <= local_book.last_update_id())
+            {
+                // Older than the snapshot: dropped without parsing its levels.
+                if (!it->is_decoded())
+                    stale_diffs_skipped_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            if (!it->decode(feed.snapshot_decoder.spec()))
+            {
+                // Like an unparseable frame on the eager path; the next diff then shows up as a gap.
+                Log::get_logger()->error("{}: unparseable levels in buffered diff {}..{}", local_book.symbol(),
+                                         it->first_update_id(), it->final_update_id());
+                continue;
+            }
+            apply_diff(feed, it->update(), it->first_update_id(), it->final_update_id());
+            if (!local_book.is_synced())
+            {
+                // A gap re-requested a snapshot and re-buffered this diff; keep the ones after it too.
+                feed.pending_diffs.insert(feed.pending_diffs.end(), std::make_move_iterator(std::next(it)),
+                                          std::make_move_iterator(pending.end()));
+                break;
+            }
+        }
+        if (local_book.is_synced())
+            publish_book(feed);
+        sync_lazy_depth(feed);
+        return true;
+    }
+
+    void StreamProcessor::collect_statistics(double seconds, std::map<std::string, std::map<std::string, double>> &out) const
+    {
+        for (size_t stream = 0; stream < stream_stats_.size(); ++stream)
+        {
+            const StreamStats &stats = stream_stats_[stream];
+            double messages = static_cast<double>(stats.messages.load(std::memory_order_relaxed));
+            out[decoder_.stream_name(stream)] = {
+                {"messages", messages},
+                {"msgs_per_sec", seconds > 0.0 ? messages / seconds : 0.0},
+                {"bytes", static_cast<double>(stats.bytes.load(std::memory_order_relaxed))},
+                {"avg_parse_ns", messages > 0.0 ? stats.parse_ns.load(std::memory_order_relaxed) / messages : 0.0},
+                {"max_parse_ns", static_cast<double>(stats.max_parse_ns.load(std::memory_order_relaxed))}};
+        }
+    }
+
+} // namespace hft_system
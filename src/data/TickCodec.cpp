@@ -0,0 +1,288 @@
+#include "../../include/data/TickCodec.h"
+#include "../../include/core/Log.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace hft_system
+{
+    using namespace tick_codec;
+
+    void TickBlock::clear()
+    {
+        timestamps.clear();
+        level_begin.clear();
+        bid_counts.clear();
+        ask_counts.clear();
+        prices.clear();
+        quantities.clear();
+    }
+
+    OrderBook TickBlock::to_order_book(size_t index, SymbolId symbol_id) const
+    {
+        OrderBook book;
+        book.symbol_id = symbol_id;
+        book.timestamp = timestamps[index];
+        size_t level = level_begin[index];
+        size_t bids_end = level + bid_counts[index];
+        size_t asks_end = bids_end + ask_counts[index];
+        for (; level < bids_end && book.bids.size() < MAX_BOOK_DEPTH; ++level)
+        {
+            if (quantities[level] > 0)
+                book.bids.push_back(Price(prices[level]), Quantity(quantities[level]));
+        }
+        for (level = bids_end; level < asks_end && book.asks.size() < MAX_BOOK_DEPTH; ++level)
+        {
+            if (quantities[level] > 0)
+                book.asks.push_back(Price(prices[level]), Quantity(quantities[level]));
+        }
+        return book;
+    }
+
+    // --- TickWriter ---
+
+    TickWriter::TickWriter(std::string file_path, std::string symbol, double price_tick, double qty_lot, size_t updates_per_block)
+        : file_path_(std::move(file_path)),
+          symbol_(std::move(symbol)),
+          price_tick_(price_tick),
+          qty_lot_(qty_lot),
+          updates_per_block_(std::max<size_t>(updates_per_block, 1)) {}
+
+    TickWriter::~TickWriter()
+    {
+        close();
+    }
+
+    bool TickWriter::open()
+    {
+        if (price_tick_ <= 0.0 || qty_lot_ <= 0.0)
+        {
+            Log::get_logger()->error("TickWriter: price tick and quantity lot must be positive.");
+            return false;
+        }
+        file_ = std::fopen(file_path_.c_str(), "wb");
+        if (!file_)
+        {
+            Log::get_logger()->error("TickWriter: cannot create {}", file_path_);
+            return false;
+        }
+
+        FileHeader header{};
+        std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        header.version = FILE_VERSION;
+        header.price_tick = price_tick_;
+        header.qty_lot = qty_lot_;
+        std::strncpy(header.symbol, symbol_.c_str(), sizeof(header.symbol) - 1);
+        bytes_written_ += std::fwrite(&header, 1, sizeof(header), file_);
+        return true;
+    }
+
+    void TickWriter::append(const DepthUpdate &book)
+    {
+        if (!file_)
+            return;
+
+        begin_update(book.timestamp, book.bids.size(), book.asks.size());
+        for (const auto &level : book.bids)
+            append_level(level.price, level.quantity, last_bid_);
+        for (const auto &level : book.asks)
+            append_level(level.price, level.quantity, last_ask_);
+        end_update(book.timestamp, book.bids.size() + book.asks.size());
+    }
+
+    void TickWriter::append(const OrderBook &book)
+    {
+        if (!file_)
+            return;
+
+        begin_update(book.timestamp, book.bids.size(), book.asks.size());
+        for (size_t i = 0; i < book.bids.size(); ++i)
+            append_level(book.bids.price[i], book.bids.quantity[i], last_bid_);
+        for (size_t i = 0; i < book.asks.size(); ++i)
+            append_level(book.asks.price[i], book.asks.quantity[i], last_ask_);
+        end_update(book.timestamp, book.bids.size() + book.asks.size());
+    }
+
+    void TickWriter::begin_update(int64_t timestamp, size_t bid_count, size_t ask_count)
+    {
+        if (block_.update_count == 0)
+        {
+            block_.first_timestamp = timestamp;
+            block_.last_timestamp = timestamp;
+            last_timestamp_ = timestamp;
+            last_bid_ = 0;
+            last_ask_ = 0;
+        }
+
+        write_varint(payload_, zigzag_encode(timestamp - last_timestamp_));
+        write_varint(payload_, bid_count);
+        write_varint(payload_, ask_count);
+    }
+
+    void TickWriter::append_level(Price price, Quantity quantity, int64_t &last_price)
+    {
+        write_varint(payload_, zigzag_encode(price.value - last_price));
+        write_varint(payload_, static_cast<uint64_t>(std::max<int64_t>(quantity.value, 0)));
+        last_price = price.value;
+    }
+
+    void TickWriter::end_update(int64_t timestamp, size_t level_count)
+    {
+        last_timestamp_ = timestamp;
+        block_.last_timestamp = std::max<int64_t>(block_.last_timestamp, timestamp);
+        block_.update_count++;
+        block_.level_count += static_cast<uint32_t>(level_count);
+        updates_written_++;
+
+        if (block_.update_count >= updates_per_block_)
+        {
+            flush();
+        }
+    }
+
+    void TickWriter::flush()
+    {
+        if (!file_ || block_.update_count == 0)
+            return;
+
+        block_.magic = BLOCK_MAGIC;
+        block_.payload_bytes = static_cast<uint32_t>(payload_.size());
+        bytes_written_ += std::fwrite(&block_, 1, sizeof(block_), file_);
+        bytes_written_ += std::fwrite(payload_.data(), 1, payload_.size(), file_);
+        std::fflush(file_);
+
+        payload_.clear();
+        block_ = BlockHeader{};
+    }
+
+    void TickWriter::close()
+    {
+        if (!file_)
+            return;
+        flush();
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+
+    // --- TickReader ---
+
+    TickReader::TickReader(std::string file_path) : file_path_(std::move(file_path)) {}
+
+    TickReader::~TickReader()
+    {
+        if (file_)
+        {
+            std::fclose(file_);
+        }
+    }
+
+    bool TickReader::open()
+    {
+        file_ = std::fopen(file_path_.c_str(), "rb");
+        if (!file_)
+            return false;
+
+        FileHeader header;
+        if (std::fread(&header, 1, sizeof(header), file_) != sizeof(header) ||
+            std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 ||
+            header.version != FILE_VERSION)
+        {
+            Log::get_logger()->error("TickReader: {} is not a version {} tick file.", file_path_, FILE_VERSION);
+            std::fclose(file_);
+            file_ = nullptr;
+            return false;
+        }
+
+        header.symbol[sizeof(header.symbol) - 1] = '\0';
+        symbol_ = header.symbol;
+        price_tick_ = header.price_tick;
+        qty_lot_ = header.qty_lot;
+        return true;
+    }
+
+    bool TickReader::next_block(TickBlock &block, int64_t min_timestamp)
+    {
+        if (!file_)
+            return false;
+
+        BlockHeader header;
+        while (true)
+        {
+            size_t got = std::fread(&header, 1, sizeof(header), file_);
+            if (got == 0)
+                return false;
+            if (got != sizeof(header) || header.magic != BLOCK_MAGIC)
+                throw std::runtime_error("TickReader: corrupt block header in " + file_path_);
+            if (header.last_timestamp >= min_timestamp)
+                break;
+            if (std::fseek(file_, static_cast<long>(header.payload_bytes), SEEK_CUR) != 0)
+                throw std::runtime_error("TickReader: truncated block in " + file_path_);
+        }
+
+        payload_.resize(header.payload_bytes + DECODE_PADDING);
+        if (std::fread(payload_.data(), 1, header.payload_bytes, file_) != header.payload_bytes)
+            throw std::runtime_error("TickReader: truncated block in " + file_path_);
+        std::memset(payload_.data() + header.payload_bytes, 0, DECODE_PADDING);
+
+        decode_block(header, payload_.data(), block);
+        return true;
+    }
+
+    void TickReader::decode_block(const BlockHeader &header, const uint8_t *payload, TickBlock &block)
+    {
+        const uint32_t updates = header.update_count;
+        const uint32_t levels = header.level_count;
+        block.timestamps.resize(updates);
+        block.level_begin.resize(updates);
+        block.bid_counts.resize(updates);
+        block.ask_counts.resize(updates);
+        block.prices.resize(levels);
+        block.quantities.resize(levels);
+
+        // The payload is followed by DECODE_PADDING readable bytes, and each check below
+        // runs before more than one update header or one level (at most 30 bytes) is read past `end`.
+        const uint8_t *cursor = payload;
+        const uint8_t *end = payload + header.payload_bytes;
+        int64_t *prices = block.prices.data();
+        int64_t *quantities = block.quantities.data();
+        int64_t timestamp = header.first_timestamp;
+        int64_t bid = 0;
+        int64_t ask = 0;
+        uint32_t level = 0;
+
+        for (uint32_t update = 0; update < updates; ++update)
+        {
+            timestamp += zigzag_decode(read_varint(cursor));
+            uint64_t bids = read_varint(cursor);
+            uint64_t asks = read_varint(cursor);
+            if (cursor > end || bids + asks > levels - level)
+                throw std::runtime_error("TickReader: corrupt block payload");
+
+            block.timestamps[update] = timestamp;
+            block.level_begin[update] = level;
+            block.bid_counts[update] = static_cast<uint32_t>(bids);
+            block.ask_counts[update] = static_cast<uint32_t>(asks);
+
+            for (uint64_t i = 0; i < bids; ++i, ++level)
+            {
+                bid += zigzag_decode(read_varint(cursor));
+                prices[level] = bid;
+                quantities[level] = static_cast<int64_t>(read_varint(cursor));
+                if (cursor > end)
+                    throw std::runtime_error("TickReader: corrupt block payload");
+            }
+            for (uint64_t i = 0; i < asks; ++i, ++level)
+            {
+                ask += zigzag_decode(read_varint(cursor));
+                prices[level] = ask;
+                quantities[level] = static_cast<int64_t>(read_varint(cursor));
+                if (cursor > end)
+                    throw std::runtime_error("TickReader: corrupt block payload");
+            }
+        }
+
+        if (level != levels || cursor != end)
+            throw std::runtime_error("TickReader: corrupt block payload");
+    }
+
+} // namespace hft_system
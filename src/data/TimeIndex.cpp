@@ -0,0 +1,221 @@
+#include "../../include/data/TimeIndex.h"
+#include "../../include/data/PrefetchReader.h"
+#include "../../include/core/Log.h"
+#include "../../include/utils/Timer.h"
+#include <sys/stat.h>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <cstdio>
+
+namespace hft_system
+{
+    namespace
+    {
+        constexpr char INDEX_MAGIC[8] = {'H', 'F', 'T', 'T', 'S', 'I', 'D', 'X'};
+        constexpr uint32_t INDEX_VERSION = 1;
+
+        struct IndexHeader
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t stride;
+            uint64_t source_size;
+            int64_t source_mtime;
+            int64_t data_offset;
+            uint64_t entry_count;
+            uint8_t sorted;
+            uint8_t reserved[7];
+        };
+
+        bool stat_file(const std::string &path, uint64_t &size, int64_t &mtime)
+        {
+            struct stat st;
+            if (::stat(path.c_str(), &st) != 0)
+                return false;
+            size = static_cast<uint64_t>(st.st_size);
+            mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+            return true;
+        }
+
+        // Parses the leading timestamp column of a CSV row, tolerating quotes.
+        bool parse_leading_timestamp(std::string_view line, int64_t &timestamp)
+        {
+            size_t comma = line.find(',');
+            std::string_view field = line.substr(0, comma);
+            if (field.size() >= 2 && field.front() == '"' && field.back() == '"')
+            {
+                field = field.substr(1, field.size() - 2);
+            }
+            auto result = std::from_chars(field.data(), field.data() + field.size(), timestamp);
+            return result.ec == std::errc();
+        }
+    }
+
+    TimeIndex TimeIndex::load_or_build(const std::string &data_file, uint32_t stride)
+    {
+        TimeIndex index;
+        if (index.load(data_file) && index.stride_ == stride)
+        {
+            return index;
+        }
+
+        Timer build_timer;
+        index = build(data_file, stride);
+        Log::get_logger()->info("TimeIndex: built {} entries for {} in {:.2f} ms.",
+                                index.entries_.size(), data_file, build_timer.elapsed_nanoseconds() / 1e6);
+        index.save(data_file);
+        return index;
+    }
+
+    int64_t TimeIndex::seek(int64_t timestamp) const
+    {
+        if (!sorted_ || entries_.empty())
+        {
+            return data_offset_;
+        }
+        auto it = std::lower_bound(entries_.begin(), entries_.end(), timestamp,
+                                   [](const Entry &entry, int64_t ts)
+                                   { return entry.timestamp < ts; });
+        if (it == entries_.begin())
+        {
+            return data_offset_;
+        }
+        // Rows between the previous entry and `it` may still be >= timestamp.
+        return std::prev(it)->offset;
+    }
+
+    TimeIndex TimeIndex::build(const std::string &data_file, uint32_t stride)
+    {
+        TimeIndex index;
+        index.stride_ = std::max<uint32_t>(stride, 1);
+        if (!stat_file(data_file, index.source_size_, index.source_mtime_))
+        {
+            throw std::runtime_error("TimeIndex: cannot stat " + data_file);
+        }
+        index.data_offset_ = static_cast<int64_t>(index.source_size_);
+
+        PrefetchReader reader(data_file);
+        if (!reader.start())
+        {
+            throw std::runtime_error("TimeIndex: cannot open " + data_file);
+        }
+
+        bool header_skipped = false;
+        uint64_t row = 0;
+        int64_t last_timestamp = std::numeric_limits<int64_t>::min();
+
+        reader.for_each_line([&](std::string_view line, int64_t line_offset)
+                             {
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (line.empty())
+                return true;
+            if (!header_skipped)
+            {
+                header_skipped = true;
+                return true;
+            }
+            int64_t timestamp;
+            if (!parse_leading_timestamp(line, timestamp))
+                return true;
+            if (row == 0)
+                index.data_offset_ = line_offset;
+            if (timestamp < last_timestamp)
+                index.sorted_ = false;
+            last_timestamp = timestamp;
+            if (row % index.stride_ == 0)
+                index.entries_.push_back({timestamp, line_offset});
+            ++row;
+            return true; });
+        reader.stop();
+
+        if (!index.sorted_)
+        {
+            Log::get_logger()->warn("TimeIndex: {} is not sorted by timestamp; range reads will scan from the start.", data_file);
+        }
+        return index;
+    }
+
+    bool TimeIndex::load(const std::string &data_file)
+    {
+        uint64_t size;
+        int64_t mtime;
+        if (!stat_file(data_file, size, mtime))
+            return false;
+
+        std::ifstream in(sidecar_path(data_file), std::ios::binary);
+        if (!in)
+            return false;
+
+        IndexHeader header;
+        if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+            header.version != INDEX_VERSION)
+        {
+            return false;
+        }
+        if (header.source_size != size || header.source_mtime != mtime)
+        {
+            Log::get_logger()->info("TimeIndex: {} changed since it was indexed; rebuilding.", data_file);
+            return false;
+        }
+
+        std::error_code error;
+        const uintmax_t sidecar_size = std::filesystem::file_size(sidecar_path(data_file), error);
+        if (error || header.entry_count > (sidecar_size - sizeof(header)) / sizeof(Entry) ||
+            sizeof(header) + header.entry_count * sizeof(Entry) != sidecar_size)
+        {
+            Log::get_logger()->warn("TimeIndex: sidecar for {} does not match its header; rebuilding.", data_file);
+            return false;
+        }
+        entries_.resize(header.entry_count);
+        if (!in.read(reinterpret_cast<char *>(entries_.data()), static_cast<std::streamsize>(entries_.size() * sizeof(Entry))))
+        {
+            entries_.clear();
+            return false;
+        }
+
+        stride_ = header.stride;
+        source_size_ = header.source_size;
+        source_mtime_ = header.source_mtime;
+        data_offset_ = header.data_offset;
+        sorted_ = header.sorted != 0;
+        loaded_from_disk_ = true;
+        return true;
+    }
+
+    void TimeIndex::save(const std::string &data_file) const
+    {
+        IndexHeader header{};
+        std::memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        header.version = INDEX_VERSION;
+        header.stride = stride_;
+        header.source_size = source_size_;
+        header.source_mtime = source_mtime_;
+        header.data_offset = data_offset_;
+        header.entry_count = entries_.size();
+        header.sorted = sorted_ ? 1 : 0;
+
+        // Write to a temporary file and rename so concurrent readers never see a partial index.
+        std::string final_path = sidecar_path(data_file);
+        std::string tmp_path = final_path + ".tmp";
+        {
+            std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                Log::get_logger()->warn("TimeIndex: cannot write {}; index will be rebuilt next time.", final_path);
+                return;
+            }
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(entries_.data()), static_cast<std::streamsize>(entries_.size() * sizeof(Entry)));
+        }
+        std::rename(tmp_path.c_str(), final_path.c_str());
+    }
+
+} // namespace hft_system
@@ -1,18 +1,98 @@
 #include "../../include/data/WebSocketDataHandler.h"
 #include "../../include/core/Log.h"
-#include "simdjson.h"
+#include "../../include/core/SymbolRegistry.h"
 #include <algorithm>
 #include "../../include/core/Utils.h"
+#include <cpr/cpr.h>
+#include <fstream>
+#include <sstream>
 #include <string>
 
 namespace hft_system
 {
+    namespace
+    {
+        // Stream names are lower case; symbols in payloads and REST calls are upper case.
+        std::string to_upper(std::string text)
+        {
+            std::transform(text.begin(), text.end(), text.begin(),
+                           [](unsigned char c)
+                           { return std::toupper(c); });
+            return text;
+        }
+
+        std::string to_lower(std::string text)
+        {
+            std::transform(text.begin(), text.end(), text.begin(),
+                           [](unsigned char c)
+                           { return std::tolower(c); });
+            return text;
+        }
+    }
+
+    std::vector<std::string> WebSocketDataHandler::subscribed_symbols(const WebSocketConfig &config)
+    {
+        std::vector<std::string> symbols;
+        for (const auto &symbol : config.symbols.empty() ? std::vector<std::string>{config.symbol} : config.symbols)
+        {
+            std::string name = to_upper(symbol);
+            if (!name.empty() && std::find(symbols.begin(), symbols.end(), name) == symbols.end())
+                symbols.push_back(std::move(name));
+        }
+        return symbols;
+    }
 
     WebSocketDataHandler::WebSocketDataHandler(std::shared_ptr<EventBus> event_bus, const WebSocketConfig &config)
         : DataHandler(event_bus, "WebSocketDataHandler"),
-          config_(config),
-          resolver_(net::make_strand(ioc_)),
-          ws_(net::make_strand(ioc_), ctx_) {}
+          config_(config)
+    {
+        const std::vector<std::string> symbols = subscribed_symbols(config_);
+        const size_t connection_count = std::clamp<size_t>(static_cast<size_t>(std::max(config_.connections, 1)), 1,
+                                                           std::max<size_t>(symbols.size(), 1));
+        for (size_t i = 0; i < connection_count; ++i)
+        {
+            connections_.push_back(std::make_unique<Connection>(*this, ctx_));
+            connections_.back()->index = i;
+        }
+
+        for (size_t i = 0; i < symbols.size(); ++i)
+        {
+            // Levels are parsed, recorded and published on the symbol's registered tick/lot grid.
+            Connection &connection = *connections_[i % connection_count];
+            for (const auto &type : config_.streams)
+            {
+                std::string name = to_lower(symbols[i]) + "@" + type;
+                if (!connection.processor.add_stream(name))
+                    Log::get_logger()->error("Ignoring unsupported stream {}", name);
+            }
+
+            StreamProcessor::Feed *feed = connection.processor.find_feed(symbols[i]);
+            if (!config_.record_path.empty() && feed && feed->has_depth)
+            {
+                const InstrumentSpec &spec = feed->snapshot_decoder.spec();
+                std::string path = symbols.size() == 1 ? config_.record_path : config_.record_path + "." + symbols[i];
+                feed->recorder = std::make_unique<TickWriter>(path, symbols[i], spec.price_tick, spec.qty_lot);
+            }
+            if (!config_.snapshot_file.empty() && feed)
+            {
+                // One recorded snapshot per symbol, named like the tick recordings.
+                feed->snapshot_file = symbols.size() == 1 ? config_.snapshot_file : config_.snapshot_file + "." + symbols[i];
+            }
+        }
+
+        for (auto &connection : connections_)
+        {
+            connection->subscribe_message = connection->processor.subscribe_message();
+            if (!config_.capture_path.empty())
+            {
+                CaptureWriter::Options options;
+                options.base_path = config_.capture_path + "." + std::to_string(connection->index);
+                options.segment_bytes = config_.capture_segment_bytes;
+                options.max_segments = config_.capture_max_segments;
+                connection->capture = std::make_unique<CaptureWriter>(options);
+            }
+        }
+    }
 
     WebSocketDataHandler::~WebSocketDataHandler()
     {
@@ -21,169 +101,351 @@ namespace hft_system
 
     void WebSocketDataHandler::start()
     {
-        Log::get_logger()->info("Connecting to {}:{}", config_.host, config_.port);
-        resolver_.async_resolve(config_.host, std::to_string(config_.port),
-                                beast::bind_front_handler(&WebSocketDataHandler::on_resolve, shared_from_this()));
-        ioc_thread_ = std::thread([this]()
-                                  { ioc_.run(); });
+        for (auto &connection : connections_)
+        {
+            for (const auto &feed : connection->processor.feeds())
+            {
+                if (feed->recorder && feed->recorder->open())
+                {
+                    Log::get_logger()->info("Recording {} order books to {}", feed->local_book.symbol(), config_.record_path);
+                }
+            }
+            if (connection->capture && connection->capture->start())
+            {
+                Log::get_logger()->info("Connection {}: capturing raw frames to {}.{}.*", connection->index,
+                                        config_.capture_path, connection->index);
+            }
+        }
+        if (!config_.capture_path.empty())
+        {
+            // Journals of connections an earlier run had beyond this one's, which a replay would also merge in.
+            for (size_t index = connections_.size();; ++index)
+            {
+                if (CaptureWriter::remove_journal(config_.capture_path + "." + std::to_string(index)) == 0)
+                    break;
+            }
+        }
+        started_at_ = std::chrono::steady_clock::now();
+        running_.store(true);
+        for (auto &connection : connections_)
+        {
+            if (connection->processor.stream_count() == 0)
+                continue;
+            connect(connection.get());
+            connection->thread = std::thread([conn = connection.get()]()
+                                             { conn->ioc.run(); });
+        }
+    }
+
+    void WebSocketDataHandler::connect(Connection *connection)
+    {
+        Log::get_logger()->info("Connection {}: connecting to {}:{} for {} streams", connection->index, config_.host,
+                                config_.port, connection->processor.stream_count());
+        connection->resolver.async_resolve(config_.host, std::to_string(config_.port),
+                                           beast::bind_front_handler(&WebSocketDataHandler::on_resolve, shared_from_this(), connection, connection->session));
     }
 
     void WebSocketDataHandler::stop()
     {
-        if (!ioc_.stopped())
+        bool was_running = false;
+        running_.store(false);
+        for (auto &connection : connections_)
         {
-            net::dispatch(ioc_, [this]()
-                          {
-            beast::error_code ec;
-            ws_.close(websocket::close_code::normal, ec);
-            if (ec) fail(ec, "close"); });
+            if (!connection->ioc.stopped())
+            {
+                net::dispatch(connection->ioc, [conn = connection.get()]()
+                              {
+                conn->reconnect_timer.cancel();
+                conn->visit_ws([](auto &ws)
+                               {
+                    if (!ws.is_open() || !beast::get_lowest_layer(ws).is_open())
+                        return; // Between sessions
+                    beast::error_code ec;
+                    ws.close(websocket::close_code::normal, ec);
+                    if (ec) fail(ec, "close"); }); });
+            }
+            if (connection->thread.joinable())
+            {
+                connection->thread.join();
+                was_running = true;
+            }
+            for (const auto &feed : connection->processor.feeds())
+            {
+                for (auto &thread : feed->snapshot_threads)
+                {
+                    thread.join();
+                }
+                feed->snapshot_threads.clear();
+                if (feed->recorder)
+                {
+                    feed->recorder->close();
+                }
+            }
+            if (connection->capture)
+            {
+                connection->capture->stop();
+                if (connection->capture->records_dropped() > 0)
+                    Log::get_logger()->warn("Connection {}: capture dropped {} of {} records.", connection->index,
+                                            connection->capture->records_dropped(),
+                                            connection->capture->records_written() + connection->capture->records_dropped());
+            }
         }
-        if (ioc_thread_.joinable())
+
+        if (was_running)
         {
-            ioc_thread_.join();
+            for (const auto &[stream, stats] : get_stream_statistics())
+            {
+                Log::get_logger()->info("  {}: {} messages ({:.1f}/s), parse avg {:.0f} ns, max {:.0f} ns",
+                                        stream, static_cast<long>(stats.at("messages")), stats.at("msgs_per_sec"),
+                                        stats.at("avg_parse_ns"), stats.at("max_parse_ns"));
+            }
         }
     }
 
-    void WebSocketDataHandler::run() {} // Async operations are managed by io_context
+    void WebSocketDataHandler::run() {} // Async operations are managed by the connections' io_contexts
+
+    std::map<std::string, std::map<std::string, double>> WebSocketDataHandler::get_stream_statistics() const
+    {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started_at_).count();
+        std::map<std::string, std::map<std::string, double>> results;
+        for (const auto &connection : connections_)
+            connection->processor.collect_statistics(seconds, results);
+        return results;
+    }
+
+    int64_t WebSocketDataHandler::reconnect_count() const
+    {
+        int64_t total = 0;
+        for (const auto &connection : connections_)
+            total += connection->reconnects.load(std::memory_order_relaxed);
+        return total;
+    }
 
-    void WebSocketDataHandler::on_resolve(beast::error_code ec, tcp::resolver::results_type results)
+    uint64_t WebSocketDataHandler::gap_count() const
     {
+        uint64_t total = 0;
+        for (const auto &connection : connections_)
+            total += connection->processor.gap_count();
+        return total;
+    }
+
+    void WebSocketDataHandler::on_resolve(Connection *connection, uint64_t session, beast::error_code ec, tcp::resolver::results_type results)
+    {
+        if (session != connection->session)
+            return; // Completion from a session that has since been replaced
         if (ec)
-            return fail(ec, "resolve");
-        net::async_connect(
-            beast::get_lowest_layer(ws_),
-            results.begin(), results.end(),
-            beast::bind_front_handler(&WebSocketDataHandler::on_connect, shared_from_this()));
+            return schedule_reconnect(connection, session, ec, "resolve");
+        connection->visit_ws([&](auto &ws)
+                             { net::async_connect(beast::get_lowest_layer(ws), results.begin(), results.end(),
+                                                  beast::bind_front_handler(&WebSocketDataHandler::on_connect, shared_from_this(), connection, connection->session)); });
     }
 
-    void WebSocketDataHandler::on_connect(beast::error_code ec, tcp::resolver::results_type::iterator)
+    void WebSocketDataHandler::on_connect(Connection *connection, uint64_t session, beast::error_code ec, tcp::resolver::results_type::iterator)
     {
+        if (session != connection->session)
+            return; // Completion from a session that has since been replaced
         if (ec)
-            return fail(ec, "connect");
-        if (!SSL_set_tlsext_host_name(ws_.next_layer().native_handle(), config_.host.c_str()))
+            return schedule_reconnect(connection, session, ec, "connect");
+        if (!connection->tls_ws)
+            return websocket_handshake(connection);
+        if (!SSL_set_tlsext_host_name(connection->tls_ws->next_layer().native_handle(), config_.host.c_str()))
         {
             ec = beast::error_code(static_cast<int>(ERR_get_error()), net::error::get_ssl_category());
-            return fail(ec, "set_sni");
+            return schedule_reconnect(connection, session, ec, "set_sni");
         }
-        ws_.next_layer().async_handshake(ssl::stream_base::client,
-                                         beast::bind_front_handler(&WebSocketDataHandler::on_ssl_handshake, shared_from_this()));
+        connection->tls_ws->next_layer().async_handshake(ssl::stream_base::client,
+                                                         beast::bind_front_handler(&WebSocketDataHandler::on_ssl_handshake, shared_from_this(), connection, connection->session));
     }
 
-    void WebSocketDataHandler::on_ssl_handshake(beast::error_code ec)
+    void WebSocketDataHandler::on_ssl_handshake(Connection *connection, uint64_t session, beast::error_code ec)
     {
+        if (session != connection->session)
+            return; // Completion from a session that has since been replaced
         if (ec)
-            return fail(ec, "ssl_handshake");
-        ws_.async_handshake(config_.host, config_.target,
-                            beast::bind_front_handler(&WebSocketDataHandler::on_handshake, shared_from_this()));
+            return schedule_reconnect(connection, session, ec, "ssl_handshake");
+        websocket_handshake(connection);
     }
 
-    void WebSocketDataHandler::on_handshake(beast::error_code ec)
+    void WebSocketDataHandler::websocket_handshake(Connection *connection)
     {
-        if (ec)
-            return fail(ec, "handshake");
-        Log::get_logger()->info("WebSocket Handshake successful.");
-
-        // **THE FIX IS HERE:** Manually build the JSON subscription string.
-        std::string symbol_lower = config_.symbol;
-        std::transform(symbol_lower.begin(), symbol_lower.end(), symbol_lower.begin(),
-                       [](unsigned char c)
-                       { return std::tolower(c); });
-
-        std::string subscribe_msg =
-            R"({"method":"SUBSCRIBE","params":[")" +
-            symbol_lower +
-            R"(@depth"],"id":1})";
+        connection->visit_ws([&](auto &ws)
+                             { ws.async_handshake(config_.host, config_.target,
+                                                  beast::bind_front_handler(&WebSocketDataHandler::on_handshake, shared_from_this(), connection, connection->session)); });
+    }
 
-        Log::get_logger()->info("Sending subscription message: {}", subscribe_msg);
+    void WebSocketDataHandler::on_handshake(Connection *connection, uint64_t session, beast::error_code ec)
+    {
+        if (session != connection->session)
+            return; // Completion from a session that has since been replaced
+        if (ec)
+            return schedule_reconnect(connection, session, ec, "handshake");
+        Log::get_logger()->info("Connection {}: WebSocket handshake successful.", connection->index);
+        connection->reconnect_attempts = 0;
+        Log::get_logger()->info("Sending subscription message: {}", connection->subscribe_message);
+        capture(*connection, CaptureRecord::Kind::SUBSCRIBE, connection->subscribe_message);
 
-        ws_.async_write(net::buffer(subscribe_msg),
-                        beast::bind_front_handler(&WebSocketDataHandler::on_write, shared_from_this()));
+        connection->visit_ws([&](auto &ws)
+                             { ws.async_write(net::buffer(connection->subscribe_message),
+                                              beast::bind_front_handler(&WebSocketDataHandler::on_write, shared_from_this(), connection, connection->session)); });
     }
 
-    void WebSocketDataHandler::on_write(beast::error_code ec, std::size_t)
+    void WebSocketDataHandler::on_write(Connection *connection, uint64_t session, beast::error_code ec, std::size_t)
     {
+        if (session != connection->session)
+            return; // Completion from a session that has since been replaced
         if (ec)
-            return fail(ec, "write");
-        ws_.async_read(buffer_, beast::bind_front_handler(&WebSocketDataHandler::on_read, shared_from_this()));
+            return schedule_reconnect(connection, session, ec, "write");
+        // Diffs start arriving now and are buffered until each snapshot lands.
+        connection->processor.request_snapshots();
+        connection->visit_ws([&](auto &ws)
+                             { ws.async_read(connection->buffer,
+                                             beast::bind_front_handler(&WebSocketDataHandler::on_read, shared_from_this(), connection, connection->session)); });
     }
 
-    void WebSocketDataHandler::on_read(beast::error_code ec, std::size_t)
+    void WebSocketDataHandler::on_read(Connection *connection, uint64_t session, beast::error_code ec, std::size_t)
     {
+        if (session != connection->session)
+            return; // Completion from a session that has since been replaced
         if (ec)
-            return fail(ec, "read");
+            return schedule_reconnect(connection, session, ec, "read");
 
-        std::string message = beast::buffers_to_string(buffer_.data());
-        process_message(message);
+        // Parse the frame where it landed. prepare() only reallocates when the
+        // buffer is too small, and guarantees the padding simdjson reads past the end.
+        connection->buffer.prepare(simdjson::SIMDJSON_PADDING);
+        auto frame = connection->buffer.data();
+        const char *data = static_cast<const char *>(frame.data());
+        capture(*connection, CaptureRecord::Kind::FRAME, std::string_view(data, frame.size()));
+        connection->processor.process_frame(data, frame.size(), BinanceStreamDecoder::padded_capacity(frame.size()));
 
-        buffer_.consume(buffer_.size());
-        ws_.async_read(buffer_, beast::bind_front_handler(&WebSocketDataHandler::on_read, shared_from_this()));
+        connection->buffer.consume(connection->buffer.size());
+        connection->visit_ws([&](auto &ws)
+                             { ws.async_read(connection->buffer,
+                                             beast::bind_front_handler(&WebSocketDataHandler::on_read, shared_from_this(), connection, connection->session)); });
     }
 
-    void WebSocketDataHandler::on_close(beast::error_code ec)
+    void WebSocketDataHandler::schedule_reconnect(Connection *connection, uint64_t session, beast::error_code ec, const char *what)
     {
-        if (ec)
-            return fail(ec, "close");
-        Log::get_logger()->info("WebSocket connection closed.");
-    }
+        if (!running_.load() || session != connection->session)
+            return; // Shutting down, or the session is already being replaced
 
-    void WebSocketDataHandler::process_message(const std::string &message)
-    {
-        try
+        // From here on, completions of the lost session are dropped unprocessed.
+        ++connection->session;
+        // Nothing from the lost session can be trusted: strategies see the books go empty.
+        connection->processor.reset();
+        connection->visit_ws([](auto &ws)
+                             {
+            beast::error_code ignored;
+            beast::get_lowest_layer(ws).close(ignored); });
+
+        const std::string reason = ec ? std::string(what) + ": " + ec.message() : std::string(what);
+        if (config_.max_reconnects >= 0 && connection->reconnect_attempts >= config_.max_reconnects)
         {
-            simdjson::padded_string padded_message(message);
-            simdjson::ondemand::parser parser;
-            simdjson::ondemand::document doc = parser.iterate(padded_message);
+            Log::get_logger()->error("Connection {}: {}; giving up after {} reconnect attempts.", connection->index, reason,
+                                     connection->reconnect_attempts);
+            return;
+        }
 
-            // Check for subscription confirmation first
-            if (doc.find_field("result").error() == simdjson::SUCCESS)
-            {
-                Log::get_logger()->info("Subscription confirmed.");
-                return;
-            }
+        // Exponential backoff, doubling from reconnect_initial_ms up to reconnect_max_ms.
+        const int64_t initial = std::max(config_.reconnect_initial_ms, 1);
+        const int64_t delay_ms = std::min<int64_t>(initial << std::min(connection->reconnect_attempts, 20),
+                                                   std::max<int64_t>(config_.reconnect_max_ms, initial));
+        ++connection->reconnect_attempts;
+        Log::get_logger()->warn("Connection {}: {}; reconnecting in {} ms (attempt {}).", connection->index, reason, delay_ms,
+                                connection->reconnect_attempts);
+        connection->reconnect_timer.expires_after(std::chrono::milliseconds(delay_ms));
+        connection->reconnect_timer.async_wait(beast::bind_front_handler(&WebSocketDataHandler::on_reconnect_timer, shared_from_this(), connection));
+    }
 
-            // --- THE FIX IS HERE ---
-            // We now parse the data from the top level of the document, not a nested "data" object.
-            std::string_view event_type;
-            if (doc["e"].get_string().get(event_type) != simdjson::SUCCESS || event_type != "depthUpdate")
-            {
-                return; // Not an order book message, ignore it.
-            }
+    void WebSocketDataHandler::on_reconnect_timer(Connection *connection, beast::error_code ec)
+    {
+        if (ec || !running_.load())
+            return;
+        connection->reconnects.fetch_add(1, std::memory_order_relaxed);
+        connection->make_stream(ctx_, config_.use_tls);
+        connection->buffer.consume(connection->buffer.size());
+        connect(connection);
+    }
 
-            OrderBook book;
-            std::string_view symbol_sv;
-            doc["s"].get_string().get(symbol_sv);
-            book.symbol = symbol_sv;
-            book.timestamp = doc["E"].get_int64();
+    void WebSocketDataHandler::capture(Connection &connection, CaptureRecord::Kind kind, std::string_view data)
+    {
+        if (!connection.capture)
+            return;
+        int64_t receive_time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::system_clock::now().time_since_epoch())
+                                   .count();
+        connection.capture->append(kind, receive_time, data);
+    }
 
-            for (auto bid_level : doc["b"].get_array())
-            {
-                auto level_array = bid_level.get_array();
-                double price = std::stod(std::string(level_array.at(0).get_string().value()));
-                double qty = std::stod(std::string(level_array.at(1).get_string().value()));
-                if (qty > 1e-9)
-                    book.bids.push_back({price, qty});
-            }
+    void WebSocketDataHandler::request_snapshot(Connection &connection, StreamProcessor::Feed &feed)
+    {
+        const std::string &symbol = feed.local_book.symbol();
 
-            for (auto ask_level : doc["a"].get_array())
+        if (!feed.snapshot_file.empty())
+        {
+            // A recorded snapshot can seed a session's book once; a later gap needs a new session.
+            if (feed.snapshot_file_used)
             {
-                auto level_array = ask_level.get_array();
-                double price = std::stod(std::string(level_array.at(0).get_string().value()));
-                double qty = std::stod(std::string(level_array.at(1).get_string().value()));
-                if (qty > 1e-9)
-                    book.asks.push_back({price, qty});
+                Log::get_logger()->warn("{}: cannot resynchronise from recorded snapshot {}.", symbol, feed.snapshot_file);
+                net::post(connection.ioc, [self = shared_from_this(), connection = &connection, session = connection.session]()
+                          { self->schedule_reconnect(connection, session, {}, "depth gap"); });
+                return;
             }
-            // --- END OF FIX ---
+            feed.snapshot_file_used = true;
+            std::ifstream in(feed.snapshot_file);
+            std::stringstream contents;
+            contents << in.rdbuf();
+            if (!in)
+                Log::get_logger()->error("Cannot read depth snapshot file {}", feed.snapshot_file);
+            deliver_snapshot(connection, feed, contents.str());
+            return;
+        }
 
-            if (!book.bids.empty() || !book.asks.empty())
-            {
-                auto ob_event = std::make_shared<OrderBookEvent>(book);
-                event_bus_->publish(ob_event);
-            }
+        std::string url = config_.rest_url + "?symbol=" + symbol + "&limit=" + std::to_string(config_.snapshot_limit);
+
+        // The REST call blocks, so it runs off the io thread and posts the body back to the connection's thread.
+        // A fetch from an earlier session may still be running; it is left to finish and is joined by its own
+        // completion, so the io thread never waits on the network.
+        feed.snapshot_threads.emplace_back([self = shared_from_this(), connection = &connection, feed = &feed, url,
+                                            session = connection.session, timeout = config_.snapshot_timeout_ms]()
+                                           {
+            Log::get_logger()->info("Requesting depth snapshot: {}", url);
+            cpr::Response r = cpr::Get(cpr::Url{url}, cpr::Timeout{timeout});
+            std::string body;
+            if (r.status_code == 200)
+                body = std::move(r.text);
+            else
+                Log::get_logger()->error("Failed to fetch depth snapshot. Status code: {} {}", r.status_code, r.error.message);
+            net::post(connection->ioc, [self, connection, feed, session, fetcher = std::this_thread::get_id(), body = std::move(body)]()
+                      {
+                // The fetch thread has nothing left to do but exit.
+                auto &threads = feed->snapshot_threads;
+                auto it = std::find_if(threads.begin(), threads.end(), [fetcher](const std::thread &thread)
+                                       { return thread.get_id() == fetcher; });
+                if (it != threads.end())
+                {
+                    it->join();
+                    threads.erase(it);
+                }
+                if (session == connection->session) // Otherwise the book has been reset since the request
+                    self->deliver_snapshot(*connection, *feed, body); }); });
+    }
+
+    void WebSocketDataHandler::deliver_snapshot(Connection &connection, StreamProcessor::Feed &feed, const std::string &body)
+    {
+        if (connection.capture)
+        {
+            // Journaled at the point it is applied, so a replay sees it between the same frames.
+            std::string record = feed.local_book.symbol();
+            record.push_back('\0');
+            record += body;
+            capture(connection, CaptureRecord::Kind::SNAPSHOT, record);
         }
-        catch (const std::exception &e)
+        if (!connection.processor.on_snapshot(feed, body))
         {
-            Log::get_logger()->error("Error parsing WebSocket message: {}", e.what());
+            // Posted rather than called: this may run inside the processor's own snapshot request.
+            net::post(connection.ioc, [self = shared_from_this(), connection = &connection, session = connection.session]()
+                      { self->schedule_reconnect(connection, session, {}, "depth snapshot"); });
         }
     }
 
-} // namespace hft_system
\ No newline at end of file
+} // namespace hft_system
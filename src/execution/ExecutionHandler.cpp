@@ -1,6 +1,7 @@
 #include "../../include/execution/ExecutionHandler.h"
 #include "../../include/config/Config.h"
 #include "../../include/core/Log.h"
+#include "../../include/core/SymbolRegistry.h"
 #include "../../include/utils/Timer.h"
 #include "../../include/utils/PerformanceMonitor.h"
 #include <functional>
@@ -33,26 +34,29 @@ namespace hft_system
         TIME_FUNCTION("ExecutionHandler_on_order");
 
         const auto &order = static_cast<const OrderEvent &>(event);
+        const InstrumentSpec spec = instrument_spec(order.symbol_id);
         Log::get_logger()->info("{}: Received order to {} {} {}.", name_,
                                 order.direction == OrderDirection::BUY ? "BUY" : "SELL",
-                                order.quantity, order.symbol);
+                                spec.to_double(order.quantity), symbol_name(order.symbol_id));
 
-        double slippage = order.market_price * config_.slippage_pct;
-        double fill_price = 0.0;
+        double market_price = spec.to_double(order.market_price);
+        double slippage = market_price * config_.slippage_pct;
+        Price fill_price;
 
+        // Slippage is applied in price space and the fill lands back on the tick grid
         if (order.direction == OrderDirection::BUY)
         {
-            fill_price = order.market_price + slippage;
+            fill_price = spec.to_price(market_price + slippage);
         }
         else
         {
-            fill_price = order.market_price - slippage;
+            fill_price = spec.to_price(market_price - slippage);
         }
 
-        double commission = fill_price * order.quantity * config_.commission_pct;
+        double commission = spec.notional(fill_price, order.quantity) * config_.commission_pct;
 
         auto fill = std::make_shared<FillEvent>(
-            order.symbol,
+            order.symbol_id,
             order.direction,
             order.quantity,
             fill_price,
@@ -60,7 +64,7 @@ namespace hft_system
 
         event_bus_->publish(fill);
         Log::get_logger()->info("{}: Published fill event for {}. Fill Price (with slippage): ${}, Commission: ${}",
-                                name_, order.symbol, fill_price, commission);
+                                name_, symbol_name(order.symbol_id), spec.to_double(fill_price), commission);
     }
 
 } // namespace hft_system
\ No newline at end of file
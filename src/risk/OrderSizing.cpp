@@ -0,0 +1,30 @@
+#include "../../include/risk/OrderSizing.h"
+#include <algorithm>
+
+namespace hft_system
+{
+
+    OrderSizing size_order(double risk_amount, double cash, Price price, const InstrumentSpec &spec)
+    {
+        // Define minimum order requirements (these should ideally come from config)
+        const double MIN_BTC_QUANTITY = 0.001; // Binance minimum for BTC
+        const double MIN_ORDER_VALUE = 10.0;   // $10 minimum order value
+
+        OrderSizing sizing;
+        const double market_price = spec.to_double(price);
+        sizing.raw_quantity = risk_amount / market_price;
+
+        // Whole lots within the risk amount, raised if need be to the fewest
+        // whole lots that meet the minimum quantity and order value
+        const Quantity risk_lots = spec.to_quantity_floor(sizing.raw_quantity);
+        const Quantity minimum_lots = spec.to_quantity_ceil(std::max(MIN_BTC_QUANTITY, MIN_ORDER_VALUE / market_price));
+        sizing.quantity = std::max(risk_lots, minimum_lots);
+        sizing.notional = spec.notional(price, sizing.quantity);
+        if (sizing.quantity.value <= 0)
+            sizing.result = OrderSizing::Result::ZERO_QUANTITY;
+        else if (sizing.notional > cash)
+            sizing.result = OrderSizing::Result::INSUFFICIENT_CASH;
+        return sizing;
+    }
+
+} // namespace hft_system
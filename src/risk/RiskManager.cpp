@@ -1,5 +1,7 @@
 #include "../../include/risk/RiskManager.h"
+#include "../../include/risk/OrderSizing.h"
 #include "../../include/core/Log.h"
+#include "../../include/core/SymbolRegistry.h"
 #include "../../include/utils/Timer.h"
 #include "../../include/utils/PerformanceMonitor.h"
 #include <functional>
@@ -29,19 +31,37 @@ namespace hft_system
     void RiskManager::on_market(const Event &event)
     {
         const auto &market = static_cast<const MarketEvent &>(event);
-        latest_prices_[market.symbol] = market.price;
+        const InstrumentSpec &spec = spec_for(market.symbol_id);
+        latest_prices_[market.symbol_id] = spec.to_price(market.price);
     }
 
     void RiskManager::on_order_book(const Event &event)
     {
         const auto &order_book = static_cast<const OrderBookEvent &>(event);
+        spec_for(order_book.book.symbol_id);
+        // An empty book means the feed lost sync; nothing is sized off it until it recovers.
+        book_unavailable_[order_book.book.symbol_id] = order_book.book.bids.empty() && order_book.book.asks.empty();
         if (!order_book.book.bids.empty())
         {
             // Use the best bid price as the current market price
-            latest_prices_[order_book.book.symbol] = order_book.book.bids[0].price;
+            latest_prices_[order_book.book.symbol_id] = order_book.book.bids.price[0];
         }
     }
 
+    const InstrumentSpec &RiskManager::spec_for(SymbolId symbol_id)
+    {
+        if (symbol_id >= specs_.size())
+        {
+            size_t first_new = specs_.size();
+            specs_.resize(symbol_id + 1);
+            latest_prices_.resize(symbol_id + 1);
+            book_unavailable_.resize(symbol_id + 1);
+            for (size_t id = first_new; id < specs_.size(); ++id)
+                specs_[id] = instrument_spec(static_cast<SymbolId>(id));
+        }
+        return specs_[symbol_id];
+    }
+
     void RiskManager::on_portfolio_update(const Event &event)
     {
         const auto &update = static_cast<const PortfolioUpdateEvent &>(event);
@@ -56,13 +76,21 @@ namespace hft_system
         
         const auto &signal = static_cast<const SignalEvent &>(event);
 
-        if (latest_prices_.find(signal.symbol) == latest_prices_.end())
+        const SymbolId symbol_id = signal.symbol_id;
+        const InstrumentSpec &spec = spec_for(symbol_id);
+        const Price price = latest_prices_[symbol_id];
+        if (price.value <= 0)
         {
-            Log::get_logger()->warn("{}: Rejecting signal for {}. No market price available.", name_, signal.symbol);
+            Log::get_logger()->warn("{}: Rejecting signal for {}. No market price available.", name_, symbol_name(symbol_id));
+            return;
+        }
+        if (book_unavailable_[symbol_id])
+        {
+            Log::get_logger()->warn("{}: Rejecting signal for {}. Order book is resynchronising.", name_, symbol_name(symbol_id));
             return;
         }
 
-        double market_price = latest_prices_.at(signal.symbol);
+        double market_price = spec.to_double(price);
 
         // Calculate base risk amount
         double base_risk_amount = latest_equity_ * risk_config_.risk_per_trade_pct;
@@ -71,45 +99,33 @@ namespace hft_system
         // Apply ML confidence if enabled
         if (risk_config_.use_dynamic_sizing && ml_manager_)
         {
-            double confidence = ml_manager_->get_trade_confidence(signal.symbol);
-            Log::get_logger()->debug("{}: ML Model confidence for {} is {:.2f}", name_, signal.symbol, confidence);
+            double confidence = ml_manager_->get_trade_confidence(symbol_id);
+            Log::get_logger()->debug("{}: ML Model confidence for {} is {:.2f}", name_, symbol_name(symbol_id), confidence);
             final_risk_amount *= confidence;
         }
 
-        // Calculate quantity as double first, then apply minimum constraints
-        double raw_quantity = final_risk_amount / market_price;
-
-        // Define minimum order requirements (these should ideally come from config)
-        const double MIN_BTC_QUANTITY = 0.001; // Binance minimum for BTC
-        const double MIN_ORDER_VALUE = 10.0;   // $10 minimum order value
-
-        // Apply minimum quantity constraint
-        double quantity = std::max(raw_quantity, MIN_BTC_QUANTITY);
-
-        // Check if order meets minimum value requirement
-        double order_value = quantity * market_price;
-        if (order_value < MIN_ORDER_VALUE)
-        {
-            quantity = MIN_ORDER_VALUE / market_price;
-            order_value = quantity * market_price;
-        }
+        // Minimum quantity and order value, whole lots and the cash check
+        const OrderSizing sizing = size_order(final_risk_amount, latest_cash_, price, spec);
+        const Quantity order_quantity = sizing.quantity;
+        double quantity = spec.to_double(order_quantity);
+        double order_value = sizing.notional;
 
         // Debug logging to help troubleshoot
         Log::get_logger()->debug("{}: Risk calculation for {}: Equity=${:.2f}, Risk%={:.4f}, RiskAmount=${:.2f}, Price=${:.2f}, RawQty={:.6f}, FinalQty={:.6f}, OrderValue=${:.2f}",
-                                 name_, signal.symbol, latest_equity_, risk_config_.risk_per_trade_pct,
-                                 final_risk_amount, market_price, raw_quantity, quantity, order_value);
+                                 name_, symbol_name(symbol_id), latest_equity_, risk_config_.risk_per_trade_pct,
+                                 final_risk_amount, market_price, sizing.raw_quantity, quantity, order_value);
 
         // Final validation checks
-        if (quantity <= 0)
+        if (sizing.result == OrderSizing::Result::ZERO_QUANTITY)
         {
-            Log::get_logger()->warn("{}: Calculated quantity is zero or negative for {}. No order generated.", name_, signal.symbol);
+            Log::get_logger()->warn("{}: Calculated quantity is zero or negative for {}. No order generated.", name_, symbol_name(symbol_id));
             return;
         }
 
-        if (order_value > latest_cash_)
+        if (sizing.result == OrderSizing::Result::INSUFFICIENT_CASH)
         {
             Log::get_logger()->warn("{}: Rejecting signal for {}. Insufficient cash. Required: ${:.2f}, Available: ${:.2f}",
-                                    name_, signal.symbol, order_value, latest_cash_);
+                                    name_, symbol_name(symbol_id), order_value, latest_cash_);
             return;
         }
 
@@ -122,10 +138,9 @@ namespace hft_system
         // }
 
         Log::get_logger()->info("{}: Signal for {} approved. Quantity: {:.6f} units, Value: ${:.2f}",
-                                name_, signal.symbol, quantity, order_value);
+                                name_, symbol_name(symbol_id), quantity, order_value);
 
-        // Create order with double precision quantity
-        auto order = std::make_shared<OrderEvent>(signal.symbol, signal.direction, quantity, market_price);
+        auto order = std::make_shared<OrderEvent>(symbol_id, signal.direction, order_quantity, price);
         event_bus_->publish(order);
     }
 
@@ -0,0 +1,253 @@
+#include "../../include/strategy/BookKernels.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HFT_BOOK_KERNELS_AVX2 1
+#include <immintrin.h>
+#define HFT_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace hft_system
+{
+    namespace
+    {
+        static_assert(MAX_BOOK_DEPTH % 4 == 0, "vector kernels read the book sides in blocks of four levels");
+
+        // Per-side sums the features are finished from.
+        struct SideSums
+        {
+            double depth = 0.0;    // Σ q
+            double notional = 0.0; // Σ p·q
+            double filled = 0.0;   // Σ fill, the part of each level the VWAP size takes
+            double fill_cost = 0.0;
+            double sx = 0.0, sy = 0.0, sxy = 0.0, sxx = 0.0; // x: ticks from the best, y: cumulative size
+            double pressure = 0.0;                           // Σ q / distance from the mid
+        };
+
+        double slope(const SideSums &sums, size_t levels)
+        {
+            const double n = static_cast<double>(levels);
+            const double denominator = n * sums.sxx - sums.sx * sums.sx;
+            return levels >= 2 && denominator > 0.0 ? (n * sums.sxy - sums.sx * sums.sy) / denominator : 0.0;
+        }
+
+        void finish(const SideSums &bid, const SideSums &ask, BookFeatures &out)
+        {
+            const double bid_vwap = bid.notional / bid.depth;
+            const double ask_vwap = ask.notional / ask.depth;
+            out.depth_weighted_mid = (bid_vwap * ask.depth + ask_vwap * bid.depth) / (bid.depth + ask.depth);
+            out.buy_fillable = std::llround(ask.filled);
+            out.buy_vwap = ask.filled > 0.0 ? ask.fill_cost / ask.filled : 0.0;
+            out.sell_fillable = std::llround(bid.filled);
+            out.sell_vwap = bid.filled > 0.0 ? bid.fill_cost / bid.filled : 0.0;
+            out.bid_slope = slope(bid, out.bid_levels);
+            out.ask_slope = slope(ask, out.ask_levels);
+            const double pressure = bid.pressure + ask.pressure;
+            out.pressure = pressure > 0.0 ? (bid.pressure - ask.pressure) / pressure : 0.0;
+        }
+
+        // Common prologue: levels per side and the mid. False if a side is empty.
+        bool prepare(const OrderBook &book, size_t levels, BookFeatures &out, double &mid)
+        {
+            out = BookFeatures();
+            levels = std::min(levels, MAX_BOOK_DEPTH);
+            out.bid_levels = std::min<size_t>(book.bids.size(), levels);
+            out.ask_levels = std::min<size_t>(book.asks.size(), levels);
+            if (out.bid_levels == 0 || out.ask_levels == 0)
+            {
+                out.bid_levels = out.ask_levels = 0;
+                return false;
+            }
+            mid = 0.5 * (static_cast<double>(book.bids.price[0].value) + static_cast<double>(book.asks.price[0].value));
+            return true;
+        }
+
+        SideSums scalar_side(const BookSide &side, size_t levels, double mid, int64_t vwap_size, int64_t *cumulative)
+        {
+            SideSums sums;
+            const double best = static_cast<double>(side.price[0].value);
+            int64_t total = 0;
+            for (size_t i = 0; i < levels; ++i)
+            {
+                const int64_t quantity = side.quantity[i].value;
+                const double price = static_cast<double>(side.price[i].value);
+                const int64_t fill = std::clamp<int64_t>(vwap_size - total, 0, quantity);
+                total += quantity;
+                cumulative[i] = total;
+
+                const double q = static_cast<double>(quantity);
+                sums.depth += q;
+                sums.notional += price * q;
+                sums.filled += static_cast<double>(fill);
+                sums.fill_cost += price * static_cast<double>(fill);
+                const double x = std::abs(price - best);
+                const double y = static_cast<double>(total);
+                sums.sx += x;
+                sums.sy += y;
+                sums.sxy += x * y;
+                sums.sxx += x * x;
+                sums.pressure += q / std::max(std::abs(price - mid), 0.5);
+            }
+            return sums;
+        }
+
+        bool scalar_features(const OrderBook &book, size_t levels, int64_t vwap_size, BookFeatures &out)
+        {
+            double mid = 0.0;
+            if (!prepare(book, levels, out, mid))
+                return false;
+            const SideSums bid = scalar_side(book.bids, out.bid_levels, mid, vwap_size, out.bid_cumulative);
+            const SideSums ask = scalar_side(book.asks, out.ask_levels, mid, vwap_size, out.ask_cumulative);
+            finish(bid, ask, out);
+            return true;
+        }
+
+        uint32_t scalar_changed_levels(const int64_t *a, const int64_t *b, size_t count)
+        {
+            uint32_t changed = 0;
+            for (size_t i = 0; i < count; ++i)
+                changed |= static_cast<uint32_t>(a[i] != b[i]) << i;
+            return changed;
+        }
+
+        const BookKernels SCALAR_KERNELS{"scalar", scalar_features, scalar_changed_levels};
+
+#ifdef HFT_BOOK_KERNELS_AVX2
+        // static_cast<double> of four int64 lanes; AVX2 has no such instruction.
+        // The high and low 32 bits are each made exact doubles with the 2^84
+        // and 2^52 magic numbers, so their sum is the only rounding.
+        HFT_TARGET_AVX2 inline __m256d to_double(__m256i v)
+        {
+            const __m256i two52 = _mm256_set1_epi64x(0x4330000000000000);        // 2^52
+            const __m256i two84_63 = _mm256_set1_epi64x(0x4530000080000000);     // 2^84 + 2^63
+            const __m256d two84_63_52 = _mm256_castsi256_pd(_mm256_set1_epi64x(0x4530000080100000));
+            const __m256i low = _mm256_blend_epi32(two52, v, 0x55);
+            const __m256i high = _mm256_xor_si256(_mm256_srli_epi64(v, 32), two84_63);
+            return _mm256_add_pd(_mm256_sub_pd(_mm256_castsi256_pd(high), two84_63_52), _mm256_castsi256_pd(low));
+        }
+
+        HFT_TARGET_AVX2 inline double horizontal_sum(__m256d v)
+        {
+            const __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+            return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+        }
+
+        // Inclusive prefix sum of four int64 lanes.
+        HFT_TARGET_AVX2 inline __m256i prefix_sum(__m256i v)
+        {
+            v = _mm256_add_epi64(v, _mm256_blend_epi32(_mm256_permute4x64_epi64(v, _MM_SHUFFLE(2, 1, 0, 0)), _mm256_setzero_si256(), 0x03));
+            v = _mm256_add_epi64(v, _mm256_blend_epi32(_mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 0, 0)), _mm256_setzero_si256(), 0x0F));
+            return v;
+        }
+
+        // scalar_side, four levels at a time.
+        HFT_TARGET_AVX2 SideSums avx2_side(const BookSide &side, size_t levels, double mid, int64_t vwap_size, int64_t *cumulative)
+        {
+            const __m256d sign = _mm256_set1_pd(-0.0);
+            const __m256d best = _mm256_set1_pd(static_cast<double>(side.price[0].value));
+            const __m256d mid_v = _mm256_set1_pd(mid);
+            const __m256d half = _mm256_set1_pd(0.5);
+            const __m256d size = _mm256_set1_pd(static_cast<double>(vwap_size));
+            const __m256d zero = _mm256_setzero_pd();
+            const __m256i count = _mm256_set1_epi64x(static_cast<int64_t>(levels));
+            __m256i index = _mm256_setr_epi64x(0, 1, 2, 3);
+            __m256i carry = _mm256_setzero_si256();
+            __m256d depth = zero, notional = zero, filled = zero, fill_cost = zero;
+            __m256d sx = zero, sy = zero, sxy = zero, sxx = zero, pressure = zero;
+
+            for (size_t i = 0; i < levels; i += 4)
+            {
+                const __m256i valid = _mm256_cmpgt_epi64(count, index);
+                const __m256d valid_pd = _mm256_castsi256_pd(valid);
+                const __m256i quantity_i = _mm256_and_si256(
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i *>(side.quantity + i)), valid);
+                const __m256i total_i = _mm256_add_epi64(prefix_sum(quantity_i), carry);
+                carry = _mm256_permute4x64_epi64(total_i, _MM_SHUFFLE(3, 3, 3, 3));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(cumulative + i), _mm256_and_si256(total_i, valid));
+
+                const __m256d q = to_double(quantity_i);
+                const __m256d total = to_double(total_i);
+                const __m256d price = to_double(_mm256_and_si256(
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i *>(side.price + i)), valid));
+                // Whatever of the VWAP size is left when this level is reached, up to its quantity.
+                const __m256d fill = _mm256_min_pd(_mm256_max_pd(_mm256_sub_pd(size, _mm256_sub_pd(total, q)), zero), q);
+                depth = _mm256_add_pd(depth, q);
+                notional = _mm256_add_pd(notional, _mm256_mul_pd(price, q));
+                filled = _mm256_add_pd(filled, fill);
+                fill_cost = _mm256_add_pd(fill_cost, _mm256_mul_pd(price, fill));
+
+                const __m256d x = _mm256_and_pd(_mm256_andnot_pd(sign, _mm256_sub_pd(price, best)), valid_pd);
+                const __m256d y = _mm256_and_pd(total, valid_pd);
+                sx = _mm256_add_pd(sx, x);
+                sy = _mm256_add_pd(sy, y);
+                sxy = _mm256_add_pd(sxy, _mm256_mul_pd(x, y));
+                sxx = _mm256_add_pd(sxx, _mm256_mul_pd(x, x));
+                const __m256d distance = _mm256_max_pd(_mm256_andnot_pd(sign, _mm256_sub_pd(price, mid_v)), half);
+                pressure = _mm256_add_pd(pressure, _mm256_div_pd(q, distance));
+
+                index = _mm256_add_epi64(index, _mm256_set1_epi64x(4));
+            }
+
+            SideSums sums;
+            sums.depth = horizontal_sum(depth);
+            sums.notional = horizontal_sum(notional);
+            sums.filled = horizontal_sum(filled);
+            sums.fill_cost = horizontal_sum(fill_cost);
+            sums.sx = horizontal_sum(sx);
+            sums.sy = horizontal_sum(sy);
+            sums.sxy = horizontal_sum(sxy);
+            sums.sxx = horizontal_sum(sxx);
+            sums.pressure = horizontal_sum(pressure);
+            return sums;
+        }
+
+        HFT_TARGET_AVX2 bool avx2_features(const OrderBook &book, size_t levels, int64_t vwap_size, BookFeatures &out)
+        {
+            double mid = 0.0;
+            if (!prepare(book, levels, out, mid))
+                return false;
+            const SideSums bid = avx2_side(book.bids, out.bid_levels, mid, vwap_size, out.bid_cumulative);
+            const SideSums ask = avx2_side(book.asks, out.ask_levels, mid, vwap_size, out.ask_cumulative);
+            finish(bid, ask, out);
+            return true;
+        }
+
+        HFT_TARGET_AVX2 uint32_t avx2_changed_levels(const int64_t *a, const int64_t *b, size_t count)
+        {
+            uint32_t changed = 0;
+            for (size_t i = 0; i < count; i += 4)
+            {
+                const __m256i equal = _mm256_cmpeq_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)),
+                                                         _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i)));
+                changed |= static_cast<uint32_t>(~_mm256_movemask_pd(_mm256_castsi256_pd(equal)) & 0xF) << i;
+            }
+            return changed & ((1u << count) - 1);
+        }
+
+        const BookKernels AVX2_KERNELS{"avx2", avx2_features, avx2_changed_levels};
+#endif
+    }
+
+    const BookKernels &scalar_book_kernels()
+    {
+        return SCALAR_KERNELS;
+    }
+
+    const BookKernels *avx2_book_kernels()
+    {
+#ifdef HFT_BOOK_KERNELS_AVX2
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported ? &AVX2_KERNELS : nullptr;
+#else
+        return nullptr;
+#endif
+    }
+
+    const BookKernels &book_kernels()
+    {
+        static const BookKernels &selected = avx2_book_kernels() ? *avx2_book_kernels() : scalar_book_kernels();
+        return selected;
+    }
+
+} // namespace hft_system
@@ -2,9 +2,9 @@
 
 namespace hft_system {
 
-std::unique_ptr<SignalEvent> BuyEveryTickStrategy::calculate_signal(const MarketEvent& event) {
-    // For any market event, immediately create and return a BUY signal event.
-    return std::make_unique<SignalEvent>(event.symbol, OrderDirection::BUY);
+void BuyEveryTickStrategy::on_market(const MarketEvent& event, SignalSink& signals) {
+    // For any market event, immediately emit a BUY signal.
+    signals.emit(event.symbol_id, OrderDirection::BUY);
 }
 
 } // namespace hft_system
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "../../include/strategy/MovingAverageCrossStrategy.h"
+#include "../../include/core/SymbolRegistry.h"
+#include <algorithm>
+#include <vector>
+
+namespace hft_system
+{
+
+    MovingAverageCrossStrategy::MovingAverageCrossStrategy(std::string symbol, int fast_period, int slow_period)
+        : symbol_(std::move(symbol)),
+          symbol_id_(intern_symbol(symbol_)),
+          spec_(instrument_spec(symbol_id_)),
+          fast_window_(static_cast<size_t>(std::max(fast_period, 1))),
+          slow_window_(static_cast<size_t>(std::max(slow_period, 1))) {}
+
+    void MovingAverageCrossStrategy::on_market(const MarketEvent &event, SignalSink &signals)
+    {
+        if (event.symbol_id != symbol_id_)
+            return;
+
+        const int64_t price = spec_.to_price(event.price).value;
+        // push() returns 0 until the window is full, so the sums need no special start.
+        fast_sum_ += price - fast_window_.push(price);
+        slow_sum_ += price - slow_window_.push(price);
+        if (!fast_window_.full() || !slow_window_.full())
+            return;
+
+        const int8_t trend = MovingAverageCrossStrategy::trend(fast_sum_, static_cast<int>(fast_window_.capacity()),
+                                                               slow_sum_, static_cast<int>(slow_window_.capacity()));
+        if (trend != trend_ && trend != 0)
+            signals.emit(symbol_id_, trend > 0 ? OrderDirection::BUY : OrderDirection::SELL);
+        trend_ = trend;
+    }
+
+    namespace
+    {
+        std::vector<int64_t> window_values(const RingBuffer<int64_t> &window)
+        {
+            std::vector<int64_t> values(window.size());
+            for (size_t i = 0; i < window.size(); ++i)
+                values[i] = window[i];
+            return values;
+        }
+    }
+
+    void MovingAverageCrossStrategy::save_state(SnapshotWriter &out) const
+    {
+        out.put_vector(window_values(fast_window_));
+        out.put_vector(window_values(slow_window_));
+        out.put(trend_);
+    }
+
+    bool MovingAverageCrossStrategy::restore_state(SnapshotReader &in)
+    {
+        std::vector<int64_t> fast, slow;
+        int8_t trend = 0;
+        if (!in.get_vector(fast) || !in.get_vector(slow) || !in.get(trend))
+            return false;
+        // Replaying the prices rebuilds the sums, and trims windows saved with longer periods.
+        fast_window_.clear();
+        slow_window_.clear();
+        fast_sum_ = 0;
+        slow_sum_ = 0;
+        for (int64_t price : fast)
+            fast_sum_ += price - fast_window_.push(price);
+        for (int64_t price : slow)
+            slow_sum_ += price - slow_window_.push(price);
+        trend_ = trend;
+        return true;
+    }
+
+} // namespace hft_system
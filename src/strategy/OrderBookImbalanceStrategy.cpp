@@ -1,5 +1,6 @@
 #include "../../include/strategy/OrderBookImbalanceStrategy.h"
 #include "../../include/core/Log.h"
+#include "../../include/core/SymbolRegistry.h"
 #include "../../include/utils/Timer.h"
 #include "../../include/utils/PerformanceMonitor.h"
 #include <numeric>
@@ -8,20 +9,20 @@
 namespace hft_system
 {
 
-    OrderBookImbalanceStrategy::OrderBookImbalanceStrategy(std::string symbol, int levels, double threshold)
+    OrderBookImbalanceStrategy::OrderBookImbalanceStrategy(std::string symbol, int levels, double threshold, double level_decay,
+                                                           int64_t vwap_size)
         : symbol_(std::move(symbol)),
-          lookback_levels_(levels),
+          symbol_id_(intern_symbol(symbol_)),
+          imbalance_(levels, level_decay),
+          vwap_size_(vwap_size),
           base_imbalance_threshold_(threshold),
           current_imbalance_threshold_(threshold) {}
 
-    std::unique_ptr<SignalEvent> OrderBookImbalanceStrategy::calculate_signal(const MarketEvent &event)
-    {
-        return nullptr;
-    }
-
     void OrderBookImbalanceStrategy::on_news(const NewsEvent &event)
     {
-        sentiment_scores_[event.symbol] = event.sentiment_score;
+        if (event.symbol_id >= sentiment_scores_.size())
+            sentiment_scores_.resize(event.symbol_id + 1, 0.0);
+        sentiment_scores_[event.symbol_id] = event.sentiment_score;
     }
 
     // NEW METHOD: React to market regime changes
@@ -41,45 +42,75 @@ namespace hft_system
         }
     }
 
-    std::unique_ptr<SignalEvent> OrderBookImbalanceStrategy::calculate_signal_from_order_book(const OrderBookEvent &event)
+    void OrderBookImbalanceStrategy::save_state(SnapshotWriter &out) const
+    {
+        out.put(current_imbalance_threshold_);
+        // SymbolIds are assigned per process, so scores are keyed by name.
+        uint64_t scored = std::count_if(sentiment_scores_.begin(), sentiment_scores_.end(), [](double score)
+                                        { return score != 0.0; });
+        out.put(scored);
+        for (size_t id = 0; id < sentiment_scores_.size(); ++id)
+        {
+            if (sentiment_scores_[id] == 0.0)
+                continue;
+            out.put_string(symbol_name(static_cast<SymbolId>(id)));
+            out.put(sentiment_scores_[id]);
+        }
+    }
+
+    bool OrderBookImbalanceStrategy::restore_state(SnapshotReader &in)
+    {
+        double threshold = 0.0;
+        uint64_t scored = 0;
+        if (!in.get(threshold) || !in.get(scored))
+            return false;
+        std::vector<double> scores;
+        for (uint64_t i = 0; i < scored; ++i)
+        {
+            std::string symbol;
+            double score = 0.0;
+            if (!in.get_string(symbol) || !in.get(score))
+                return false;
+            SymbolId id = intern_symbol(symbol);
+            if (id >= scores.size())
+                scores.resize(id + 1, 0.0);
+            scores[id] = score;
+        }
+        current_imbalance_threshold_ = threshold;
+        sentiment_scores_ = std::move(scores);
+        return true;
+    }
+
+    void OrderBookImbalanceStrategy::on_order_book(const OrderBookEvent &event, SignalSink &signals)
     {
         TIME_FUNCTION("OrderBookImbalanceStrategy_calculate_signal");
         
-        if (event.book.symbol != symbol_)
-            return nullptr;
+        if (event.book.symbol_id != symbol_id_)
+            return;
+
+        if (vwap_size_ > 0)
+            book_kernels().features(event.book, imbalance_.max_levels(), vwap_size_, features_);
 
-        const auto &bids = event.book.bids;
-        const auto &asks = event.book.asks;
-        if (bids.empty() || asks.empty())
-            return nullptr;
-        int levels_to_process = std::min({(int)bids.size(), (int)asks.size(), lookback_levels_});
-        double total_bid_volume = 0.0;
-        for (int i = 0; i < levels_to_process; ++i)
-            total_bid_volume += bids[i].quantity;
-        double total_ask_volume = 0.0;
-        for (int i = 0; i < levels_to_process; ++i)
-            total_ask_volume += asks[i].quantity;
-        if (total_ask_volume <= 1e-9)
-            return nullptr;
-        double imbalance_ratio = total_bid_volume / total_ask_volume;
+        // Only the levels that changed since the last book are re-summed.
+        if (!imbalance_.update(event.book) || imbalance_.ask_depth() <= 0)
+            return;
+        double imbalance_ratio = imbalance_.ratio();
 
-        double current_sentiment = sentiment_scores_.count(symbol_) ? sentiment_scores_[symbol_] : 0.0;
+        double current_sentiment = symbol_id_ < sentiment_scores_.size() ? sentiment_scores_[symbol_id_] : 0.0;
 
         // Use the CURRENT (adjusted) threshold for decisions
         if (imbalance_ratio > current_imbalance_threshold_)
         {
             if (current_sentiment < -0.5)
-                return nullptr;
-            return std::make_unique<SignalEvent>(symbol_, OrderDirection::BUY);
+                return;
+            signals.emit(symbol_id_, OrderDirection::BUY);
         }
         else if (imbalance_ratio < (1.0 / current_imbalance_threshold_))
         {
             if (current_sentiment > 0.5)
-                return nullptr;
-            return std::make_unique<SignalEvent>(symbol_, OrderDirection::SELL);
+                return;
+            signals.emit(symbol_id_, OrderDirection::SELL);
         }
-
-        return nullptr;
     }
 
 } // namespace hft_system
\ No newline at end of file
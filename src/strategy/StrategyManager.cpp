@@ -1,82 +1,171 @@
 #include "../../include/strategy/StrategyManager.h"
-#include "../../include/strategy/OrderBookImbalanceStrategy.h"
 #include "../../include/core/Log.h"
+#include <algorithm>
 #include <functional>
 
 namespace hft_system
 {
 
-    StrategyManager::StrategyManager(std::shared_ptr<EventBus> event_bus, std::string name)
+    namespace
+    {
+        // Shards per worker: enough slack for stealing to even out uneven strategies.
+        constexpr size_t SHARDS_PER_WORKER = 4;
+    }
+
+    StrategyManager::StrategyManager(std::shared_ptr<EventBus> event_bus, std::string name, size_t workers)
         : Component(event_bus, std::move(name))
     {
+        if (workers > 1)
+            pool_ = std::make_unique<StrategyWorkerPool>(workers);
 
         using namespace std::placeholders;
         event_bus_->subscribe(EventType::MARKET, std::bind(&StrategyManager::on_market_event, this, _1));
         event_bus_->subscribe(EventType::ORDER_BOOK, std::bind(&StrategyManager::on_order_book_event, this, _1));
+        event_bus_->subscribe(EventType::QUOTE, std::bind(&StrategyManager::on_quote_event, this, _1));
+        event_bus_->subscribe(EventType::BAR, std::bind(&StrategyManager::on_bar_event, this, _1));
         event_bus_->subscribe(EventType::NEWS, std::bind(&StrategyManager::on_news_event, this, _1));
-        // Add subscription for the new event
         event_bus_->subscribe(EventType::MARKET_REGIME_CHANGED, std::bind(&StrategyManager::on_market_regime_event, this, _1));
     }
 
-    void StrategyManager::start() { Log::get_logger()->info("{} started.", name_); }
+    void StrategyManager::start() { Log::get_logger()->info("{} started with {} worker(s).", name_, worker_count()); }
     void StrategyManager::stop() { Log::get_logger()->info("{} stopped.", name_); }
 
     void StrategyManager::add_strategy(std::unique_ptr<Strategy> strategy)
     {
-        if (strategy)
-            strategies_.push_back(std::move(strategy));
+        if (!strategy)
+            return;
+
+        const uint32_t interests = strategy->interests();
+        Strategy *raw = strategy.get();
+        if (interests & Strategy::MARKET)
+            market_strategies_.push_back(raw);
+        if (interests & Strategy::ORDER_BOOK)
+            order_book_strategies_.push_back(raw);
+        if (interests & Strategy::QUOTE)
+            quote_strategies_.push_back(raw);
+        if (interests & Strategy::BAR)
+            bar_strategies_.push_back(raw);
+        if (interests & Strategy::NEWS)
+            news_strategies_.push_back(raw);
+        if (interests & Strategy::MARKET_REGIME)
+            regime_strategies_.push_back(raw);
+        strategies_.push_back(std::move(strategy));
     }
 
-    void StrategyManager::on_market_event(const Event &event)
+    void StrategyManager::save_snapshot(Snapshot &snapshot) const
     {
-        const auto &market_event = static_cast<const MarketEvent &>(event);
+        SnapshotWriter &out = snapshot.add_section(name_, STRATEGY_SECTION_VERSION);
+        out.put(static_cast<uint64_t>(strategies_.size()));
         for (const auto &strategy : strategies_)
+            save_strategy_state(*strategy, out);
+    }
+
+    void StrategyManager::restore_snapshot(const Snapshot &snapshot)
+    {
+        auto in = snapshot.section(name_, STRATEGY_SECTION_VERSION);
+        if (!in)
+            return;
+        uint64_t count = 0;
+        if (!in->get(count) || count != strategies_.size())
+        {
+            Log::get_logger()->warn("{}: snapshot holds {} strategies, {} are configured; starting cold.", name_, count, strategies_.size());
+            return;
+        }
+        for (auto &strategy : strategies_)
         {
-            auto signal_event = strategy->calculate_signal(market_event);
-            if (signal_event)
+            if (!restore_strategy_state(*strategy, *in))
             {
-                event_bus_->publish(std::move(signal_event));
+                Log::get_logger()->warn("{}: unreadable strategy state in snapshot; the rest start cold.", name_);
+                return;
             }
         }
+        Log::get_logger()->info("{}: restored {} strategies from snapshot.", name_, count);
     }
 
-    void StrategyManager::on_order_book_event(const Event &event)
+    void StrategyManager::collect(SignalSink &sink)
     {
-        const auto &order_book_event = static_cast<const OrderBookEvent &>(event);
-        for (const auto &strategy : strategies_)
+        if (sink.empty())
+            return;
+        for (const Signal &signal : sink)
+            batch_.push_back(std::make_shared<SignalEvent>(signal.symbol_id, signal.direction));
+        sink.clear();
+    }
+
+    template <typename Hook>
+    void StrategyManager::dispatch(const std::vector<Strategy *> &strategies, Hook &&hook)
+    {
+        const size_t count = strategies.size();
+        if (sinks_.size() < std::max<size_t>(count, 1))
+            sinks_.resize(std::max<size_t>(count, 1));
+
+        if (!pool_ || count < 2)
         {
-            if (auto *imbalance_strategy = dynamic_cast<OrderBookImbalanceStrategy *>(strategy.get()))
+            for (Strategy *strategy : strategies)
             {
-                auto signal_event = imbalance_strategy->calculate_signal_from_order_book(order_book_event);
-                if (signal_event)
-                {
-                    Log::get_logger()->info("{}: Imbalance strategy generated a signal. Publishing.", name_);
-                    event_bus_->publish(std::move(signal_event));
-                }
+                hook(*strategy, sinks_[0]);
+                collect(sinks_[0]);
             }
         }
+        else
+        {
+            const size_t shards = std::min(count, pool_->worker_count() * SHARDS_PER_WORKER);
+            auto run_shard = [&](size_t shard)
+            {
+                for (size_t i = shard * count / shards, end = (shard + 1) * count / shards; i < end; ++i)
+                    hook(*strategies[i], sinks_[i]);
+            };
+            pool_->run(shards, run_shard);
+            for (size_t i = 0; i < count; ++i)
+                collect(sinks_[i]);
+        }
+
+        if (!batch_.empty())
+        {
+            event_bus_->publish_batch(std::move(batch_));
+            batch_.clear();
+        }
+    }
+
+    void StrategyManager::on_market_event(const Event &event)
+    {
+        const auto &market_event = static_cast<const MarketEvent &>(event);
+        dispatch(market_strategies_, [&](Strategy &strategy, SignalSink &signals)
+                 { strategy.on_market(market_event, signals); });
+    }
+
+    void StrategyManager::on_order_book_event(const Event &event)
+    {
+        const auto &order_book_event = static_cast<const OrderBookEvent &>(event);
+        dispatch(order_book_strategies_, [&](Strategy &strategy, SignalSink &signals)
+                 { strategy.on_order_book(order_book_event, signals); });
+    }
+
+    void StrategyManager::on_quote_event(const Event &event)
+    {
+        const auto &quote_event = static_cast<const QuoteEvent &>(event);
+        dispatch(quote_strategies_, [&](Strategy &strategy, SignalSink &signals)
+                 { strategy.on_quote(quote_event, signals); });
+    }
+
+    void StrategyManager::on_bar_event(const Event &event)
+    {
+        const auto &bar_event = static_cast<const BarEvent &>(event);
+        dispatch(bar_strategies_, [&](Strategy &strategy, SignalSink &signals)
+                 { strategy.on_bar(bar_event, signals); });
     }
+
     void StrategyManager::on_news_event(const Event &event)
     {
         const auto &news_event = static_cast<const NewsEvent &>(event);
-        for (const auto &strategy : strategies_)
-        {
-            if (auto *imbalance_strategy = dynamic_cast<OrderBookImbalanceStrategy *>(strategy.get()))
-            {
-                imbalance_strategy->on_news(news_event);
-            }
-        }
+        for (Strategy *strategy : news_strategies_)
+            strategy->on_news(news_event);
     }
+
     void StrategyManager::on_market_regime_event(const Event &event)
     {
         const auto &regime_event = static_cast<const MarketRegimeChangedEvent &>(event);
-        for (const auto &strategy : strategies_)
-        {
-            if (auto *imbalance_strategy = dynamic_cast<OrderBookImbalanceStrategy *>(strategy.get()))
-            {
-                imbalance_strategy->on_market_regime_change(regime_event.state);
-            }
-        }
+        for (Strategy *strategy : regime_strategies_)
+            strategy->on_market_regime_change(regime_event.state);
     }
 
-} // namespace hft_system
\ No newline at end of file
+} // namespace hft_system
@@ -0,0 +1,92 @@
+#include "../../include/strategy/StrategyWorkerPool.h"
+#include <algorithm>
+
+namespace hft_system
+{
+    namespace
+    {
+        // Spins before sleeping, so back-to-back events do not pay a wake-up each.
+        constexpr int SPIN_ITERATIONS = 20000;
+    }
+
+    StrategyWorkerPool::StrategyWorkerPool(size_t workers)
+        : worker_count_(std::max<size_t>(workers, 1)),
+          ranges_(std::make_unique<Range[]>(worker_count_))
+    {
+        threads_.reserve(worker_count_ - 1);
+        for (size_t worker = 1; worker < worker_count_; ++worker)
+            threads_.emplace_back(&StrategyWorkerPool::thread_main, this, worker);
+    }
+
+    StrategyWorkerPool::~StrategyWorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            generation_.fetch_add(1, std::memory_order_release);
+        }
+        wake_.notify_all();
+        for (auto &thread : threads_)
+            thread.join();
+    }
+
+    void StrategyWorkerPool::run_erased(size_t shards, void (*invoke)(void *, size_t), void *context)
+    {
+        if (shards == 0)
+            return;
+        invoke_ = invoke;
+        context_ = context;
+        for (size_t worker = 0; worker < worker_count_; ++worker)
+        {
+            ranges_[worker].next.store(worker * shards / worker_count_, std::memory_order_relaxed);
+            ranges_[worker].end = (worker + 1) * shards / worker_count_;
+        }
+        busy_.store(threads_.size(), std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            generation_.fetch_add(1, std::memory_order_release);
+        }
+        wake_.notify_all();
+
+        work(0);
+        while (busy_.load(std::memory_order_acquire) != 0)
+            std::this_thread::yield();
+    }
+
+    void StrategyWorkerPool::work(size_t worker)
+    {
+        for (size_t offset = 0; offset < worker_count_; ++offset)
+        {
+            Range &range = ranges_[(worker + offset) % worker_count_];
+            for (;;)
+            {
+                size_t shard = range.next.fetch_add(1, std::memory_order_relaxed);
+                if (shard >= range.end)
+                    break;
+                invoke_(context_, shard);
+            }
+        }
+    }
+
+    void StrategyWorkerPool::thread_main(size_t worker)
+    {
+        uint64_t seen = 0;
+        for (;;)
+        {
+            for (int spin = 0; spin < SPIN_ITERATIONS && generation_.load(std::memory_order_acquire) == seen; ++spin)
+            {
+            }
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&]
+                           { return generation_.load(std::memory_order_acquire) != seen; });
+                if (stopping_)
+                    return;
+            }
+            seen = generation_.load(std::memory_order_acquire);
+            work(worker);
+            busy_.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+} // namespace hft_system
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "core/Log.h"
+#include "core/EventBus.h"
+#include "core/SymbolRegistry.h"
+#include "data/BarAggregator.h"
+#include "events/Event.h"
+
+using namespace hft_system;
+
+class BarAggregatorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Log::init();
+        event_bus = std::make_shared<EventBus>();
+        event_bus->subscribe(EventType::BAR,
+                             [this](const Event &event)
+                             {
+                                 std::lock_guard<std::mutex> lock(mutex);
+                                 bars.push_back(static_cast<const BarEvent &>(event));
+                             });
+        event_bus->subscribe(EventType::SYSTEM, [this](const Event &)
+                             { done_promise.set_value(); });
+        event_bus->start();
+    }
+
+    void TearDown() override
+    {
+        event_bus->stop();
+        Log::shutdown();
+    }
+
+    // Waits until everything published so far has been dispatched.
+    void drain()
+    {
+        done_promise = std::promise<void>();
+        event_bus->publish(std::make_shared<Event>(EventType::SYSTEM));
+        ASSERT_EQ(done_promise.get_future().wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    }
+
+    static constexpr int64_t SECOND = 1000000000LL;
+    std::shared_ptr<EventBus> event_bus;
+    std::mutex mutex;
+    std::vector<BarEvent> bars;
+    std::promise<void> done_promise;
+};
+
+TEST_F(BarAggregatorTest, TimeBarsCloseOnFirstTickOfNextWindow)
+{
+    BarConfig config;
+    config.windows.push_back({BarSpec::Kind::TIME, 60.0 * SECOND});
+    BarAggregator aggregator(event_bus, "BarAggregator", config);
+
+    aggregator.on_tick(intern_symbol("BTC"), 120 * SECOND + 1, 100.0, 1.0);
+    aggregator.on_tick(intern_symbol("BTC"), 130 * SECOND, 105.0, 2.0);
+    aggregator.on_tick(intern_symbol("BTC"), 150 * SECOND, 98.0, 0.5);
+    aggregator.on_tick(intern_symbol("BTC"), 179 * SECOND, 101.0, 1.5);
+    aggregator.on_tick(intern_symbol("BTC"), 300 * SECOND, 110.0, 1.0); // Skips two empty windows
+    drain();
+
+    ASSERT_EQ(bars.size(), 1u);
+    const Bar &bar = bars[0].bar;
+    EXPECT_EQ(symbol_name(bars[0].symbol_id), "BTC");
+    EXPECT_EQ(bar.timestamp, 120 * SECOND);
+    EXPECT_DOUBLE_EQ(bar.open, 100.0);
+    EXPECT_DOUBLE_EQ(bar.high, 105.0);
+    EXPECT_DOUBLE_EQ(bar.low, 98.0);
+    EXPECT_DOUBLE_EQ(bar.close, 101.0);
+    EXPECT_DOUBLE_EQ(bar.volume, 5.0);
+}
+
+TEST_F(BarAggregatorTest, VolumeBarsAndSymbolsAreIndependent)
+{
+    BarConfig config;
+    config.windows.push_back({BarSpec::Kind::VOLUME, 10.0});
+    BarAggregator aggregator(event_bus, "BarAggregator", config);
+
+    for (int i = 0; i < 25; ++i)
+    {
+        aggregator.on_tick(intern_symbol("BTC"), i * SECOND, 100.0 + i, 1.0);
+        aggregator.on_tick(intern_symbol("ETH"), i * SECOND, 10.0, 0.5);
+    }
+    aggregator.flush();
+    drain();
+
+    std::vector<Bar> btc, eth;
+    for (const auto &event : bars)
+    {
+        (event.symbol_id == intern_symbol("BTC") ? btc : eth).push_back(event.bar);
+    }
+    ASSERT_EQ(btc.size(), 3u); // 10 + 10 + a flushed partial 5
+    EXPECT_DOUBLE_EQ(btc[0].open, 100.0);
+    EXPECT_DOUBLE_EQ(btc[0].close, 109.0);
+    EXPECT_DOUBLE_EQ(btc[1].open, 110.0);
+    EXPECT_DOUBLE_EQ(btc[2].volume, 5.0);
+    ASSERT_EQ(eth.size(), 2u); // 12.5 units of volume: one full bar and a partial
+    EXPECT_DOUBLE_EQ(eth[0].volume, 10.0);
+}
+
+TEST_F(BarAggregatorTest, AggregatesPublishedEvents)
+{
+    BarConfig config;
+    config.windows.push_back({BarSpec::Kind::TIME, 1.0 * SECOND});
+    config.use_book_mid = true;
+    BarAggregator aggregator(event_bus, "BarAggregator", config);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        OrderBook book;
+        book.symbol_id = intern_symbol("BTCUSDT");
+        book.timestamp = 1700000000000 + i * 400; // Exchange milliseconds
+        const InstrumentSpec spec = instrument_spec(book.symbol_id);
+        book.bids.push_back(spec.to_price(99.0 + i), spec.to_quantity(1.0));
+        book.bids.push_back(spec.to_price(98.0 + i), spec.to_quantity(1.0));
+        book.asks.push_back(spec.to_price(101.0 + i), spec.to_quantity(1.0));
+        book.asks.push_back(spec.to_price(102.0 + i), spec.to_quantity(1.0));
+        event_bus->publish(std::make_shared<OrderBookEvent>(book));
+    }
+    drain(); // Dispatches the books...
+    drain(); // ...then the bar they produced
+
+    ASSERT_EQ(bars.size(), 1u);
+    EXPECT_EQ(bars[0].spec, config.windows[0]);
+    EXPECT_EQ(bars[0].bar.timestamp, 1700000000000LL * 1000000);
+    EXPECT_DOUBLE_EQ(bars[0].bar.open, 100.0);
+    EXPECT_DOUBLE_EQ(bars[0].bar.close, 102.0);
+}
@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "core/Log.h"
+#include "core/SymbolRegistry.h"
+#include "events/Event.h"
+#include "strategy/BookImbalance.h"
+#include "strategy/OrderBookImbalanceStrategy.h"
+
+using namespace hft_system;
+
+namespace
+{
+    // Scalar reference: both sides summed from scratch over the same levels.
+    struct ReferenceImbalance
+    {
+        BookImbalance::Depth bid_depth = 0;
+        BookImbalance::Depth ask_depth = 0;
+        double float_ratio = 0.0; // With unquantised decay^i weights
+    };
+
+    ReferenceImbalance reference(const OrderBook &book, const BookImbalance &engine, double decay)
+    {
+        ReferenceImbalance result;
+        const size_t levels = std::min({book.bids.size(), book.asks.size(), engine.max_levels()});
+        double bid = 0.0, ask = 0.0;
+        for (size_t i = 0; i < levels; ++i)
+        {
+            result.bid_depth += BookImbalance::Depth(engine.weight(i)) * book.bids.quantity[i].value;
+            result.ask_depth += BookImbalance::Depth(engine.weight(i)) * book.asks.quantity[i].value;
+            bid += std::pow(decay, static_cast<double>(i)) * static_cast<double>(book.bids.quantity[i].value);
+            ask += std::pow(decay, static_cast<double>(i)) * static_cast<double>(book.asks.quantity[i].value);
+        }
+        result.float_ratio = ask > 0.0 ? bid / ask : 0.0;
+        return result;
+    }
+
+    OrderBook ladder(SymbolId symbol, size_t bid_levels, size_t ask_levels, int64_t quantity)
+    {
+        OrderBook book{};
+        book.symbol_id = symbol;
+        for (size_t i = 0; i < bid_levels; ++i)
+            book.bids.push_back(Price(10000 - static_cast<int64_t>(i)), Quantity(quantity));
+        for (size_t i = 0; i < ask_levels; ++i)
+            book.asks.push_back(Price(10001 + static_cast<int64_t>(i)), Quantity(quantity));
+        return book;
+    }
+
+    // Random walk over books: mostly quantity changes near the top, sometimes a
+    // level inserted or removed (shifting the ones below) or a side emptied.
+    void mutate(OrderBook &book, std::mt19937 &rng)
+    {
+        std::uniform_int_distribution<int> action(0, 19);
+        std::uniform_int_distribution<int64_t> quantity(1, 5000);
+        BookSide &side = std::bernoulli_distribution(0.5)(rng) ? book.bids : book.asks;
+        const bool bids = &side == &book.bids;
+        const int kind = action(rng);
+        if (kind < 15 && !side.empty())
+        {
+            std::geometric_distribution<size_t> near_top(0.4);
+            size_t level = std::min<size_t>(near_top(rng), side.size() - 1);
+            side.quantity[level] = Quantity(quantity(rng));
+        }
+        else if (kind < 17 && side.size() < MAX_BOOK_DEPTH)
+        {
+            // A new best level; the rest shift down one.
+            Price best = side.empty() ? Price(bids ? 10000 : 10001) : side.price[0] + Price(bids ? 1 : -1);
+            for (size_t i = side.size(); i > 0; --i)
+            {
+                side.price[i] = side.price[i - 1];
+                side.quantity[i] = side.quantity[i - 1];
+            }
+            side.price[0] = best;
+            side.quantity[0] = Quantity(quantity(rng));
+            ++side.depth;
+        }
+        else if (kind < 19 && !side.empty())
+        {
+            for (size_t i = 0; i + 1 < side.size(); ++i)
+            {
+                side.price[i] = side.price[i + 1];
+                side.quantity[i] = side.quantity[i + 1];
+            }
+            --side.depth;
+        }
+        else if (side.empty())
+        {
+            side.push_back(Price(bids ? 10000 : 10001), Quantity(quantity(rng)));
+        }
+        else
+        {
+            side.clear();
+        }
+    }
+}
+
+TEST(BookImbalanceTest, MatchesAScalarRecomputationOnEveryBook)
+{
+    const SymbolId symbol = intern_symbol("IMBALANCE_TEST");
+    for (double decay : {1.0, 0.8, 0.35})
+    {
+        for (int levels : {1, 5, 20, 50})
+        {
+            BookImbalance engine(levels, decay);
+            std::mt19937 rng(static_cast<uint32_t>(levels * 100 + decay * 10));
+            OrderBook book = ladder(symbol, 12, 9, 100);
+            for (int step = 0; step < 5000; ++step)
+            {
+                const bool counted = engine.update(book);
+                ReferenceImbalance expected = reference(book, engine, decay);
+                ASSERT_EQ(counted, !book.bids.empty() && !book.asks.empty());
+                ASSERT_EQ(engine.bid_depth(), expected.bid_depth) << "step " << step;
+                ASSERT_EQ(engine.ask_depth(), expected.ask_depth) << "step " << step;
+                if (counted)
+                {
+                    EXPECT_NEAR(engine.ratio(), expected.float_ratio, 1e-4 * expected.float_ratio);
+                    EXPECT_NEAR(engine.imbalance(),
+                                static_cast<double>(expected.bid_depth - expected.ask_depth) /
+                                    static_cast<double>(expected.bid_depth + expected.ask_depth),
+                                1e-12);
+                }
+                mutate(book, rng);
+            }
+        }
+    }
+}
+
+TEST(BookImbalanceTest, ReweightsOnlyTheLevelsThatChanged)
+{
+    const SymbolId symbol = intern_symbol("IMBALANCE_TEST");
+    BookImbalance engine(10, 0.5);
+    OrderBook book = ladder(symbol, 15, 15, 100);
+    ASSERT_TRUE(engine.update(book));
+    EXPECT_EQ(engine.levels(), 10u);
+    const uint64_t initial = engine.level_updates();
+    EXPECT_EQ(initial, 20u);
+
+    // The same book again costs nothing; one changed level costs one update.
+    engine.update(book);
+    EXPECT_EQ(engine.level_updates(), initial);
+    book.bids.quantity[3] = Quantity(400);
+    engine.update(book);
+    EXPECT_EQ(engine.level_updates(), initial + 1);
+    EXPECT_EQ(engine.bid_depth(), engine.ask_depth() + engine.weight(3) * 300);
+
+    // A change below the levels counted is ignored.
+    book.asks.quantity[12] = Quantity(1);
+    engine.update(book);
+    EXPECT_EQ(engine.level_updates(), initial + 1);
+
+    // A delta applied directly matches the book it describes.
+    BookImbalance direct(10, 0.5);
+    direct.update(book);
+    direct.set_ask(0, Quantity(50));
+    book.asks.quantity[0] = Quantity(50);
+    engine.update(book);
+    EXPECT_EQ(direct.ask_depth(), engine.ask_depth());
+    EXPECT_EQ(direct.bid_depth(), engine.bid_depth());
+
+    // Losing a side clears the sums.
+    book.asks.clear();
+    EXPECT_FALSE(engine.update(book));
+    EXPECT_EQ(engine.levels(), 0u);
+    EXPECT_EQ(engine.ratio(), 0.0);
+}
+
+// 2^50 lots per level weighs 2^66 at WEIGHT_ONE: past int64, not past the sums.
+TEST(BookImbalanceTest, LargeQuantitiesDoNotOverflow)
+{
+    const SymbolId symbol = intern_symbol("IMBALANCE_TEST");
+    const int64_t huge = int64_t(1) << 50;
+    for (double decay : {1.0, 0.5})
+    {
+        BookImbalance engine(10, decay);
+        OrderBook book = ladder(symbol, 10, 10, huge);
+        ASSERT_TRUE(engine.update(book));
+        EXPECT_GT(engine.bid_depth(), BookImbalance::Depth(std::numeric_limits<int64_t>::max()));
+        EXPECT_DOUBLE_EQ(engine.ratio(), 1.0);
+        EXPECT_DOUBLE_EQ(engine.imbalance(), 0.0);
+
+        // Doubling the best bid, through update() and through set_bid().
+        book.bids.quantity[0] = Quantity(2 * huge);
+        ASSERT_TRUE(engine.update(book));
+        const ReferenceImbalance expected = reference(book, engine, decay);
+        EXPECT_EQ(engine.bid_depth(), expected.bid_depth);
+        EXPECT_EQ(engine.ask_depth(), expected.ask_depth);
+        EXPECT_NEAR(engine.ratio(), expected.float_ratio, 1e-4);
+        EXPECT_GT(engine.imbalance(), 0.0);
+
+        BookImbalance direct(10, decay);
+        direct.update(ladder(symbol, 10, 10, huge));
+        direct.set_bid(0, Quantity(2 * huge));
+        EXPECT_EQ(direct.bid_depth(), engine.bid_depth());
+    }
+}
+
+TEST(BookImbalanceTest, MicropriceLeansAwayFromTheHeavierSide)
+{
+    const SymbolId symbol = intern_symbol("IMBALANCE_TEST");
+    BookImbalance engine(5);
+    OrderBook book = ladder(symbol, 5, 5, 100);
+    book.bids.price[0] = Price(10000);
+    book.asks.price[0] = Price(10004);
+    engine.update(book);
+    EXPECT_DOUBLE_EQ(engine.microprice(), 10002.0);
+
+    // Three times the size bid: the next trade is likelier up, at the ask.
+    book.bids.quantity[0] = Quantity(300);
+    engine.update(book);
+    EXPECT_DOUBLE_EQ(engine.microprice(), (10000.0 * 100 + 10004.0 * 300) / 400);
+}
+
+TEST(BookImbalanceTest, DecayedStrategyDiscountsDeepLevels)
+{
+    Log::init();
+    const SymbolId symbol = intern_symbol("IMBALANCE_TEST");
+    // Equal size at the touch, bids stacked deeper down: 1:1 at the top, 3:1 over five levels.
+    OrderBook book = ladder(symbol, 5, 5, 100);
+    for (size_t i = 1; i < 5; ++i)
+        book.bids.quantity[i] = Quantity(350);
+
+    OrderBookImbalanceStrategy flat("IMBALANCE_TEST", 5, 1.5);
+    OrderBookImbalanceStrategy decayed("IMBALANCE_TEST", 5, 1.5, 0.1, 150);
+    SignalSink flat_signals, decayed_signals;
+    flat.on_order_book(OrderBookEvent(book), flat_signals);
+    decayed.on_order_book(OrderBookEvent(book), decayed_signals);
+    ASSERT_EQ(flat_signals.size(), 1u);
+    EXPECT_EQ(flat_signals.begin()->direction, OrderDirection::BUY);
+    EXPECT_TRUE(decayed_signals.empty());
+
+    // Only the strategy given a VWAP size keeps the book's features.
+    BookFeatures expected;
+    ASSERT_TRUE(scalar_book_kernels().features(book, 5, 150, expected));
+    EXPECT_EQ(decayed.features().bid_levels, 5u);
+    EXPECT_EQ(decayed.features().bid_cumulative[4], expected.bid_cumulative[4]);
+    EXPECT_EQ(decayed.features().sell_fillable, 150);
+    EXPECT_DOUBLE_EQ(decayed.features().pressure, expected.pressure);
+    EXPECT_EQ(flat.features().ask_levels, 0u);
+    Log::shutdown();
+}
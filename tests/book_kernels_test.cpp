@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "strategy/BookKernels.h"
+
+using namespace hft_system;
+
+namespace
+{
+    OrderBook random_book(std::mt19937 &rng)
+    {
+        std::uniform_int_distribution<size_t> depth(0, MAX_BOOK_DEPTH);
+        std::uniform_int_distribution<int64_t> gap(1, 4);
+        std::uniform_int_distribution<int64_t> quantity(1, 100000);
+        OrderBook book{};
+        // Stale levels past the depth, as a reused book would have, must not count.
+        for (size_t i = 0; i < MAX_BOOK_DEPTH; ++i)
+        {
+            book.bids.push_back(Price(quantity(rng)), Quantity(quantity(rng)));
+            book.asks.push_back(Price(quantity(rng)), Quantity(quantity(rng)));
+        }
+        book.bids.clear();
+        book.asks.clear();
+        const int64_t mid = 2000000;
+        int64_t bid = mid - gap(rng), ask = mid + gap(rng);
+        for (size_t i = 0, n = depth(rng); i < n; ++i, bid -= gap(rng))
+            book.bids.push_back(Price(bid), Quantity(quantity(rng)));
+        for (size_t i = 0, n = depth(rng); i < n; ++i, ask += gap(rng))
+            book.asks.push_back(Price(ask), Quantity(quantity(rng)));
+        return book;
+    }
+
+    void expect_same(const BookFeatures &actual, const BookFeatures &expected)
+    {
+        auto near = [](double a, double b)
+        { return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(b)); };
+        ASSERT_EQ(actual.bid_levels, expected.bid_levels);
+        ASSERT_EQ(actual.ask_levels, expected.ask_levels);
+        for (size_t i = 0; i < MAX_BOOK_DEPTH; ++i)
+        {
+            EXPECT_EQ(actual.bid_cumulative[i], expected.bid_cumulative[i]) << i;
+            EXPECT_EQ(actual.ask_cumulative[i], expected.ask_cumulative[i]) << i;
+        }
+        EXPECT_PRED2(near, actual.depth_weighted_mid, expected.depth_weighted_mid);
+        EXPECT_PRED2(near, actual.buy_vwap, expected.buy_vwap);
+        EXPECT_PRED2(near, actual.sell_vwap, expected.sell_vwap);
+        EXPECT_EQ(actual.buy_fillable, expected.buy_fillable);
+        EXPECT_EQ(actual.sell_fillable, expected.sell_fillable);
+        EXPECT_PRED2(near, actual.bid_slope, expected.bid_slope);
+        EXPECT_PRED2(near, actual.ask_slope, expected.ask_slope);
+        EXPECT_PRED2(near, actual.pressure, expected.pressure);
+    }
+}
+
+TEST(BookKernelsTest, ScalarFeaturesOfASmallBook)
+{
+    OrderBook book{};
+    book.bids.push_back(Price(99), Quantity(10));
+    book.bids.push_back(Price(98), Quantity(20));
+    book.bids.push_back(Price(96), Quantity(30));
+    book.asks.push_back(Price(101), Quantity(5));
+    book.asks.push_back(Price(102), Quantity(15));
+
+    BookFeatures features;
+    ASSERT_TRUE(scalar_book_kernels().features(book, 10, 25, features));
+    EXPECT_EQ(features.bid_levels, 3u);
+    EXPECT_EQ(features.ask_levels, 2u);
+    EXPECT_EQ(features.bid_cumulative[2], 60);
+    EXPECT_EQ(features.ask_cumulative[1], 20);
+
+    // Bid VWAP 5830 / 60 over 60 lots, ask VWAP 101.75 over 20.
+    EXPECT_DOUBLE_EQ(features.depth_weighted_mid, (5830.0 / 60 * 20 + 101.75 * 60) / 80);
+    // Selling 25 takes 10 at 99 and 15 at 98; buying 25 exhausts the 20 asks.
+    EXPECT_EQ(features.sell_fillable, 25);
+    EXPECT_DOUBLE_EQ(features.sell_vwap, (99.0 * 10 + 98.0 * 15) / 25);
+    EXPECT_EQ(features.buy_fillable, 20);
+    EXPECT_DOUBLE_EQ(features.buy_vwap, 101.75);
+    // Asks: depth 5 at the touch, 20 one tick out.
+    EXPECT_DOUBLE_EQ(features.ask_slope, 15.0);
+    // Bid depth curve (0, 10), (1, 30), (3, 60): least squares slope 230 / 14.
+    EXPECT_DOUBLE_EQ(features.bid_slope, 230.0 / 14.0);
+    // Mid 100: bids weigh 10/1 + 20/2 + 30/4, asks 5/1 + 15/2.
+    EXPECT_DOUBLE_EQ(features.pressure, (27.5 - 12.5) / 40.0);
+
+    // Two levels only; an empty side has no features.
+    ASSERT_TRUE(scalar_book_kernels().features(book, 2, 25, features));
+    EXPECT_EQ(features.bid_levels, 2u);
+    EXPECT_EQ(features.bid_cumulative[2], 0);
+    book.asks.clear();
+    EXPECT_FALSE(scalar_book_kernels().features(book, 10, 25, features));
+    EXPECT_EQ(features.bid_levels, 0u);
+}
+
+TEST(BookKernelsTest, SelectedKernelsMatchScalar)
+{
+    const BookKernels &scalar = scalar_book_kernels();
+    std::vector<const BookKernels *> candidates{&book_kernels()};
+    if (const BookKernels *avx2 = avx2_book_kernels())
+        candidates.push_back(avx2);
+
+    std::mt19937 rng(50);
+    std::uniform_int_distribution<size_t> levels(0, MAX_BOOK_DEPTH + 2);
+    std::uniform_int_distribution<int64_t> size(0, 600000);
+    for (const BookKernels *kernels : candidates)
+    {
+        SCOPED_TRACE(kernels->name);
+        for (int i = 0; i < 3000; ++i)
+        {
+            const OrderBook book = random_book(rng);
+            const size_t n = levels(rng);
+            const int64_t vwap_size = size(rng);
+            BookFeatures expected, actual;
+            const bool has_features = scalar.features(book, n, vwap_size, expected);
+            ASSERT_EQ(kernels->features(book, n, vwap_size, actual), has_features);
+            expect_same(actual, expected);
+
+            int64_t a[MAX_BOOK_DEPTH], b[MAX_BOOK_DEPTH];
+            for (size_t j = 0; j < MAX_BOOK_DEPTH; ++j)
+            {
+                a[j] = book.bids.quantity[j].value;
+                b[j] = rng() % 4 == 0 ? a[j] + 1 : a[j];
+            }
+            const size_t count = std::min(n, MAX_BOOK_DEPTH);
+            ASSERT_EQ(kernels->changed_levels(a, b, count), scalar.changed_levels(a, b, count));
+        }
+    }
+}
+
+TEST(BookKernelsTest, SelectedKernelsMatchScalarPast2To52)
+{
+    const BookKernels &scalar = scalar_book_kernels();
+    std::vector<const BookKernels *> candidates{&book_kernels()};
+    if (const BookKernels *avx2 = avx2_book_kernels())
+        candidates.push_back(avx2);
+
+    // Prices past 2^52 with their low bits set; sizes of a few 2^40 lots,
+    // so depth sums stay exact whatever order they are added in.
+    std::mt19937 rng(52);
+    std::uniform_int_distribution<int64_t> gap(1, 1 << 20);
+    std::uniform_int_distribution<int64_t> lots(1, 4095);
+    OrderBook book{};
+    int64_t bid = (int64_t(1) << 60) + 12345, ask = bid + gap(rng);
+    for (size_t i = 0; i < MAX_BOOK_DEPTH; ++i, bid -= gap(rng), ask += gap(rng))
+    {
+        book.bids.push_back(Price(bid), Quantity(lots(rng) << 40));
+        book.asks.push_back(Price(ask), Quantity(lots(rng) << 40));
+    }
+    for (const BookKernels *kernels : candidates)
+    {
+        SCOPED_TRACE(kernels->name);
+        BookFeatures expected, actual;
+        ASSERT_TRUE(scalar.features(book, MAX_BOOK_DEPTH, std::numeric_limits<int64_t>::max(), expected));
+        ASSERT_TRUE(kernels->features(book, MAX_BOOK_DEPTH, std::numeric_limits<int64_t>::max(), actual));
+        expect_same(actual, expected);
+    }
+}
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/Log.h"
+#include "core/EventBus.h"
+#include "core/SymbolRegistry.h"
+#include "data/CaptureJournal.h"
+#include "data/CaptureReplayHandler.h"
+#include "data/ReplayServer.h"
+#include "data/WebSocketDataHandler.h"
+#include "events/Event.h"
+
+using namespace hft_system;
+
+class CaptureJournalTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Log::init();
+        directory = std::filesystem::temp_directory_path() / "hft_capture_journal_test";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        base_path = (directory / "capture").string();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+        Log::shutdown();
+    }
+
+    static std::string frame(int i)
+    {
+        return R"({"stream":"btcusdt@trade","data":{"t":)" + std::to_string(i) + std::string(i % 50, 'x') + "}}";
+    }
+
+    std::filesystem::path directory;
+    std::string base_path;
+};
+
+TEST_F(CaptureJournalTest, RoundTripsRecordsAcrossRotatedSegments)
+{
+    constexpr int RECORDS = 5000;
+    CaptureWriter::Options options;
+    options.base_path = base_path;
+    options.segment_bytes = 64 << 10; // The minimum, so the journal rotates several times
+    options.max_segments = 0;
+    CaptureWriter writer(options);
+    ASSERT_TRUE(writer.start());
+    writer.append(CaptureRecord::Kind::SUBSCRIBE, 1, R"({"method":"SUBSCRIBE","params":["btcusdt@trade"],"id":1})");
+    for (int i = 0; i < RECORDS; ++i)
+    {
+        while (!writer.append(CaptureRecord::Kind::FRAME, 100 + i, frame(i)))
+            std::this_thread::yield(); // Never expected with the default ring
+    }
+    writer.stop();
+    EXPECT_EQ(writer.records_written(), static_cast<uint64_t>(RECORDS + 1));
+    EXPECT_EQ(writer.records_dropped(), 0u);
+    EXPECT_GT(writer.segments_opened(), 3u);
+
+    CaptureReader reader(base_path);
+    ASSERT_TRUE(reader.open());
+    EXPECT_EQ(reader.segment_count(), writer.segments_opened());
+    CaptureRecord record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.kind, CaptureRecord::Kind::SUBSCRIBE);
+    for (int i = 0; i < RECORDS; ++i)
+    {
+        ASSERT_TRUE(reader.next(record)) << "record " << i;
+        EXPECT_EQ(record.kind, CaptureRecord::Kind::FRAME);
+        EXPECT_EQ(record.receive_time, 100 + i);
+        ASSERT_EQ(record.data, frame(i));
+    }
+    EXPECT_FALSE(reader.next(record));
+}
+
+TEST_F(CaptureJournalTest, KeepsOnlyTheNewestSegmentsAndCountsDrops)
+{
+    CaptureWriter::Options options;
+    options.base_path = base_path;
+    options.segment_bytes = 64 << 10;
+    options.max_segments = 2;
+    options.buffer_bytes = 4096; // Tiny ring: a burst overruns it instead of blocking
+    CaptureWriter writer(options);
+    ASSERT_TRUE(writer.start());
+    const std::string payload(1000, 'y');
+    int accepted = 0;
+    for (int i = 0; i < 2000; ++i)
+        accepted += writer.append(CaptureRecord::Kind::FRAME, i, payload) ? 1 : 0;
+    writer.stop();
+
+    EXPECT_EQ(writer.records_written() + writer.records_dropped(), 2000u);
+    EXPECT_EQ(writer.records_written(), static_cast<uint64_t>(accepted));
+    EXPECT_GT(writer.records_dropped(), 0u);
+
+    CaptureReader reader(base_path);
+    ASSERT_TRUE(reader.open());
+    EXPECT_LE(reader.segment_count(), 2u);
+    CaptureRecord record;
+    int64_t last = -1;
+    while (reader.next(record))
+    {
+        EXPECT_GT(record.receive_time, last);
+        EXPECT_EQ(record.data, payload);
+        last = record.receive_time;
+    }
+}
+
+TEST_F(CaptureJournalTest, NewCaptureReplacesAnEarlierLongerOne)
+{
+    CaptureWriter::Options options;
+    options.base_path = base_path;
+    options.segment_bytes = 64 << 10;
+    {
+        CaptureWriter writer(options);
+        ASSERT_TRUE(writer.start());
+        for (int i = 0; i < 5000; ++i)
+            writer.append(CaptureRecord::Kind::FRAME, i, frame(i));
+        writer.stop();
+        ASSERT_GT(writer.segments_opened(), 3u);
+    }
+
+    CaptureWriter writer(options);
+    ASSERT_TRUE(writer.start());
+    writer.append(CaptureRecord::Kind::FRAME, 1, "only");
+    writer.stop();
+
+    CaptureReader reader(base_path);
+    ASSERT_TRUE(reader.open());
+    EXPECT_EQ(reader.segment_count(), 1u);
+    CaptureRecord record;
+    ASSERT_TRUE(reader.next(record));
+    EXPECT_EQ(record.data, "only");
+    EXPECT_FALSE(reader.next(record));
+}
+
+// Captures the LIVE path against a ReplayServer, then replays the journal and
+// expects the same events and the same final book.
+TEST_F(CaptureJournalTest, ReplayReproducesTheCapturedSession)
+{
+    constexpr int DEPTH_UPDATES = 500;
+    constexpr int TRADES = 100;
+    const SymbolId btcusdt = intern_symbol("BTCUSDT");
+    SymbolRegistry::get_instance().set_spec(btcusdt, InstrumentSpec::from(0.01, 0.00001));
+
+    struct Session
+    {
+        std::mutex mutex;
+        OrderBook last_book{};
+        int books = 0;
+        std::vector<double> trade_prices;
+        std::promise<void> done;
+    };
+    auto subscribe = [](EventBus &bus, Session &session)
+    {
+        bus.subscribe(EventType::ORDER_BOOK, [&session](const Event &event)
+                      {
+            std::lock_guard<std::mutex> lock(session.mutex);
+            session.last_book = static_cast<const OrderBookEvent &>(event).book;
+            if (++session.books == DEPTH_UPDATES + 1 && session.trade_prices.size() == TRADES)
+                session.done.set_value(); });
+        bus.subscribe(EventType::MARKET, [&session](const Event &event)
+                      {
+            std::lock_guard<std::mutex> lock(session.mutex);
+            session.trade_prices.push_back(static_cast<const MarketEvent &>(event).price);
+            if (session.books == DEPTH_UPDATES + 1 && session.trade_prices.size() == TRADES)
+                session.done.set_value(); });
+    };
+
+    Session live;
+    {
+        ReplayServerOptions options;
+        options.messages_file = std::string(PROJECT_SOURCE_DIR) + "/tests/data/depth_messages.jsonl";
+        options.speed = 0.0;
+        ReplayServer server(options);
+        ASSERT_TRUE(server.start());
+
+        WebSocketConfig config;
+        config.host = "127.0.0.1";
+        config.port = server.port();
+        config.target = "/stream";
+        config.use_tls = false;
+        config.symbols = {"BTCUSDT"};
+        config.streams = {"depth", "trade"};
+        config.snapshot_file = std::string(PROJECT_SOURCE_DIR) + "/tests/data/depth_snapshot.json";
+        config.capture_path = base_path;
+
+        auto bus = std::make_shared<EventBus>();
+        subscribe(*bus, live);
+        bus->start();
+        auto handler = std::make_shared<WebSocketDataHandler>(bus, config);
+        handler->start();
+        auto status = live.done.get_future().wait_for(std::chrono::seconds(10));
+        handler->stop();
+        server.stop();
+        bus->stop();
+        ASSERT_EQ(status, std::future_status::ready);
+    }
+
+    Session replayed;
+    auto bus = std::make_shared<EventBus>();
+    subscribe(*bus, replayed);
+    std::promise<void> finished;
+    bus->subscribe(EventType::SYSTEM, [&](const Event &)
+                   { finished.set_value(); });
+    bus->start();
+    auto handler = std::make_shared<CaptureReplayHandler>(bus, base_path);
+    handler->set_replay_speed(0.0);
+    handler->start();
+    auto status = finished.get_future().wait_for(std::chrono::seconds(10));
+    handler->stop();
+    bus->stop();
+    ASSERT_EQ(status, std::future_status::ready);
+
+    // Subscription, snapshot, 600 frames and the subscription ack.
+    EXPECT_EQ(handler->records_replayed(), static_cast<uint64_t>(2 + DEPTH_UPDATES + TRADES + 1));
+    EXPECT_EQ(replayed.books, live.books);
+    EXPECT_EQ(replayed.trade_prices, live.trade_prices);
+    EXPECT_EQ(replayed.last_book.symbol_id, btcusdt);
+    EXPECT_EQ(replayed.last_book.bids.price[0], Price(2699925));
+    EXPECT_EQ(replayed.last_book.bids.quantity[0], Quantity(66000));
+    EXPECT_EQ(replayed.last_book.asks.price[0], Price(2700064));
+    EXPECT_EQ(replayed.last_book.asks.quantity[0], Quantity(161000));
+    for (size_t level = 0; level < MAX_BOOK_DEPTH; ++level)
+    {
+        EXPECT_EQ(replayed.last_book.bids.price[level], live.last_book.bids.price[level]);
+        EXPECT_EQ(replayed.last_book.asks.quantity[level], live.last_book.asks.quantity[level]);
+    }
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "core/Log.h"
+#include "data/BinanceDepthDecoder.h"
+
+using namespace hft_system;
+
+// Counts heap allocations while `count_allocations` is set, to check the decode path.
+namespace
+{
+    std::atomic<bool> count_allocations{false};
+    std::atomic<int> allocations{0};
+}
+
+void *operator new(std::size_t size)
+{
+    if (count_allocations.load(std::memory_order_relaxed))
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+class DepthDecoderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { Log::init(); }
+    void TearDown() override { Log::shutdown(); }
+
+    // Copies a frame into storage with simdjson's trailing padding, as flat_buffer::prepare does.
+    BinanceDepthDecoder::Result decode(const std::string &frame)
+    {
+        storage.assign(frame);
+        storage.resize(BinanceDepthDecoder::padded_capacity(frame.size()), '\0');
+        return decoder.decode(storage.data(), frame.size(), storage.size(), book);
+    }
+
+    const std::string depth_frame =
+        R"({"e":"depthUpdate","E":1700000000123,"s":"BTCUSDT","U":157,"u":160,)"
+        R"("b":[["27123.45000000","0.50000000"],["27123.40000000","0.00000000"]],)"
+        R"("a":[["27123.46000000","1.25000000"]]})";
+
+    BinanceDepthDecoder decoder{InstrumentSpec::from(0.01, 0.00001)};
+    DepthUpdate book;
+    std::string storage;
+};
+
+TEST_F(DepthDecoderTest, DecodesDepthUpdateFields)
+{
+    ASSERT_EQ(decode(depth_frame), BinanceDepthDecoder::Result::DEPTH_UPDATE);
+    EXPECT_EQ(book.symbol, "BTCUSDT");
+    EXPECT_EQ(book.timestamp, 1700000000123);
+    ASSERT_EQ(book.bids.size(), 2u);
+    ASSERT_EQ(book.asks.size(), 1u);
+    // Levels arrive as whole ticks (0.01) and lots (0.00001).
+    EXPECT_EQ(book.bids[0].price, Price(2712345));
+    EXPECT_EQ(book.bids[0].quantity, Quantity(50000));
+    EXPECT_EQ(book.bids[1].quantity, Quantity(0));
+    EXPECT_EQ(book.asks[0].price, Price(2712346));
+    EXPECT_DOUBLE_EQ(decoder.spec().to_double(book.asks[0].price), 27123.46);
+}
+
+TEST_F(DepthDecoderTest, ClassifiesOtherFrames)
+{
+    EXPECT_EQ(decode(R"({"result":null,"id":1})"), BinanceDepthDecoder::Result::SUBSCRIPTION_ACK);
+    EXPECT_EQ(decode(R"({"e":"trade","E":1,"s":"BTCUSDT","p":"1.0"})"), BinanceDepthDecoder::Result::IGNORED);
+    EXPECT_EQ(decode(R"({"e":"depthUpdate","b":[["abc","1"]]})"), BinanceDepthDecoder::Result::ERROR);
+    EXPECT_EQ(decode(R"({"e":"depthUpdate","b":[["1.0"]]})"), BinanceDepthDecoder::Result::ERROR);
+    EXPECT_EQ(decode("not json"), BinanceDepthDecoder::Result::ERROR);
+}
+
+TEST_F(DepthDecoderTest, WarmDecodeDoesNotAllocate)
+{
+    // The first frame sizes the parser and the book's level vectors.
+    ASSERT_EQ(decode(depth_frame), BinanceDepthDecoder::Result::DEPTH_UPDATE);
+
+    storage.assign(depth_frame);
+    storage.resize(BinanceDepthDecoder::padded_capacity(depth_frame.size()), '\0');
+    allocations.store(0);
+    count_allocations.store(true);
+    for (int i = 0; i < 1000; ++i)
+    {
+        decoder.decode(storage.data(), depth_frame.size(), storage.size(), book);
+    }
+    count_allocations.store(false);
+
+    EXPECT_EQ(allocations.load(), 0);
+    EXPECT_EQ(book.bids.size(), 2u);
+}
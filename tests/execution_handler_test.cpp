@@ -4,6 +4,7 @@
 
 #include "core/Log.h"
 #include "core/EventBus.h"
+#include "core/SymbolRegistry.h"
 #include "execution/ExecutionHandler.h"
 #include "events/Event.h"
 #include "config/Config.h" // Include the config header
@@ -42,8 +43,8 @@ TEST_F(ExecutionHandlerTest, ShouldGenerateFillEventOnOrderEvent)
                          [&](const Event &event)
                          {
                              const auto &fill_event = dynamic_cast<const FillEvent &>(event);
-                             EXPECT_EQ(fill_event.symbol, "GOOG");
-                             EXPECT_EQ(fill_event.quantity, 50);
+                             EXPECT_EQ(symbol_name(fill_event.symbol_id), "GOOG");
+                             EXPECT_EQ(fill_event.quantity, instrument_spec(fill_event.symbol_id).to_quantity(50));
 
                              fill_received_promise.set_value(true);
                          });
@@ -54,7 +55,9 @@ TEST_F(ExecutionHandlerTest, ShouldGenerateFillEventOnOrderEvent)
     // 2. Act
     // **FIX 2:** Add the required market_price argument to the OrderEvent constructor.
     double dummy_market_price = 299.85;
-    auto order_event = std::make_shared<OrderEvent>("GOOG", OrderDirection::SELL, 50, dummy_market_price);
+    const SymbolId goog = intern_symbol("GOOG");
+    const InstrumentSpec spec = instrument_spec(goog);
+    auto order_event = std::make_shared<OrderEvent>(goog, OrderDirection::SELL, spec.to_quantity(50), spec.to_price(dummy_market_price));
     event_bus->publish(order_event);
 
     // 3. Assert
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/Log.h"
+#include "core/FixedPoint.h"
+#include "risk/OrderSizing.h"
+#include "utils/Timer.h"
+
+using namespace hft_system;
+
+TEST(FixedPointTest, ParsesDecimalStringsExactly)
+{
+    int64_t units = 0;
+    ASSERT_TRUE(parse_scaled("27123.45000000", 2, units));
+    EXPECT_EQ(units, 2712345);
+    ASSERT_TRUE(parse_scaled("0.00001", 5, units));
+    EXPECT_EQ(units, 1);
+    ASSERT_TRUE(parse_scaled("-3", 2, units));
+    EXPECT_EQ(units, -300);
+    ASSERT_TRUE(parse_scaled(".5", 1, units));
+    EXPECT_EQ(units, 5);
+    ASSERT_TRUE(parse_scaled("1.2350", 2, units));
+    EXPECT_EQ(units, 124) << "Digits past the grid round half away from zero";
+
+    EXPECT_FALSE(parse_scaled("", 2, units));
+    EXPECT_FALSE(parse_scaled(".", 2, units));
+    EXPECT_FALSE(parse_scaled("1e5", 2, units));
+    EXPECT_FALSE(parse_scaled("1.2.3", 2, units));
+    EXPECT_FALSE(parse_scaled("99999999999999999999", 0, units));
+}
+
+TEST(FixedPointTest, SpecMapsStringsAndDoublesToTheSameGrid)
+{
+    const InstrumentSpec spec = InstrumentSpec::from(0.05, 0.001);
+    EXPECT_EQ(spec.price_decimals, 2);
+    EXPECT_EQ(spec.price_step, 5);
+
+    Price price;
+    ASSERT_TRUE(spec.parse_price("101.35", price));
+    EXPECT_EQ(price, Price(2027));
+    EXPECT_EQ(price, spec.to_price(101.35));
+    EXPECT_DOUBLE_EQ(spec.to_double(price), 101.35);
+
+    Quantity quantity;
+    ASSERT_TRUE(spec.parse_quantity("0.300", quantity));
+    EXPECT_EQ(quantity, Quantity(300));
+    EXPECT_DOUBLE_EQ(spec.notional(price, quantity), 101.35 * 0.3);
+}
+
+TEST(FixedPointTest, RepeatedFillsNetToExactlyZero)
+{
+    // 0.1 + 0.2 style drift: ten buys of 0.1 then one sell of 1.0 leave a double position non-zero.
+    const InstrumentSpec spec = InstrumentSpec::from(0.01, 0.00001);
+    double double_position = 0.0;
+    Quantity position;
+    for (int i = 0; i < 10; ++i)
+    {
+        double_position += 0.1;
+        position += spec.to_quantity(0.1);
+    }
+    double_position -= 1.0;
+    position -= spec.to_quantity(1.0);
+    EXPECT_NE(double_position, 0.0);
+    EXPECT_EQ(position.value, 0);
+}
+
+TEST(FixedPointTest, OrderSizingStaysWithinTheBudgetAndAboveTheMinimums)
+{
+    const InstrumentSpec spec = InstrumentSpec::from(0.01, 0.001);
+    EXPECT_EQ(spec.to_quantity_floor(0.3), Quantity(300));
+    EXPECT_EQ(spec.to_quantity_ceil(0.3), Quantity(300));
+
+    // $100 at 15000 is 6.67 lots: the nearest lot, 7, would cost $105.
+    OrderSizing sizing = size_order(100.0, 1e6, spec.to_price(15000.0), spec);
+    ASSERT_EQ(sizing.result, OrderSizing::Result::OK);
+    EXPECT_EQ(sizing.quantity, Quantity(6));
+    EXPECT_LE(sizing.notional, 100.0);
+
+    // A $1 risk at 7000 is raised to the $10 minimum value, 1.43 lots: the
+    // nearest lot, 1, would be a $7 order.
+    sizing = size_order(1.0, 1e6, spec.to_price(7000.0), spec);
+    ASSERT_EQ(sizing.result, OrderSizing::Result::OK);
+    EXPECT_EQ(sizing.quantity, Quantity(2));
+    EXPECT_GE(sizing.notional, 10.0);
+
+    sizing = size_order(1.0, 5.0, spec.to_price(7000.0), spec);
+    EXPECT_EQ(sizing.result, OrderSizing::Result::INSUFFICIENT_CASH);
+}
+
+TEST(FixedPointTest, ParsingAndSummingAgainstDoubles)
+{
+    Log::init();
+    const InstrumentSpec spec = InstrumentSpec::from(0.01, 0.00001);
+
+    // Binance-style level strings.
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> ticks(2500000, 3500000);
+    std::uniform_int_distribution<int> lots(1, 500000);
+    std::vector<std::string> prices, quantities;
+    for (int i = 0; i < 200000; ++i)
+    {
+        int t = ticks(rng), l = lots(rng);
+        prices.push_back(std::to_string(t / 100) + "." + (t % 100 < 10 ? "0" : "") + std::to_string(t % 100) + "000000");
+        quantities.push_back(std::to_string(l / 100000) + "." + std::string(5 - std::to_string(l % 100000).size(), '0') +
+                             std::to_string(l % 100000) + "000");
+    }
+
+    Timer stod_timer;
+    double double_sum = 0.0;
+    for (size_t i = 0; i < prices.size(); ++i)
+        double_sum += std::stod(prices[i]) * std::stod(quantities[i]);
+    int64_t stod_ns = stod_timer.elapsed_nanoseconds();
+
+    Timer fixed_timer;
+    int64_t price_sum = 0, quantity_sum = 0;
+    for (size_t i = 0; i < prices.size(); ++i)
+    {
+        Price price;
+        Quantity quantity;
+        spec.parse_price(prices[i], price);
+        spec.parse_quantity(quantities[i], quantity);
+        price_sum += price.value;
+        quantity_sum += quantity.value;
+    }
+    int64_t fixed_ns = fixed_timer.elapsed_nanoseconds();
+
+    // Integer accumulation vs double accumulation over the same book quantities.
+    std::vector<int64_t> lot_values(1 << 20);
+    std::vector<double> double_values(lot_values.size());
+    for (size_t i = 0; i < lot_values.size(); ++i)
+    {
+        lot_values[i] = lots(rng);
+        double_values[i] = lot_values[i] * 0.00001;
+    }
+    Timer int_timer;
+    int64_t int_total = 0;
+    for (int64_t v : lot_values)
+        int_total += v;
+    int64_t int_ns = int_timer.elapsed_nanoseconds();
+    Timer double_timer;
+    double double_total = 0.0;
+    for (double v : double_values)
+        double_total += v;
+    int64_t double_ns = double_timer.elapsed_nanoseconds();
+
+    Log::get_logger()->info("Fixed point: parse {:.1f} ns/level vs std::stod {:.1f} ns/level; sum {} ns (int64) vs {} ns (double)",
+                            static_cast<double>(fixed_ns) / prices.size(), static_cast<double>(stod_ns) / prices.size(),
+                            int_ns, double_ns);
+    EXPECT_GT(price_sum, 0);
+    EXPECT_GT(quantity_sum, 0);
+    EXPECT_GT(double_sum, 0.0);
+    EXPECT_NEAR(spec.to_double(Quantity(int_total)), double_total, 1e-3);
+    Log::shutdown();
+}
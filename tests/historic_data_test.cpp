@@ -0,0 +1,322 @@
+#include <gtest/gtest.h>
+#include <future>
+#include <memory>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+#include "core/Log.h"
+#include "core/EventBus.h"
+#include "data/PrefetchReader.h"
+#include "data/HistoricCSVDataHandler.h"
+#include "data/TimeIndex.h"
+#include "data/DatasetCache.h"
+#include "data/DatasetReplayHandler.h"
+#include "events/Event.h"
+
+using namespace hft_system;
+
+class HistoricDataTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Log::init();
+        event_bus = std::make_shared<EventBus>();
+
+        // Big enough to span many 4 KiB blocks so lines get split across block boundaries.
+        data_file_path = (std::filesystem::temp_directory_path() / "hft_historic_data_test.csv").string();
+        std::ofstream out(data_file_path);
+        out << "timestamp,open,high,low,close,volume\n";
+        for (int i = 0; i < NUM_ROWS; ++i)
+        {
+            double price = 100.0 + i * 0.25;
+            out << FIRST_TIMESTAMP + i * 60 << ",\"" << price << "\",\"" << price + 1 << "\",\""
+                << price - 1 << "\",\"" << price << "\"," << 10 + i % 7 << "\n";
+        }
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(data_file_path);
+        std::filesystem::remove(TimeIndex::sidecar_path(data_file_path));
+        Log::shutdown();
+    }
+
+    static constexpr int NUM_ROWS = 5000;
+    static constexpr long long FIRST_TIMESTAMP = 1672531200;
+    std::shared_ptr<EventBus> event_bus;
+    std::string data_file_path;
+};
+
+TEST_F(HistoricDataTest, PrefetchReaderStreamsWholeFileInOrder)
+{
+    std::ifstream in(data_file_path, std::ios::binary);
+    std::string expected((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    PrefetchReader reader(data_file_path, 4096, 2);
+    ASSERT_TRUE(reader.start());
+
+    std::string actual;
+    PrefetchReader::Block block;
+    while (reader.acquire(block))
+    {
+        EXPECT_EQ(block.file_offset, static_cast<int64_t>(actual.size()));
+        actual.append(block.data, block.size);
+        reader.release(block);
+    }
+    reader.stop();
+
+    EXPECT_EQ(actual, expected);
+    EXPECT_GT(reader.stats().items.load(), 1);
+}
+
+TEST_F(HistoricDataTest, PipelinePublishesEveryRowThenSystemEvent)
+{
+    std::atomic<int> market_events{0};
+    std::atomic<double> last_price{0.0};
+    std::promise<void> done_promise;
+    auto done_future = done_promise.get_future();
+
+    event_bus->subscribe(EventType::MARKET,
+                         [&](const Event &event)
+                         {
+                             const auto &market_event = static_cast<const MarketEvent &>(event);
+                             last_price.store(market_event.price);
+                             market_events++;
+                         });
+    event_bus->subscribe(EventType::SYSTEM, [&](const Event &)
+                         { done_promise.set_value(); });
+
+    HistoricCSVDataHandler data_handler(event_bus, "TEST_BTC", data_file_path);
+    data_handler.set_replay_delay(std::chrono::microseconds(0));
+
+    event_bus->start();
+    data_handler.start();
+
+    auto future_status = done_future.wait_for(std::chrono::seconds(5));
+
+    data_handler.stop();
+    event_bus->stop();
+
+    ASSERT_EQ(future_status, std::future_status::ready) << "Test timed out.";
+    EXPECT_EQ(market_events.load(), NUM_ROWS);
+    EXPECT_DOUBLE_EQ(last_price.load(), 100.0 + (NUM_ROWS - 1) * 0.25);
+
+    auto stages = data_handler.get_stage_statistics();
+    EXPECT_GT(stages.at("io").at("items"), 0);
+    EXPECT_GT(stages.at("parse").at("items"), 0);
+    EXPECT_GT(stages.at("publish").at("items"), 0);
+}
+
+TEST_F(HistoricDataTest, MissingFileStillSignalsCompletion)
+{
+    std::promise<void> done_promise;
+    auto done_future = done_promise.get_future();
+    event_bus->subscribe(EventType::SYSTEM, [&](const Event &)
+                         { done_promise.set_value(); });
+
+    HistoricCSVDataHandler data_handler(event_bus, "TEST_BTC", data_file_path + ".missing");
+
+    event_bus->start();
+    data_handler.start();
+
+    auto future_status = done_future.wait_for(std::chrono::seconds(2));
+
+    data_handler.stop();
+    event_bus->stop();
+
+    ASSERT_EQ(future_status, std::future_status::ready) << "Backtest would hang on a missing file.";
+}
+
+TEST_F(HistoricDataTest, TimeIndexSeeksToRowBoundaryAndIsReused)
+{
+    auto index = TimeIndex::load_or_build(data_file_path, 64);
+    EXPECT_FALSE(index.loaded_from_disk());
+    EXPECT_TRUE(index.is_sorted());
+    EXPECT_EQ(index.entries().size(), static_cast<size_t>((NUM_ROWS + 63) / 64));
+
+    std::ifstream in(data_file_path, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    // Every seek result must be the start of a row no later than the requested timestamp.
+    for (long long row : {0LL, 1LL, 63LL, 64LL, 65LL, 2500LL, NUM_ROWS - 1LL})
+    {
+        long long target = FIRST_TIMESTAMP + row * 60;
+        int64_t offset = index.seek(target);
+        ASSERT_GT(offset, 0);
+        EXPECT_EQ(contents[offset - 1], '\n');
+        long long found = std::stoll(contents.substr(offset, contents.find(',', offset) - offset));
+        EXPECT_LE(found, target);
+        EXPECT_GE(found, target - 64 * 60) << "Seek should land within one stride of the target";
+    }
+
+    auto reloaded = TimeIndex::load_or_build(data_file_path, 64);
+    EXPECT_TRUE(reloaded.loaded_from_disk());
+    EXPECT_EQ(reloaded.seek(FIRST_TIMESTAMP + 2500 * 60), index.seek(FIRST_TIMESTAMP + 2500 * 60));
+}
+
+TEST_F(HistoricDataTest, TimeRangeReplaysOnlyRowsInsideRange)
+{
+    std::atomic<int> market_events{0};
+    std::atomic<double> first_price{0.0};
+    std::atomic<double> last_price{0.0};
+    std::promise<void> done_promise;
+    auto done_future = done_promise.get_future();
+
+    event_bus->subscribe(EventType::MARKET,
+                         [&](const Event &event)
+                         {
+                             const auto &market_event = static_cast<const MarketEvent &>(event);
+                             if (market_events++ == 0)
+                                 first_price.store(market_event.price);
+                             last_price.store(market_event.price);
+                         });
+    event_bus->subscribe(EventType::SYSTEM, [&](const Event &)
+                         { done_promise.set_value(); });
+
+    HistoricCSVDataHandler data_handler(event_bus, "TEST_BTC", data_file_path);
+    data_handler.set_replay_delay(std::chrono::microseconds(0));
+    data_handler.set_time_range(FIRST_TIMESTAMP + 3000 * 60, FIRST_TIMESTAMP + 3500 * 60);
+
+    event_bus->start();
+    data_handler.start();
+
+    auto future_status = done_future.wait_for(std::chrono::seconds(5));
+
+    data_handler.stop();
+    event_bus->stop();
+
+    ASSERT_EQ(future_status, std::future_status::ready) << "Test timed out.";
+    EXPECT_EQ(market_events.load(), 500);
+    EXPECT_DOUBLE_EQ(first_price.load(), 100.0 + 3000 * 0.25);
+    EXPECT_DOUBLE_EQ(last_price.load(), 100.0 + 3499 * 0.25);
+}
+
+TEST_F(HistoricDataTest, TimeRangeOnUnsortedFileSkipsRowsPastTheEnd)
+{
+    // A late row in the middle must not end the replay of an unsorted file.
+    {
+        std::ofstream out(data_file_path, std::ios::trunc);
+        out << "timestamp,open,high,low,close,volume\n"
+            << FIRST_TIMESTAMP << ",1,1,1,1.0,1\n"
+            << FIRST_TIMESTAMP + 600 << ",1,1,1,2.0,1\n"
+            << FIRST_TIMESTAMP + 60 << ",1,1,1,3.0,1\n"
+            << FIRST_TIMESTAMP + 120 << ",1,1,1,4.0,1\n";
+    }
+    std::vector<double> prices;
+    std::promise<void> done_promise;
+    auto done_future = done_promise.get_future();
+    event_bus->subscribe(EventType::MARKET, [&](const Event &event)
+                         { prices.push_back(static_cast<const MarketEvent &>(event).price); });
+    event_bus->subscribe(EventType::SYSTEM, [&](const Event &)
+                         { done_promise.set_value(); });
+
+    HistoricCSVDataHandler data_handler(event_bus, "TEST_BTC", data_file_path);
+    data_handler.set_replay_delay(std::chrono::microseconds(0));
+    data_handler.set_time_range(std::numeric_limits<int64_t>::min(), FIRST_TIMESTAMP + 300);
+    event_bus->start();
+    data_handler.start();
+    auto future_status = done_future.wait_for(std::chrono::seconds(5));
+    data_handler.stop();
+    event_bus->stop();
+
+    ASSERT_EQ(future_status, std::future_status::ready) << "Test timed out.";
+    EXPECT_EQ(prices, (std::vector<double>{1.0, 3.0, 4.0}));
+}
+
+TEST_F(HistoricDataTest, TimeIndexRebuildsASidecarWithABadEntryCount)
+{
+    auto index = TimeIndex::load_or_build(data_file_path, 64);
+    ASSERT_FALSE(index.loaded_from_disk());
+    {
+        // entry_count sits after magic, version, stride, size, mtime and data offset.
+        std::fstream sidecar(TimeIndex::sidecar_path(data_file_path), std::ios::binary | std::ios::in | std::ios::out);
+        const uint64_t huge = uint64_t(1) << 60;
+        sidecar.seekp(40);
+        sidecar.write(reinterpret_cast<const char *>(&huge), sizeof(huge));
+    }
+
+    auto rebuilt = TimeIndex::load_or_build(data_file_path, 64);
+    EXPECT_FALSE(rebuilt.loaded_from_disk());
+    EXPECT_EQ(rebuilt.entries().size(), index.entries().size());
+    EXPECT_EQ(rebuilt.seek(FIRST_TIMESTAMP + 2500 * 60), index.seek(FIRST_TIMESTAMP + 2500 * 60));
+}
+
+TEST_F(HistoricDataTest, DatasetCacheSharesOneDecodedCopyPerKey)
+{
+    auto &cache = DatasetCache::get_instance();
+    size_t loads_before = cache.load_count();
+    const int64_t start = FIRST_TIMESTAMP + 1000 * 60;
+    const int64_t end = FIRST_TIMESTAMP + 2000 * 60;
+
+    auto first = cache.acquire(data_file_path, start, end);
+    auto second = cache.acquire(data_file_path, start, end);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(cache.load_count(), loads_before + 1);
+
+    ASSERT_EQ(first->size(), 1000u);
+    EXPECT_EQ(first->timestamps.front(), start);
+    EXPECT_DOUBLE_EQ(first->close.front(), 100.0 + 1000 * 0.25);
+    EXPECT_DOUBLE_EQ(first->high.back(), 100.0 + 1999 * 0.25 + 1);
+
+    auto other_range = cache.acquire(data_file_path, start, end + 60);
+    EXPECT_NE(other_range.get(), first.get());
+
+    EXPECT_EQ(cache.acquire(data_file_path + ".missing", start, end), nullptr);
+}
+
+TEST_F(HistoricDataTest, DatasetCacheKeepsRowsAfterALateOneInAnUnsortedFile)
+{
+    {
+        std::ofstream out(data_file_path, std::ios::trunc);
+        out << "timestamp,open,high,low,close,volume\n"
+            << FIRST_TIMESTAMP << ",1,1,1,1.0,1\n"
+            << FIRST_TIMESTAMP + 600 << ",1,1,1,2.0,1\n"
+            << FIRST_TIMESTAMP + 60 << ",1,1,1,3.0,1\n"
+            << FIRST_TIMESTAMP + 120 << ",1,1,1,4.0,1\n";
+    }
+    auto dataset = DatasetCache::get_instance().acquire(data_file_path, std::numeric_limits<int64_t>::min(),
+                                                        FIRST_TIMESTAMP + 300);
+    ASSERT_NE(dataset, nullptr);
+    EXPECT_EQ(dataset->close, (std::vector<double>{1.0, 3.0, 4.0}));
+}
+
+TEST_F(HistoricDataTest, DatasetReplayMatchesCsvReplay)
+{
+    auto dataset = DatasetCache::get_instance().acquire(data_file_path, std::numeric_limits<int64_t>::min(),
+                                                        std::numeric_limits<int64_t>::max());
+    ASSERT_NE(dataset, nullptr);
+    ASSERT_EQ(dataset->size(), static_cast<size_t>(NUM_ROWS));
+
+    std::vector<double> prices;
+    std::promise<void> done_promise;
+    auto done_future = done_promise.get_future();
+    event_bus->subscribe(EventType::MARKET,
+                         [&](const Event &event)
+                         { prices.push_back(static_cast<const MarketEvent &>(event).price); });
+    event_bus->subscribe(EventType::SYSTEM, [&](const Event &)
+                         { done_promise.set_value(); });
+
+    DatasetReplayHandler data_handler(event_bus, "TEST_BTC", dataset);
+    data_handler.set_replay_delay(std::chrono::microseconds(0));
+
+    event_bus->start();
+    data_handler.start();
+
+    auto future_status = done_future.wait_for(std::chrono::seconds(5));
+
+    data_handler.stop();
+    event_bus->stop();
+
+    ASSERT_EQ(future_status, std::future_status::ready) << "Test timed out.";
+    ASSERT_EQ(prices.size(), static_cast<size_t>(NUM_ROWS));
+    for (int i = 0; i < NUM_ROWS; i += 997)
+    {
+        EXPECT_DOUBLE_EQ(prices[i], 100.0 + i * 0.25);
+    }
+}
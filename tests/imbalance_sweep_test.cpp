@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/Log.h"
+#include "core/Application.h"
+#include "analytics/ImbalanceSweep.h"
+#include "config/Config.h"
+#include "data/TickCodec.h"
+
+using namespace hft_system;
+
+class ImbalanceSweepTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Log::init();
+        file_path = (std::filesystem::temp_directory_path() / "hft_imbalance_sweep_test.ticks").string();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(file_path);
+        Log::shutdown();
+    }
+
+    // A random walk around 30000.00 with five levels per side whose sizes swing
+    // the imbalance between roughly 1:3 and 3:1.
+    void write_file(int updates)
+    {
+        std::mt19937 rng(7);
+        std::uniform_int_distribution<int> step(-20, 20);
+        std::uniform_int_distribution<int> lots(1000, 50000);
+        TickWriter writer(file_path, "BTCUSDT", 0.01, 0.00001);
+        ASSERT_TRUE(writer.open());
+        long long mid_ticks = 3000000;
+        for (int i = 0; i < updates; ++i)
+        {
+            mid_ticks += step(rng);
+            DepthUpdate book;
+            book.symbol = "BTCUSDT";
+            book.timestamp = 1700000000000LL + i;
+            for (int level = 0; level < 5; ++level)
+            {
+                book.bids.push_back({Price(mid_ticks - 1 - level), Quantity(lots(rng))});
+                book.asks.push_back({Price(mid_ticks + 1 + level), Quantity(lots(rng))});
+            }
+            writer.append(book);
+        }
+        writer.close();
+    }
+
+    Config config(double threshold) const
+    {
+        Config config;
+        config.run_mode = RunMode::BACKTEST;
+        config.data.format = "ticks";
+        config.data.file_path = file_path;
+        StrategyConfig strategy;
+        strategy.name = "ORDER_BOOK_IMBALANCE";
+        strategy.symbol = "BTCUSDT";
+        strategy.params.lookback_levels = 5;
+        strategy.params.imbalance_threshold = threshold;
+        config.strategies.push_back(strategy);
+        return config;
+    }
+
+    std::string file_path;
+};
+
+TEST_F(ImbalanceSweepTest, LanesMatchSweepingEachThresholdAlone)
+{
+    write_file(5000);
+    const std::vector<double> thresholds = {1.05, 1.2, 1.5, 2.0, 10.0};
+    ASSERT_TRUE(ImbalanceSweep::supports(config(1.5)));
+    ImbalanceSweep sweep(config(1.5), thresholds);
+    ASSERT_TRUE(sweep.run());
+    EXPECT_EQ(sweep.books_replayed(), 5000u);
+    ASSERT_EQ(sweep.lane_count(), thresholds.size());
+
+    for (size_t lane = 0; lane < thresholds.size(); ++lane)
+    {
+        ImbalanceSweep alone(config(1.5), {thresholds[lane]});
+        ASSERT_TRUE(alone.run());
+        EXPECT_EQ(sweep.equity_curve(lane), alone.equity_curve(0)) << "threshold " << thresholds[lane];
+        EXPECT_EQ(sweep.trade_log(lane).size(), alone.trade_log(0).size()) << "threshold " << thresholds[lane];
+        EXPECT_EQ(sweep.report(lane), alone.report(0)) << "threshold " << thresholds[lane];
+    }
+    EXPECT_GT(sweep.trade_log(0).size(), 0u);
+    // A tighter threshold never fires less often.
+    EXPECT_GE(sweep.equity_curve(0).size(), sweep.equity_curve(2).size());
+    // 10:1 never occurs, so that lane stays in cash.
+    EXPECT_EQ(sweep.equity_curve(4).size(), 1u);
+    EXPECT_TRUE(sweep.trade_log(4).empty());
+}
+
+// In lockstep every fill has reached the RiskManager before the next book,
+// which is the order the sweep assumes.
+TEST_F(ImbalanceSweepTest, MatchesALockstepBacktest)
+{
+    write_file(60);
+    Config lockstep = config(1.2);
+    lockstep.data.replay_delay_us = 0;
+    lockstep.data.lockstep = true;
+    Application app(lockstep);
+    auto backtest = app.run_backtest();
+
+    ImbalanceSweep sweep(lockstep, {1.2});
+    ASSERT_TRUE(sweep.run());
+    auto swept = sweep.report(0);
+
+    ASSERT_TRUE(backtest.count("final_equity"));
+    ASSERT_TRUE(swept.count("final_equity"));
+    EXPECT_NEAR(swept.at("final_equity"), backtest.at("final_equity"), 1e-6);
+    EXPECT_NEAR(swept.at("sharpe_ratio"), backtest.at("sharpe_ratio"), 1e-9);
+    ASSERT_TRUE(backtest.count("total_trades"));
+    ASSERT_TRUE(swept.count("total_trades"));
+    EXPECT_EQ(swept.at("total_trades"), backtest.at("total_trades"));
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include "analytics/MarketRegimeDetector.h"
+#include "core/EventBus.h"
+#include "core/Log.h"
+#include "core/SymbolRegistry.h"
+#include "events/Event.h"
+#include "utils/Indicators.h"
+
+using namespace hft_system;
+
+namespace
+{
+    std::vector<double> random_walk(size_t n, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::normal_distribution<double> step(0.0, 1.0);
+        std::vector<double> prices;
+        double price = 1000.0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            price += step(rng);
+            prices.push_back(price);
+        }
+        return prices;
+    }
+}
+
+TEST(IndicatorsTest, RingBufferKeepsTheNewestValuesInOrder)
+{
+    RingBuffer<int> ring(3);
+    EXPECT_EQ(ring.push(1), 0);
+    ring.push(2);
+    ring.push(3);
+    EXPECT_TRUE(ring.full());
+    EXPECT_EQ(ring.push(4), 1);
+    EXPECT_EQ(ring[0], 2);
+    EXPECT_EQ(ring[2], 4);
+    EXPECT_EQ(ring.back(), 4);
+}
+
+// Every indicator is checked against a from-scratch computation over its window.
+TEST(IndicatorsTest, RollingIndicatorsMatchRecomputingTheWindow)
+{
+    const std::vector<double> prices = random_walk(5000, 7);
+    for (size_t window : {1u, 2u, 7u, 64u})
+    {
+        RollingStats stats(window);
+        RollingMinMax min_max(window);
+        RollingVwap vwap(window);
+        ZScore z_score(window);
+        for (size_t i = 0; i < prices.size(); ++i)
+        {
+            const double volume = 1.0 + static_cast<double>(i % 5);
+            stats.push(prices[i]);
+            min_max.push(prices[i]);
+            vwap.push(prices[i], volume);
+            double z = z_score.push(prices[i]);
+
+            const size_t first = i + 1 >= window ? i + 1 - window : 0;
+            double sum = 0.0, low = prices[first], high = prices[first], notional = 0.0, traded = 0.0;
+            for (size_t j = first; j <= i; ++j)
+            {
+                sum += prices[j];
+                low = std::min(low, prices[j]);
+                high = std::max(high, prices[j]);
+                const double v = 1.0 + static_cast<double>(j % 5);
+                notional += prices[j] * v;
+                traded += v;
+            }
+            const double count = static_cast<double>(i + 1 - first);
+            const double mean = sum / count;
+            double squares = 0.0;
+            for (size_t j = first; j <= i; ++j)
+                squares += (prices[j] - mean) * (prices[j] - mean);
+            const double variance = squares / count;
+
+            ASSERT_NEAR(stats.mean(), mean, 1e-9) << "window " << window << ", tick " << i;
+            ASSERT_NEAR(stats.variance(), variance, 1e-6 * std::max(1.0, variance)) << "window " << window << ", tick " << i;
+            ASSERT_EQ(min_max.min(), low) << "window " << window << ", tick " << i;
+            ASSERT_EQ(min_max.max(), high) << "window " << window << ", tick " << i;
+            ASSERT_NEAR(vwap.value(), notional / traded, 1e-9);
+            const double expected_z = variance > 0.0 ? (prices[i] - mean) / std::sqrt(variance) : 0.0;
+            ASSERT_NEAR(z, expected_z, 1e-3); // Near-flat windows amplify the variance's rounding
+        }
+        EXPECT_TRUE(stats.ready());
+        EXPECT_TRUE(min_max.ready());
+    }
+}
+
+TEST(IndicatorsTest, EmaSeedsWithTheFirstValue)
+{
+    Ema ema(3); // alpha 0.5
+    EXPECT_FALSE(ema.ready());
+    EXPECT_DOUBLE_EQ(ema.push(10.0), 10.0);
+    EXPECT_DOUBLE_EQ(ema.push(20.0), 15.0);
+    EXPECT_DOUBLE_EQ(ema.push(15.0), 15.0);
+    EXPECT_TRUE(ema.ready());
+}
+
+TEST(IndicatorsTest, RegimeDetectorReportsTrendAndVolatility)
+{
+    Log::init();
+    auto bus = std::make_shared<EventBus>();
+    MarketRegimeDetector detector(bus, "TestRegimeDetector", 10, 20);
+    std::mutex mutex;
+    std::vector<MarketState> states;
+    std::promise<void> trending_down;
+    bus->subscribe(EventType::MARKET_REGIME_CHANGED, [&](const Event &event)
+                   {
+        std::lock_guard<std::mutex> lock(mutex);
+        states.push_back(static_cast<const MarketRegimeChangedEvent &>(event).state);
+        if (states.back().trend == MarketState::Trend::TRENDING_DOWN)
+            trending_down.set_value(); });
+    bus->start();
+    detector.start();
+
+    const SymbolId symbol = intern_symbol("REGIME");
+    double price = 100.0;
+    for (int i = 0; i < 40; ++i) // Calm, steady climb: low volatility, trending up
+        bus->publish(std::make_shared<MarketEvent>(symbol, price *= 1.003));
+    for (int i = 0; i < 40; ++i) // Violent swings drifting down
+        bus->publish(std::make_shared<MarketEvent>(symbol, price *= (i % 2 ? 1.03 : 0.95)));
+
+    ASSERT_EQ(trending_down.get_future().wait_for(std::chrono::seconds(2)), std::future_status::ready);
+    detector.stop();
+    bus->stop();
+
+    ASSERT_GE(states.size(), 2u);
+    EXPECT_EQ(states.front().trend, MarketState::Trend::TRENDING_UP);
+    EXPECT_EQ(states.front().volatility, MarketState::Volatility::LOW);
+    EXPECT_EQ(states.back().volatility, MarketState::Volatility::HIGH);
+    Log::shutdown();
+}
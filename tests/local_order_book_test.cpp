@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/Log.h"
+#include "core/SymbolRegistry.h"
+#include "data/BinanceDepthDecoder.h"
+#include "data/LocalOrderBook.h"
+#include "events/Event.h"
+
+using namespace hft_system;
+
+class LocalOrderBookTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Log::init();
+        DepthUpdate snapshot;
+        snapshot.bids = levels({{99.0, 1.0}, {100.0, 2.0}, {98.0, 3.0}});
+        snapshot.asks = levels({{102.0, 1.5}, {101.0, 2.5}, {103.0, 0.0}});
+        book.apply_snapshot(snapshot, 100);
+    }
+
+    void TearDown() override { Log::shutdown(); }
+
+    using Levels = std::initializer_list<std::pair<double, double>>;
+
+    // Test books use a 0.1 tick and 0.5 lot grid.
+    static inline const InstrumentSpec spec = InstrumentSpec::from(0.1, 0.5);
+
+    static std::vector<OrderBookLevel> levels(Levels pairs)
+    {
+        std::vector<OrderBookLevel> out;
+        for (const auto &[price, quantity] : pairs)
+            out.push_back({spec.to_price(price), spec.to_quantity(quantity)});
+        return out;
+    }
+
+    static DepthUpdate diff(Levels bids, Levels asks)
+    {
+        DepthUpdate book;
+        book.bids = levels(bids);
+        book.asks = levels(asks);
+        return book;
+    }
+
+    static double px(Price price) { return spec.to_double(price); }
+    static double qty(Quantity quantity) { return spec.to_double(quantity); }
+
+    LocalOrderBook book{"BTCUSDT"};
+};
+
+TEST_F(LocalOrderBookTest, SnapshotIsSortedWithBestLevelsFirstInView)
+{
+    ASSERT_TRUE(book.is_synced());
+    EXPECT_DOUBLE_EQ(px(book.best_bid().price), 100.0);
+    EXPECT_DOUBLE_EQ(px(book.best_ask().price), 101.0);
+    EXPECT_EQ(book.ask_depth(), 2u) << "Zero-quantity snapshot levels are dropped";
+
+    OrderBook view;
+    book.top_n(2, view);
+    EXPECT_EQ(symbol_name(view.symbol_id), "BTCUSDT");
+    ASSERT_EQ(view.bids.size(), 2u);
+    EXPECT_DOUBLE_EQ(px(view.bids.price[0]), 100.0);
+    EXPECT_DOUBLE_EQ(px(view.bids.price[1]), 99.0);
+    EXPECT_DOUBLE_EQ(px(view.asks.price[0]), 101.0);
+    EXPECT_DOUBLE_EQ(px(view.asks.price[1]), 102.0);
+}
+
+TEST_F(LocalOrderBookTest, DiffsInsertUpdateAndRemoveLevelsInPlace)
+{
+    // First diff only has to straddle the snapshot id.
+    ASSERT_EQ(book.apply_diff(diff({{100.5, 4.0}, {99.0, 0.0}}, {{101.0, 9.0}}), 95, 105),
+              LocalOrderBook::ApplyResult::APPLIED);
+    EXPECT_DOUBLE_EQ(px(book.best_bid().price), 100.5);
+    EXPECT_DOUBLE_EQ(qty(book.best_bid().quantity), 4.0);
+    EXPECT_DOUBLE_EQ(qty(book.best_ask().quantity), 9.0);
+    EXPECT_EQ(book.bid_depth(), 3u);
+
+    ASSERT_EQ(book.apply_diff(diff({}, {{101.0, 0.0}, {100.8, 1.0}}), 106, 107),
+              LocalOrderBook::ApplyResult::APPLIED);
+    EXPECT_DOUBLE_EQ(px(book.best_ask().price), 100.8);
+    EXPECT_EQ(book.last_update_id(), 107);
+
+    OrderBook view;
+    book.top_n(10, view);
+    std::vector<double> ask_prices;
+    for (size_t i = 0; i < view.asks.size(); ++i)
+        ask_prices.push_back(px(view.asks.price[i]));
+    EXPECT_EQ(ask_prices, (std::vector<double>{100.8, 102.0}));
+}
+
+TEST_F(LocalOrderBookTest, StaleDiffsAreIgnoredAndGapsDesynchronise)
+{
+    EXPECT_EQ(book.apply_diff(diff({{100.0, 50.0}}, {}), 90, 100), LocalOrderBook::ApplyResult::STALE);
+    EXPECT_DOUBLE_EQ(qty(book.best_bid().quantity), 2.0);
+
+    ASSERT_EQ(book.apply_diff(diff({}, {}), 101, 110), LocalOrderBook::ApplyResult::APPLIED);
+    EXPECT_EQ(book.apply_diff(diff({{100.0, 7.0}}, {}), 112, 115), LocalOrderBook::ApplyResult::GAP);
+    EXPECT_FALSE(book.is_synced());
+    EXPECT_EQ(book.apply_diff(diff({}, {}), 111, 111), LocalOrderBook::ApplyResult::NOT_SYNCED);
+    EXPECT_DOUBLE_EQ(qty(book.best_bid().quantity), 2.0) << "A diff after a gap must not be applied";
+}
+
+TEST_F(LocalOrderBookTest, FirstDiffMustReachSnapshot)
+{
+    EXPECT_EQ(book.apply_diff(diff({}, {}), 102, 103), LocalOrderBook::ApplyResult::GAP);
+}
+
+TEST_F(LocalOrderBookTest, DecodesRestSnapshot)
+{
+    std::string json = R"({"lastUpdateId":1027024,"bids":[["4.00000000","431.00000000"]],"asks":[["4.00000200","12.00000000"]]})";
+    json.resize(BinanceDepthDecoder::padded_capacity(json.size()), '\0');
+    size_t size = json.find('\0');
+
+    BinanceDepthDecoder decoder; // Default 1e-8 grid
+    DepthUpdate snapshot;
+    int64_t last_update_id = 0;
+    ASSERT_TRUE(decoder.decode_snapshot(json.data(), size, json.size(), snapshot, last_update_id));
+    EXPECT_EQ(last_update_id, 1027024);
+    ASSERT_EQ(snapshot.bids.size(), 1u);
+    EXPECT_EQ(snapshot.asks[0].price, Price(400000200));
+    EXPECT_EQ(snapshot.bids[0].quantity, Quantity(43100000000));
+}
+
+TEST_F(LocalOrderBookTest, ViewIsCappedAtFixedDepthAndCopiedWhole)
+{
+    DepthUpdate deep;
+    for (int i = 0; i < 50; ++i)
+    {
+        deep.bids.push_back({spec.to_price(1000.0 - i), spec.to_quantity(1.0)});
+        deep.asks.push_back({spec.to_price(1001.0 + i), spec.to_quantity(1.0)});
+    }
+    book.apply_snapshot(deep, 200);
+
+    OrderBook view;
+    book.top_n(100, view);
+    EXPECT_EQ(view.bids.size(), MAX_BOOK_DEPTH);
+    EXPECT_EQ(view.asks.size(), MAX_BOOK_DEPTH);
+    EXPECT_DOUBLE_EQ(px(view.bids.price[MAX_BOOK_DEPTH - 1]), 1000.0 - (MAX_BOOK_DEPTH - 1));
+
+    // Publishing copies the book by value; the event must not alias the scratch view.
+    OrderBookEvent event(view);
+    view.bids.price[0] = Price(0);
+    EXPECT_DOUBLE_EQ(px(event.book.bids.price[0]), 1000.0);
+    EXPECT_EQ(alignof(OrderBook), 64u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&event.book) % 64, 0u);
+}
@@ -5,6 +5,7 @@
 
 #include "core/Log.h"
 #include "core/EventBus.h"
+#include "core/SymbolRegistry.h"
 #include "data/HistoricCSVDataHandler.h"
 #include "events/Event.h"
 
@@ -34,7 +35,7 @@ TEST_F(ArchitectureTest, DataHandlerPublishesAndEventBusDispatches)
                          [&](const Event &event)
                          {
                              const auto *market_event = dynamic_cast<const MarketEvent *>(&event);
-                             if (market_event && market_event->symbol == "TEST_BTC")
+                             if (market_event && market_event->symbol_id == intern_symbol("TEST_BTC"))
                              {
                                  price_promise.set_value(market_event->price);
                              }
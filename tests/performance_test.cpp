@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <chrono>
+#include <cmath>
 #include <thread>
 #include <future>
 #include <memory>
@@ -12,6 +13,13 @@
 #include "config/Config.h"
 #include "utils/Timer.h"
 #include "utils/PerformanceMonitor.h"
+#include "core/SymbolRegistry.h"
+#include "strategy/BookImbalance.h"
+#include "strategy/BookKernels.h"
+#include "strategy/StaticStrategySet.h"
+#include "strategy/StrategyManager.h"
+#include <algorithm>
+#include <vector>
 
 using namespace hft_system;
 
@@ -94,4 +102,170 @@ TEST_F(PerformanceTest, EndToEndSystemPerformance)
 
     // Ensure the test passes if we collected metrics
     ASSERT_GT(metrics.size(), 0);
-}
\ No newline at end of file
+}
+
+namespace
+{
+    // Sums the top levels of its symbol's book; signals on a strong imbalance.
+    class TopLevelsStrategy : public Strategy
+    {
+    public:
+        static constexpr uint32_t INTERESTS = ORDER_BOOK;
+        explicit TopLevelsStrategy(SymbolId symbol_id) : symbol_id_(symbol_id) {}
+        uint32_t interests() const override { return INTERESTS; }
+
+        void on_order_book(const OrderBookEvent &event, SignalSink &signals) override
+        {
+            if (event.book.symbol_id != symbol_id_)
+                return;
+            int64_t bids = 0, asks = 0;
+            for (size_t i = 0; i < 10; ++i)
+            {
+                bids += event.book.bids.quantity[i].value;
+                asks += event.book.asks.quantity[i].value;
+            }
+            if (bids > 3 * asks)
+                signals.emit(symbol_id_, OrderDirection::BUY);
+        }
+
+    private:
+        SymbolId symbol_id_;
+    };
+
+    class TradeCountStrategy : public Strategy
+    {
+    public:
+        static constexpr uint32_t INTERESTS = MARKET;
+        uint32_t interests() const override { return INTERESTS; }
+        void on_market(const MarketEvent &, SignalSink &) override
+        {
+            ++trades_;
+        }
+
+    private:
+        int64_t trades_ = 0;
+    };
+}
+
+// Per-tick dispatch cost of the same strategies behind StrategyManager
+// (virtual hooks through per-type lists) and StaticStrategySet (inlined fold).
+TEST_F(PerformanceTest, StaticStrategySetDispatchAgainstStrategyManager)
+{
+    constexpr int SYMBOLS = 8;
+    constexpr int TICKS = 200000;
+    auto bus = std::make_shared<EventBus>(); // Not started: handlers are driven directly
+
+    StrategyManager manager(bus, "BenchStrategyManager");
+    StaticStrategySet<TopLevelsStrategy, TradeCountStrategy> pipeline(bus, "BenchStaticStrategySet");
+    std::vector<std::shared_ptr<OrderBookEvent>> books;
+    for (int s = 0; s < SYMBOLS; ++s)
+    {
+        SymbolId id = intern_symbol("BENCH" + std::to_string(s));
+        manager.add_strategy(std::make_unique<TopLevelsStrategy>(id));
+        manager.add_strategy(std::make_unique<TradeCountStrategy>());
+        pipeline.add_strategy(TopLevelsStrategy(id));
+        pipeline.add_strategy(TradeCountStrategy());
+
+        OrderBook book{};
+        book.symbol_id = id;
+        for (size_t level = 0; level < MAX_BOOK_DEPTH; ++level)
+        {
+            book.bids.price[level] = Price(10000 - static_cast<int64_t>(level));
+            book.bids.quantity[level] = Quantity(100 + s + static_cast<int64_t>(level));
+            book.asks.price[level] = Price(10001 + static_cast<int64_t>(level));
+            book.asks.quantity[level] = Quantity(100 + static_cast<int64_t>(level));
+        }
+        book.bids.depth = book.asks.depth = MAX_BOOK_DEPTH;
+        books.push_back(std::make_shared<OrderBookEvent>(book));
+    }
+
+    auto per_tick_ns = [&](auto &dispatcher)
+    {
+        double best = 1e18;
+        for (int run = 0; run < 5; ++run)
+        {
+            Timer timer;
+            for (int tick = 0; tick < TICKS; ++tick)
+                dispatcher.on_order_book_event(*books[tick % SYMBOLS]);
+            best = std::min(best, static_cast<double>(timer.elapsed_nanoseconds()) / TICKS);
+        }
+        return best;
+    };
+    double dynamic_ns = per_tick_ns(manager);
+    double static_ns = per_tick_ns(pipeline);
+    Log::get_logger()->info("Strategy dispatch per tick ({} strategies): StrategyManager {:.1f} ns, StaticStrategySet {:.1f} ns",
+                            2 * SYMBOLS, dynamic_ns, static_ns);
+
+    EXPECT_GT(dynamic_ns, 0.0);
+    EXPECT_LT(static_ns, dynamic_ns * 1.5);
+}
+
+// Per-book cost of the order book kernels over a few hundred symbols' books,
+// the selected implementation against the scalar one.
+TEST_F(PerformanceTest, BookKernelsAgainstScalar)
+{
+    constexpr int SYMBOLS = 256;
+    constexpr int ROUNDS = 400;
+    std::vector<OrderBook> books(SYMBOLS);
+    for (int s = 0; s < SYMBOLS; ++s)
+    {
+        for (size_t level = 0; level < MAX_BOOK_DEPTH; ++level)
+        {
+            books[s].bids.push_back(Price(100000 - s - 2 * static_cast<int64_t>(level)), Quantity(100 + (s * 7 + level * 13) % 400));
+            books[s].asks.push_back(Price(100001 + s + static_cast<int64_t>(level)), Quantity(100 + (s * 11 + level * 5) % 400));
+        }
+    }
+
+    auto features_ns = [&](const BookKernels &kernels)
+    {
+        BookFeatures features;
+        double checksum = 0.0;
+        double best = 1e18;
+        for (int run = 0; run < 5; ++run)
+        {
+            Timer timer;
+            for (int round = 0; round < ROUNDS; ++round)
+            {
+                for (const OrderBook &book : books)
+                {
+                    kernels.features(book, MAX_BOOK_DEPTH, 500, features);
+                    checksum += features.pressure;
+                }
+            }
+            best = std::min(best, static_cast<double>(timer.elapsed_nanoseconds()) / (ROUNDS * SYMBOLS));
+        }
+        EXPECT_TRUE(std::isfinite(checksum));
+        return best;
+    };
+    auto changed_levels_ns = [&](const BookKernels &kernels)
+    {
+        uint32_t changed = 0;
+        double best = 1e18;
+        for (int run = 0; run < 5; ++run)
+        {
+            Timer timer;
+            for (int round = 0; round < ROUNDS; ++round)
+            {
+                for (int s = 0; s + 1 < SYMBOLS; ++s)
+                    changed ^= kernels.changed_levels(lots(books[s].bids), lots(books[s + 1].bids), MAX_BOOK_DEPTH);
+            }
+            best = std::min(best, static_cast<double>(timer.elapsed_nanoseconds()) / (ROUNDS * (SYMBOLS - 1)));
+        }
+        volatile uint32_t sink = changed; // Keeps the calls from being optimised away
+        (void)sink;
+        return best;
+    };
+
+    const BookKernels &scalar = scalar_book_kernels();
+    const BookKernels &selected = book_kernels();
+    double scalar_features_ns = features_ns(scalar);
+    double selected_features_ns = features_ns(selected);
+    double scalar_changed_ns = changed_levels_ns(scalar);
+    double selected_changed_ns = changed_levels_ns(selected);
+    Log::get_logger()->info("Book features per book ({} levels): scalar {:.1f} ns, {} {:.1f} ns",
+                            MAX_BOOK_DEPTH, scalar_features_ns, selected.name, selected_features_ns);
+    Log::get_logger()->info("Changed levels per side: scalar {:.1f} ns, {} {:.1f} ns",
+                            scalar_changed_ns, selected.name, selected_changed_ns);
+
+    EXPECT_GT(scalar_features_ns, 0.0);
+}
@@ -4,6 +4,7 @@
 
 #include "core/Log.h"
 #include "core/EventBus.h"
+#include "core/SymbolRegistry.h"
 #include "core/PortfolioManager.h"
 #include "events/Event.h"
 
@@ -47,7 +48,9 @@ TEST_F(PortfolioManagerTest, ShouldProcessFillEventAndUpdateState) {
 
     // 2. Act
     // Manually publish a FillEvent, as if from the ExecutionHandler
-    auto fill_event = std::make_shared<FillEvent>("AAPL", OrderDirection::BUY, 10, 150.25, 1.50);
+    const SymbolId aapl = intern_symbol("AAPL");
+    const InstrumentSpec spec = instrument_spec(aapl);
+    auto fill_event = std::make_shared<FillEvent>(aapl, OrderDirection::BUY, spec.to_quantity(10), spec.to_price(150.25), 1.50);
     event_bus->publish(fill_event);
 
     // 3. Assert
@@ -0,0 +1,289 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/Log.h"
+#include "core/EventBus.h"
+#include "core/SymbolRegistry.h"
+#include "data/ReplayServer.h"
+#include "data/WebSocketDataHandler.h"
+#include "events/Event.h"
+
+using namespace hft_system;
+
+// Drives the LIVE data path against a local ReplayServer playing
+// tests/data/depth_messages.jsonl: 500 BTCUSDT depth diffs continuing
+// tests/data/depth_snapshot.json, with a trade after every fifth diff.
+class ReplayServerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Log::init();
+        event_bus = std::make_shared<EventBus>();
+        btcusdt = intern_symbol("BTCUSDT");
+        SymbolRegistry::get_instance().set_spec(btcusdt, InstrumentSpec::from(0.01, 0.00001));
+
+        options.messages_file = std::string(PROJECT_SOURCE_DIR) + "/tests/data/depth_messages.jsonl";
+        options.speed = 0.0;
+    }
+
+    void TearDown() override { Log::shutdown(); }
+
+    WebSocketConfig live_config(const ReplayServer &server, std::vector<std::string> streams) const
+    {
+        WebSocketConfig config;
+        config.host = "127.0.0.1";
+        config.port = server.port();
+        config.target = "/stream";
+        config.use_tls = false;
+        config.symbols = {"BTCUSDT"};
+        config.streams = std::move(streams);
+        config.snapshot_file = std::string(PROJECT_SOURCE_DIR) + "/tests/data/depth_snapshot.json";
+        return config;
+    }
+
+    static constexpr int DEPTH_UPDATES = 500;
+    static constexpr int TRADES = 100;
+    std::shared_ptr<EventBus> event_bus;
+    SymbolId btcusdt = INVALID_SYMBOL_ID;
+    ReplayServerOptions options;
+};
+
+TEST_F(ReplayServerTest, LivePipelineRebuildsTheRecordedBook)
+{
+    options.record_send_times = true;
+    ReplayServer server(options);
+    ASSERT_TRUE(server.start());
+    ASSERT_EQ(server.messages().size(), static_cast<size_t>(DEPTH_UPDATES + TRADES));
+
+    std::mutex mutex;
+    OrderBook last_book{};
+    int books = 0;
+    std::vector<int64_t> trade_arrivals;
+    std::promise<void> done;
+    auto check_done = [&]()
+    {
+        if (books == DEPTH_UPDATES + 1 && trade_arrivals.size() == TRADES)
+            done.set_value();
+    };
+    event_bus->subscribe(EventType::ORDER_BOOK, [&](const Event &event)
+                         {
+        std::lock_guard<std::mutex> lock(mutex);
+        last_book = static_cast<const OrderBookEvent &>(event).book;
+        ++books; // The seeded snapshot plus one per diff
+        check_done(); });
+    event_bus->subscribe(EventType::MARKET, [&](const Event &event)
+                         {
+        std::lock_guard<std::mutex> lock(mutex);
+        trade_arrivals.push_back(event.timestamp);
+        check_done(); });
+    event_bus->start();
+
+    auto start = std::chrono::steady_clock::now();
+    auto handler = std::make_shared<WebSocketDataHandler>(event_bus, live_config(server, {"depth", "trade"}));
+    handler->start();
+    auto status = done.get_future().wait_for(std::chrono::seconds(10));
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    handler->stop();
+    server.stop();
+    event_bus->stop();
+    ASSERT_EQ(status, std::future_status::ready) << "Saw " << books << " books and " << trade_arrivals.size() << " trades";
+
+    // Final top of book after replaying every diff onto the snapshot.
+    EXPECT_EQ(last_book.symbol_id, btcusdt);
+    EXPECT_EQ(last_book.bids.price[0], Price(2699925));
+    EXPECT_EQ(last_book.bids.quantity[0], Quantity(66000));
+    EXPECT_EQ(last_book.asks.price[0], Price(2700064));
+    EXPECT_EQ(last_book.asks.quantity[0], Quantity(161000));
+
+    auto stats = handler->get_stream_statistics();
+    EXPECT_EQ(stats["btcusdt@depth"]["messages"], DEPTH_UPDATES);
+    EXPECT_EQ(stats["btcusdt@trade"]["messages"], TRADES);
+
+    // End-to-end latency: server send to MarketEvent creation, trade by trade.
+    std::vector<int64_t> latencies;
+    size_t trade = 0;
+    for (const auto &record : server.send_records())
+    {
+        if (server.messages()[record.message].stream == "btcusdt@trade" && trade < trade_arrivals.size())
+            latencies.push_back(trade_arrivals[trade++] - record.sent_at_ns);
+    }
+    ASSERT_EQ(latencies.size(), static_cast<size_t>(TRADES));
+    std::sort(latencies.begin(), latencies.end());
+    Log::get_logger()->info("Replay: {} messages in {:.3f} s ({:.0f} msg/s), depth parse avg {:.0f} ns, "
+                            "send-to-event latency p50 {} us, p99 {} us",
+                            DEPTH_UPDATES + TRADES, seconds, (DEPTH_UPDATES + TRADES) / seconds,
+                            stats["btcusdt@depth"]["avg_parse_ns"], latencies[latencies.size() / 2] / 1000,
+                            latencies[latencies.size() * 99 / 100] / 1000);
+}
+
+TEST_F(ReplayServerTest, PacesMessagesAtTheConfiguredSpeed)
+{
+    // The recording spans 5 s of exchange time; at 20x it should take about 250 ms.
+    options.speed = 20.0;
+    ReplayServer server(options);
+    ASSERT_TRUE(server.start());
+
+    std::atomic<int> trades{0};
+    std::promise<void> done;
+    event_bus->subscribe(EventType::MARKET, [&](const Event &)
+                         {
+        if (++trades == TRADES)
+            done.set_value(); });
+    event_bus->start();
+
+    auto start = std::chrono::steady_clock::now();
+    auto handler = std::make_shared<WebSocketDataHandler>(event_bus, live_config(server, {"trade"}));
+    handler->start();
+    auto status = done.get_future().wait_for(std::chrono::seconds(10));
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    handler->stop();
+    server.stop();
+    event_bus->stop();
+
+    ASSERT_EQ(status, std::future_status::ready);
+    EXPECT_GE(seconds, 0.2);
+    EXPECT_LT(seconds, 2.5);
+}
+
+TEST_F(ReplayServerTest, DropsConnectionsAfterConfiguredMessageCount)
+{
+    options.disconnect_after = 50;
+    ReplayServer server(options);
+    ASSERT_TRUE(server.start());
+
+    std::atomic<int> events{0};
+    event_bus->subscribe(EventType::MARKET, [&](const Event &)
+                         { ++events; });
+    event_bus->start();
+
+    WebSocketConfig config = live_config(server, {"trade"});
+    config.max_reconnects = 0;
+    auto handler = std::make_shared<WebSocketDataHandler>(event_bus, config);
+    handler->start();
+    for (int i = 0; i < 200 && server.messages_sent() < 50; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    handler->stop();
+    server.stop();
+    event_bus->stop();
+
+    EXPECT_EQ(server.connections_accepted(), 1);
+    EXPECT_EQ(server.messages_sent(), 50);
+    EXPECT_LE(events.load(), 50);
+}
+
+// Records the books published for BTCUSDT and checks the resync invariants:
+// each session starts from the snapshot, and after a book is withdrawn
+// (published empty) the next real book is a fresh snapshot again.
+struct BookLog
+{
+    std::mutex mutex;
+    std::vector<OrderBook> books;
+
+    static bool is_seed(const OrderBook &book)
+    {
+        // Top of tests/data/depth_snapshot.json
+        return book.bids.price[0] == Price(2700000) && book.bids.quantity[0] == Quantity(175000) &&
+               book.asks.price[0] == Price(2700001) && book.asks.quantity[0] == Quantity(95000);
+    }
+
+    // Sessions (runs of real books) that start from the snapshot and are cut by an empty book.
+    int completed_sessions()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        int sessions = 0;
+        for (size_t i = 1; i < books.size(); ++i)
+            sessions += books[i].bids.empty() && books[i].asks.empty() && !books[i - 1].bids.empty();
+        return sessions;
+    }
+
+    void expect_every_session_starts_from_the_snapshot()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ASSERT_FALSE(books.empty());
+        EXPECT_TRUE(is_seed(books.front()));
+        for (size_t i = 1; i < books.size(); ++i)
+        {
+            bool previous_empty = books[i - 1].bids.empty() && books[i - 1].asks.empty();
+            bool empty = books[i].bids.empty() && books[i].asks.empty();
+            if (previous_empty && !empty)
+                EXPECT_TRUE(is_seed(books[i])) << "book " << i << " follows a withdrawn book without a resync";
+        }
+    }
+};
+
+TEST_F(ReplayServerTest, ReconnectsAndResynchronisesAfterTheServerDropsTheConnection)
+{
+    options.disconnect_after = 150;
+    ReplayServer server(options);
+    ASSERT_TRUE(server.start());
+
+    BookLog log;
+    event_bus->subscribe(EventType::ORDER_BOOK, [&](const Event &event)
+                         {
+        std::lock_guard<std::mutex> lock(log.mutex);
+        log.books.push_back(static_cast<const OrderBookEvent &>(event).book); });
+    event_bus->start();
+
+    WebSocketConfig config = live_config(server, {"depth", "trade"});
+    config.reconnect_initial_ms = 10;
+    auto handler = std::make_shared<WebSocketDataHandler>(event_bus, config);
+    handler->start();
+    for (int i = 0; i < 500 && log.completed_sessions() < 3; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    handler->stop();
+    server.stop();
+    event_bus->stop();
+
+    EXPECT_GE(log.completed_sessions(), 3);
+    EXPECT_GE(server.connections_accepted(), 3);
+    EXPECT_GE(handler->reconnect_count(), 2);
+    EXPECT_EQ(handler->gap_count(), 0u);
+    log.expect_every_session_starts_from_the_snapshot();
+}
+
+TEST_F(ReplayServerTest, WithdrawsTheBookOnASequenceGapUntilResynchronised)
+{
+    // Diff k sits at index k + k / 5 (a trade follows every fifth diff); lose diff 100 (U = u = 1101).
+    options.drop_messages = {120};
+    ReplayServer server(options);
+    ASSERT_TRUE(server.start());
+    ASSERT_NE(server.messages()[120].frame.find("\"U\":1101"), std::string::npos);
+
+    BookLog log;
+    event_bus->subscribe(EventType::ORDER_BOOK, [&](const Event &event)
+                         {
+        std::lock_guard<std::mutex> lock(log.mutex);
+        log.books.push_back(static_cast<const OrderBookEvent &>(event).book); });
+    event_bus->start();
+
+    WebSocketConfig config = live_config(server, {"depth"});
+    config.reconnect_initial_ms = 10;
+    auto handler = std::make_shared<WebSocketDataHandler>(event_bus, config);
+    handler->start();
+    for (int i = 0; i < 500 && log.completed_sessions() < 2; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    handler->stop();
+    server.stop();
+    event_bus->stop();
+
+    EXPECT_GE(handler->gap_count(), 2u);
+    EXPECT_GE(handler->reconnect_count(), 1);
+    log.expect_every_session_starts_from_the_snapshot();
+
+    // The first session publishes the snapshot and the 100 diffs before the gap, then withdraws the book.
+    std::lock_guard<std::mutex> lock(log.mutex);
+    ASSERT_GT(log.books.size(), 102u);
+    for (size_t i = 0; i < 101; ++i)
+        EXPECT_FALSE(log.books[i].bids.empty()) << "book " << i;
+    EXPECT_TRUE(log.books[101].bids.empty() && log.books[101].asks.empty());
+}
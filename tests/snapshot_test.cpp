@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/Log.h"
+#include "core/EventBus.h"
+#include "core/PortfolioManager.h"
+#include "core/Snapshot.h"
+#include "core/SymbolRegistry.h"
+#include "analytics/MarketRegimeDetector.h"
+#include "events/Event.h"
+#include "strategy/MovingAverageCrossStrategy.h"
+#include "strategy/OrderBookImbalanceStrategy.h"
+#include "strategy/StrategyManager.h"
+
+using namespace hft_system;
+
+class SnapshotTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Log::init();
+        path = (std::filesystem::temp_directory_path() / "hft_snapshot_test.snap").string();
+        std::filesystem::remove(path);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+        Log::shutdown();
+    }
+
+    // A wave, so moving averages keep crossing.
+    static double price(int i) { return 100.0 + 5.0 * std::sin(i / 7.0) + 0.01 * i; }
+
+    std::string path;
+};
+
+TEST_F(SnapshotTest, RoundTripsSectionsAndRejectsIncompatibleFiles)
+{
+    Snapshot snapshot;
+    SnapshotWriter &out = snapshot.add_section("A", 3);
+    out.put(int64_t(-42));
+    out.put_string("hello");
+    out.put_vector(std::vector<double>{1.5, 2.5});
+    snapshot.add_section("B", 1).put(uint8_t(7));
+    ASSERT_TRUE(snapshot.save(path));
+
+    Snapshot loaded;
+    ASSERT_TRUE(loaded.load(path));
+    EXPECT_EQ(loaded.section_count(), 2u);
+    auto in = loaded.section("A", 3);
+    ASSERT_TRUE(in);
+    int64_t number = 0;
+    std::string text;
+    std::vector<double> values;
+    EXPECT_TRUE(in->get(number) && in->get_string(text) && in->get_vector(values));
+    EXPECT_EQ(number, -42);
+    EXPECT_EQ(text, "hello");
+    EXPECT_EQ(values, (std::vector<double>{1.5, 2.5}));
+    EXPECT_TRUE(in->at_end());
+    uint8_t extra;
+    EXPECT_FALSE(in->get(extra));
+    EXPECT_FALSE(in->ok());
+
+    // A section written under another layout version is not handed out.
+    EXPECT_FALSE(loaded.section("A", 4));
+    EXPECT_FALSE(loaded.section("C", 1));
+
+    // A flipped byte, a truncated file and a foreign file are all rejected.
+    std::string bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    auto rewrite = [&](const std::string &contents)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    };
+    std::string corrupt = bytes;
+    corrupt[bytes.size() / 2] ^= 0x40;
+    rewrite(corrupt);
+    EXPECT_FALSE(loaded.load(path));
+    EXPECT_TRUE(loaded.empty());
+    rewrite(bytes.substr(0, bytes.size() - 3));
+    EXPECT_FALSE(loaded.load(path));
+    rewrite(std::string(64, 'x'));
+    EXPECT_FALSE(loaded.load(path));
+    rewrite(bytes);
+    EXPECT_TRUE(loaded.load(path));
+}
+
+TEST_F(SnapshotTest, FailedWriteKeepsTheLastGoodSnapshot)
+{
+    if (!std::filesystem::exists("/dev/full"))
+        GTEST_SKIP() << "No /dev/full to fail writes with";
+    Snapshot good;
+    good.add_section("A", 1).put(int64_t(1));
+    ASSERT_TRUE(good.save(path));
+
+    // Every write to /dev/full fails with ENOSPC, as on a full disk.
+    const std::string tmp_path = path + ".tmp";
+    std::filesystem::remove(tmp_path);
+    std::filesystem::create_symlink("/dev/full", tmp_path);
+    Snapshot next;
+    next.add_section("A", 1).put(int64_t(2));
+    EXPECT_FALSE(next.save(path));
+    EXPECT_FALSE(std::filesystem::is_symlink(tmp_path));
+
+    Snapshot loaded;
+    ASSERT_TRUE(loaded.load(path));
+    auto in = loaded.section("A", 1);
+    int64_t value = 0;
+    ASSERT_TRUE(in && in->get(value));
+    EXPECT_EQ(value, 1);
+}
+
+TEST_F(SnapshotTest, RestoredStrategiesTradeLikeTheOriginals)
+{
+    const SymbolId symbol = intern_symbol("SNAPSHOT_TEST");
+    auto bus = std::make_shared<EventBus>();
+
+    StrategyManager original(bus, "StrategyManager");
+    auto crossover = std::make_unique<MovingAverageCrossStrategy>("SNAPSHOT_TEST", 5, 30);
+    MovingAverageCrossStrategy *original_crossover = crossover.get();
+    original.add_strategy(std::move(crossover));
+    auto imbalance = std::make_unique<OrderBookImbalanceStrategy>("SNAPSHOT_TEST", 5, 1.5);
+    OrderBookImbalanceStrategy *original_imbalance = imbalance.get();
+    original.add_strategy(std::move(imbalance));
+
+    SignalSink sink;
+    for (int i = 0; i < 200; ++i)
+        original_crossover->on_market(MarketEvent(symbol, price(i)), sink);
+    original_imbalance->on_news(NewsEvent(symbol, "headline", -0.9));
+    MarketState volatile_market;
+    volatile_market.volatility = MarketState::Volatility::HIGH;
+    original_imbalance->on_market_regime_change(volatile_market);
+
+    Snapshot snapshot;
+    original.save_snapshot(snapshot);
+    ASSERT_TRUE(snapshot.save(path));
+
+    Snapshot loaded;
+    ASSERT_TRUE(loaded.load(path));
+    StrategyManager restored(bus, "StrategyManager");
+    auto restored_crossover_owner = std::make_unique<MovingAverageCrossStrategy>("SNAPSHOT_TEST", 5, 30);
+    MovingAverageCrossStrategy *restored_crossover = restored_crossover_owner.get();
+    restored.add_strategy(std::move(restored_crossover_owner));
+    auto restored_imbalance_owner = std::make_unique<OrderBookImbalanceStrategy>("SNAPSHOT_TEST", 5, 1.5);
+    OrderBookImbalanceStrategy *restored_imbalance = restored_imbalance_owner.get();
+    restored.add_strategy(std::move(restored_imbalance_owner));
+    restored.restore_snapshot(loaded);
+
+    // Without the restore, the crossover would stay silent for 30 prices.
+    int signals = 0;
+    for (int i = 200; i < 400; ++i)
+    {
+        SignalSink expected, actual;
+        original_crossover->on_market(MarketEvent(symbol, price(i)), expected);
+        restored_crossover->on_market(MarketEvent(symbol, price(i)), actual);
+        ASSERT_EQ(actual.size(), expected.size()) << "price " << i;
+        if (!expected.empty())
+        {
+            EXPECT_EQ(actual.begin()->direction, expected.begin()->direction);
+        }
+        signals += static_cast<int>(expected.size());
+    }
+    EXPECT_GT(signals, 0);
+
+    // The restored high-volatility threshold (2.25) filters a 1.6:1 sell
+    // pressure the base threshold would trade, and the restored negative
+    // sentiment vetoes a 2.5:1 buy.
+    auto book = [&](int64_t bid_lots, int64_t ask_lots)
+    {
+        OrderBook book{};
+        book.symbol_id = symbol;
+        book.bids.push_back(Price(9999), Quantity(bid_lots));
+        book.asks.push_back(Price(10001), Quantity(ask_lots));
+        return OrderBookEvent(book);
+    };
+    OrderBookImbalanceStrategy cold_imbalance("SNAPSHOT_TEST", 5, 1.5);
+    for (const auto &event : {book(100, 160), book(250, 100)})
+    {
+        SignalSink cold, expected, actual;
+        cold_imbalance.on_order_book(event, cold);
+        original_imbalance->on_order_book(event, expected);
+        restored_imbalance->on_order_book(event, actual);
+        EXPECT_EQ(cold.size(), 1u);
+        EXPECT_TRUE(expected.empty());
+        EXPECT_TRUE(actual.empty());
+    }
+
+    // A different strategy line-up does not take the snapshot.
+    StrategyManager reshaped(bus, "StrategyManager");
+    auto lone_owner = std::make_unique<MovingAverageCrossStrategy>("SNAPSHOT_TEST", 5, 30);
+    MovingAverageCrossStrategy *lone = lone_owner.get();
+    reshaped.add_strategy(std::move(lone_owner));
+    reshaped.restore_snapshot(loaded);
+    SignalSink cold;
+    lone->on_market(MarketEvent(symbol, price(400)), cold);
+    EXPECT_TRUE(cold.empty());
+}
+
+TEST_F(SnapshotTest, RestoresPortfolioAndRegimeHistory)
+{
+    const SymbolId symbol = intern_symbol("SNAPSHOT_TEST");
+    const InstrumentSpec spec = instrument_spec(symbol);
+
+    auto bus = std::make_shared<EventBus>();
+    PortfolioManager portfolio(bus, "PortfolioManager", 100000.0);
+    MarketRegimeDetector detector(bus, "MarketRegimeDetector", 20, 40);
+    detector.start();
+    bus->publish(std::make_shared<FillEvent>(symbol, OrderDirection::BUY, spec.to_quantity(10), spec.to_price(150.25), 1.5));
+    for (int i = 0; i < 100; ++i)
+        bus->publish(std::make_shared<MarketEvent>(symbol, price(i)));
+    bus->start();
+    bus->stop(); // Drains the queue
+
+    Snapshot snapshot;
+    portfolio.save_snapshot(snapshot);
+    detector.save_snapshot(snapshot);
+    ASSERT_TRUE(snapshot.save(path));
+    Snapshot loaded;
+    ASSERT_TRUE(loaded.load(path));
+
+    auto restored_bus = std::make_shared<EventBus>();
+    PortfolioManager restored_portfolio(restored_bus, "PortfolioManager", 100000.0);
+    restored_portfolio.restore_snapshot(loaded);
+    EXPECT_NEAR(restored_portfolio.cash(), 100000.0 - 1502.5 - 1.5, 1e-9);
+    EXPECT_DOUBLE_EQ(restored_portfolio.cash(), portfolio.cash());
+    EXPECT_DOUBLE_EQ(restored_portfolio.total_equity(), portfolio.total_equity());
+
+    // Closing the restored position books a trade against the saved entry price.
+    restored_bus->publish(std::make_shared<FillEvent>(symbol, OrderDirection::SELL, spec.to_quantity(10), spec.to_price(151.25), 1.5));
+    restored_bus->start();
+    restored_bus->stop();
+    ASSERT_EQ(restored_portfolio.get_trade_log().size(), 1u);
+    EXPECT_NEAR(restored_portfolio.get_trade_log().front().pnl, 10.0 - 1.5, 1e-9);
+
+    MarketRegimeDetector restored_detector(restored_bus, "MarketRegimeDetector", 20, 40);
+    restored_detector.restore_snapshot(loaded);
+    EXPECT_EQ(restored_detector.current_state().trend, detector.current_state().trend);
+    EXPECT_EQ(restored_detector.current_state().volatility, detector.current_state().volatility);
+}
@@ -1,12 +1,16 @@
 // tests/strategy_manager_test.cpp
 #include <gtest/gtest.h>
+#include <atomic>
 #include <future>
 #include <memory>
+#include <vector>
 
 #include "core/Log.h"
 #include "core/EventBus.h"
+#include "core/SymbolRegistry.h"
 #include "strategy/StrategyManager.h"
 #include "strategy/BuyEveryTickStrategy.h"
+#include "strategy/StaticStrategySet.h"
 #include "events/Event.h"
 
 using namespace hft_system;
@@ -39,7 +43,7 @@ TEST_F(StrategyManagerTest, ShouldGenerateSignalEventOnMarketEvent) {
     event_bus->subscribe(EventType::SIGNAL,
         [&](const Event& event) {
             const auto& signal_event = dynamic_cast<const SignalEvent&>(event);
-            EXPECT_EQ(signal_event.symbol, "MSFT");
+            EXPECT_EQ(symbol_name(signal_event.symbol_id), "MSFT");
             EXPECT_EQ(signal_event.direction, OrderDirection::BUY);
             signal_received_promise.set_value(true);
         });
@@ -49,7 +53,7 @@ TEST_F(StrategyManagerTest, ShouldGenerateSignalEventOnMarketEvent) {
 
     // 2. Act
     // Manually publish a MarketEvent, as if it came from a DataHandler
-    auto market_event = std::make_shared<MarketEvent>("MSFT", 300.50);
+    auto market_event = std::make_shared<MarketEvent>(intern_symbol("MSFT"), 300.50);
     event_bus->publish(market_event);
 
     // 3. Assert
@@ -59,4 +63,155 @@ TEST_F(StrategyManagerTest, ShouldGenerateSignalEventOnMarketEvent) {
     // Cleanup
     strategy_manager->stop();
     event_bus->stop();
-}
\ No newline at end of file
+}
+
+// Receives only what it declared; counts every hook call.
+class BookAndBarStrategy : public Strategy {
+public:
+    static constexpr uint32_t INTERESTS = ORDER_BOOK | BAR;
+    explicit BookAndBarStrategy(std::atomic<int>& market_calls) : market_calls_(market_calls) {}
+    uint32_t interests() const override { return INTERESTS; }
+    void on_market(const MarketEvent&, SignalSink&) override {
+        ++market_calls_;
+    }
+    void on_order_book(const OrderBookEvent& event, SignalSink& signals) override {
+        signals.emit(event.book.symbol_id, OrderDirection::BUY);
+    }
+    void on_bar(const BarEvent& event, SignalSink& signals) override {
+        signals.emit(event.symbol_id, OrderDirection::SELL);
+    }
+
+private:
+    std::atomic<int>& market_calls_;
+};
+
+TEST_F(StrategyManagerTest, RoutesEventsOnlyToStrategiesThatDeclaredThem) {
+    std::atomic<int> market_calls{0};
+    strategy_manager->add_strategy(std::make_unique<BookAndBarStrategy>(market_calls));
+
+    std::promise<void> done;
+    std::vector<OrderDirection> directions;
+    event_bus->subscribe(EventType::SIGNAL,
+        [&](const Event& event) {
+            directions.push_back(static_cast<const SignalEvent&>(event).direction);
+            if (directions.size() == 2)
+                done.set_value();
+        });
+    event_bus->start();
+    strategy_manager->start();
+
+    const SymbolId symbol = intern_symbol("ETHUSDT");
+    event_bus->publish(std::make_shared<MarketEvent>(symbol, 1800.0));
+    OrderBook book{};
+    book.symbol_id = symbol;
+    event_bus->publish(std::make_shared<OrderBookEvent>(book));
+    event_bus->publish(std::make_shared<BarEvent>(symbol, BarSpec{}, Bar{}));
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    strategy_manager->stop();
+    event_bus->stop();
+
+    EXPECT_EQ(directions, (std::vector<OrderDirection>{OrderDirection::BUY, OrderDirection::SELL}));
+    EXPECT_EQ(market_calls.load(), 0);
+}
+
+TEST_F(StrategyManagerTest, StaticStrategySetRoutesLikeTheManager) {
+    std::atomic<int> market_calls{0};
+    StaticStrategySet<BookAndBarStrategy, BuyEveryTickStrategy> pipeline(event_bus, "TestStaticStrategySet");
+    pipeline.add_strategy(BookAndBarStrategy(market_calls));
+    pipeline.add_strategy(BuyEveryTickStrategy());
+    EXPECT_EQ(pipeline.strategy_count(), 2u);
+
+    std::promise<void> done;
+    std::vector<OrderDirection> directions;
+    event_bus->subscribe(EventType::SIGNAL,
+        [&](const Event& event) {
+            directions.push_back(static_cast<const SignalEvent&>(event).direction);
+            if (directions.size() == 3)
+                done.set_value();
+        });
+    event_bus->start();
+    pipeline.start();
+
+    const SymbolId symbol = intern_symbol("ETHUSDT");
+    event_bus->publish(std::make_shared<MarketEvent>(symbol, 1800.0));
+    OrderBook book{};
+    book.symbol_id = symbol;
+    event_bus->publish(std::make_shared<OrderBookEvent>(book));
+    event_bus->publish(std::make_shared<BarEvent>(symbol, BarSpec{}, Bar{}));
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    pipeline.stop();
+    event_bus->stop();
+
+    // The tick reaches only BuyEveryTickStrategy.
+    EXPECT_EQ(directions, (std::vector<OrderDirection>{OrderDirection::BUY, OrderDirection::BUY, OrderDirection::SELL}));
+    EXPECT_EQ(market_calls.load(), 0);
+}
+
+// Signals one per book, tagged with its own symbol; counts the books it saw.
+class TaggingStrategy : public Strategy {
+public:
+    explicit TaggingStrategy(SymbolId tag) : tag_(tag) {}
+    uint32_t interests() const override { return ORDER_BOOK; }
+    void on_order_book(const OrderBookEvent&, SignalSink& signals) override {
+        ++books;
+        signals.emit(tag_, OrderDirection::BUY);
+    }
+    int books = 0;
+
+private:
+    SymbolId tag_;
+};
+
+TEST_F(StrategyManagerTest, WorkerPoolPublishesSignalsInRegistrationOrder) {
+    constexpr int STRATEGIES = 200;
+    constexpr int BOOKS = 20;
+    auto manager = std::make_shared<StrategyManager>(event_bus, "PooledStrategyManager", 4);
+    EXPECT_EQ(manager->worker_count(), 4u);
+    std::vector<SymbolId> tags;
+    std::vector<TaggingStrategy*> strategies;
+    for (int i = 0; i < STRATEGIES; ++i) {
+        tags.push_back(intern_symbol("FANOUT" + std::to_string(i)));
+        auto strategy = std::make_unique<TaggingStrategy>(tags.back());
+        strategies.push_back(strategy.get());
+        manager->add_strategy(std::move(strategy));
+    }
+
+    std::promise<void> done;
+    std::vector<SymbolId> signalled;
+    event_bus->subscribe(EventType::SIGNAL,
+        [&](const Event& event) {
+            signalled.push_back(static_cast<const SignalEvent&>(event).symbol_id);
+            if (signalled.size() == static_cast<size_t>(STRATEGIES * BOOKS))
+                done.set_value();
+        });
+    event_bus->start();
+    manager->start();
+    for (int i = 0; i < BOOKS; ++i)
+        event_bus->publish(std::make_shared<OrderBookEvent>(OrderBook{}));
+
+    ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    manager->stop();
+    event_bus->stop();
+
+    for (int book = 0; book < BOOKS; ++book)
+        for (int i = 0; i < STRATEGIES; ++i)
+            ASSERT_EQ(signalled[book * STRATEGIES + i], tags[i]) << "book " << book << ", strategy " << i;
+    for (const auto* strategy : strategies)
+        EXPECT_EQ(strategy->books, BOOKS);
+}
+
+TEST(SignalSinkTest, HoldsUpToCapacityAndCountsDrops) {
+    SignalSink sink;
+    const SymbolId symbol = intern_symbol("SINKTEST");
+    for (size_t i = 0; i < SignalSink::CAPACITY; ++i)
+        EXPECT_TRUE(sink.emit(symbol, i % 2 ? OrderDirection::SELL : OrderDirection::BUY));
+    EXPECT_FALSE(sink.emit(symbol, OrderDirection::BUY));
+    EXPECT_EQ(sink.size(), SignalSink::CAPACITY);
+    EXPECT_EQ(sink.dropped(), 1u);
+    EXPECT_EQ(sink.begin()[1].direction, OrderDirection::SELL);
+    sink.clear();
+    EXPECT_TRUE(sink.empty());
+    EXPECT_EQ(sink.dropped(), 1u);
+}
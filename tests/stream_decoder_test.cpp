@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "core/EventBus.h"
+#include "core/Log.h"
+#include "core/SymbolRegistry.h"
+#include "data/BinanceStreamDecoder.h"
+#include "data/StreamProcessor.h"
+
+using namespace hft_system;
+
+class StreamDecoderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Log::init();
+        btc_depth = decoder.add_stream("btcusdt@depth@100ms", InstrumentSpec::from(0.01, 0.00001));
+        btc_trade = decoder.add_stream("btcusdt@trade", InstrumentSpec::from(0.01, 0.00001));
+        eth_ticker = decoder.add_stream("ethusdt@bookTicker", InstrumentSpec::from(0.01, 0.0001));
+    }
+    void TearDown() override { Log::shutdown(); }
+
+    BinanceStreamDecoder::Result decode(const std::string &frame)
+    {
+        storage.assign(frame);
+        storage.resize(BinanceStreamDecoder::padded_capacity(frame.size()), '\0');
+        return decoder.decode(storage.data(), frame.size(), storage.size());
+    }
+
+    BinanceStreamDecoder decoder;
+    size_t btc_depth = 0, btc_trade = 0, eth_ticker = 0;
+    std::string storage;
+};
+
+TEST_F(StreamDecoderTest, RegistersStreamsByKind)
+{
+    EXPECT_EQ(decoder.stream_count(), 3u);
+    EXPECT_EQ(decoder.stream_kind(btc_depth), BinanceStreamDecoder::StreamKind::DEPTH);
+    EXPECT_EQ(decoder.stream_kind(btc_trade), BinanceStreamDecoder::StreamKind::TRADE);
+    EXPECT_EQ(decoder.stream_kind(eth_ticker), BinanceStreamDecoder::StreamKind::BOOK_TICKER);
+    EXPECT_EQ(decoder.add_stream("btcusdt@trade", InstrumentSpec{}), btc_trade);
+    EXPECT_EQ(decoder.add_stream("btcusdt@kline_1m", InstrumentSpec{}), BinanceStreamDecoder::NO_STREAM);
+    EXPECT_EQ(decoder.add_stream("depth", InstrumentSpec{}), BinanceStreamDecoder::NO_STREAM);
+}
+
+TEST_F(StreamDecoderTest, RoutesDepthFramesByStreamName)
+{
+    ASSERT_EQ(decode(R"({"stream":"btcusdt@depth@100ms","data":{"e":"depthUpdate","E":1700000000123,"s":"BTCUSDT",)"
+                     R"("U":157,"u":160,"b":[["27123.45000000","0.50000000"]],"a":[]}})"),
+              BinanceStreamDecoder::Result::DEPTH_UPDATE);
+    EXPECT_EQ(decoder.stream(), btc_depth);
+    EXPECT_EQ(decoder.depth().symbol, "BTCUSDT");
+    EXPECT_EQ(decoder.first_update_id(), 157);
+    EXPECT_EQ(decoder.final_update_id(), 160);
+    ASSERT_EQ(decoder.depth().bids.size(), 1u);
+    EXPECT_EQ(decoder.depth().bids[0].price, Price(2712345));
+    EXPECT_EQ(decoder.depth().bids[0].quantity, Quantity(50000));
+    EXPECT_TRUE(decoder.depth().asks.empty());
+}
+
+TEST_F(StreamDecoderTest, DecodesTradesAndBookTickersOnTheirSymbolsGrid)
+{
+    ASSERT_EQ(decode(R"({"stream":"btcusdt@trade","data":{"e":"trade","E":1700000000200,"s":"BTCUSDT","t":42,)"
+                     R"("p":"27123.46000000","q":"0.01200000","T":1700000000199,"m":true,"M":true}})"),
+              BinanceStreamDecoder::Result::TRADE);
+    EXPECT_EQ(decoder.stream(), btc_trade);
+    EXPECT_EQ(decoder.trade().trade_id, 42);
+    EXPECT_EQ(decoder.trade().trade_time, 1700000000199);
+    EXPECT_EQ(decoder.trade().price, Price(2712346));
+    EXPECT_EQ(decoder.trade().quantity, Quantity(1200));
+    EXPECT_TRUE(decoder.trade().buyer_is_maker);
+
+    ASSERT_EQ(decode(R"({"stream":"ethusdt@bookTicker","data":{"u":400900217,"s":"ETHUSDT",)"
+                     R"("b":"1850.12000000","B":"3.50000000","a":"1850.13000000","A":"0.25000000"}})"),
+              BinanceStreamDecoder::Result::BOOK_TICKER);
+    EXPECT_EQ(decoder.stream(), eth_ticker);
+    EXPECT_EQ(decoder.book_ticker().update_id, 400900217);
+    EXPECT_EQ(decoder.book_ticker().bid_price, Price(185012));
+    EXPECT_EQ(decoder.book_ticker().bid_quantity, Quantity(35000)); // 0.0001 lots
+    EXPECT_EQ(decoder.book_ticker().ask_price, Price(185013));
+    EXPECT_EQ(decoder.book_ticker().ask_quantity, Quantity(2500));
+}
+
+TEST_F(StreamDecoderTest, ClassifiesOtherFrames)
+{
+    EXPECT_EQ(decode(R"({"result":null,"id":1})"), BinanceStreamDecoder::Result::SUBSCRIPTION_ACK);
+    EXPECT_EQ(decoder.stream(), BinanceStreamDecoder::NO_STREAM);
+    EXPECT_EQ(decode(R"({"stream":"solusdt@trade","data":{"p":"1.0","q":"1.0"}})"), BinanceStreamDecoder::Result::IGNORED);
+    EXPECT_EQ(decode(R"({"data":{"p":"1.0","q":"1.0"},"stream":"btcusdt@trade"})"), BinanceStreamDecoder::Result::ERROR);
+    EXPECT_EQ(decode(R"({"stream":"btcusdt@trade","data":{"p":"abc","q":"1.0"}})"), BinanceStreamDecoder::Result::ERROR);
+    EXPECT_EQ(decode(R"({"stream":"ethusdt@bookTicker","data":{"b":"1.0","B":"1.0"}})"), BinanceStreamDecoder::Result::ERROR);
+    EXPECT_EQ(decode("not json"), BinanceStreamDecoder::Result::ERROR);
+}
+
+TEST_F(StreamDecoderTest, LazyDepthIndexesLevelsAndDecodesThemOnDemand)
+{
+    decoder.set_lazy_depth(btc_depth, true);
+    ASSERT_EQ(decode(R"({"stream":"btcusdt@depth@100ms","data":{"e":"depthUpdate","E":1700000000123,"s":"BTCUSDT",)"
+                     R"("U":157,"u":160,"b":[["27123.45000000","0.50000000"],["27123.44000000","0.00000000"]],)"
+                     R"("a":[["27123.46000000","1.25000000"]]}})"),
+              BinanceStreamDecoder::Result::DEPTH_UPDATE);
+    ASSERT_TRUE(decoder.depth_is_raw());
+    EXPECT_EQ(decoder.first_update_id(), 157);
+    EXPECT_EQ(decoder.final_update_id(), 160);
+
+    RawDepthUpdate raw = decoder.raw_depth();
+    EXPECT_FALSE(raw.is_decoded());
+    EXPECT_EQ(raw.update().symbol, "BTCUSDT");
+    EXPECT_EQ(raw.update().timestamp, 1700000000123);
+    EXPECT_EQ(raw.bid_count(), 2u);
+    EXPECT_EQ(raw.ask_count(), 1u);
+    EXPECT_TRUE(raw.update().bids.empty());
+
+    ASSERT_TRUE(raw.decode(InstrumentSpec::from(0.01, 0.00001)));
+    EXPECT_TRUE(raw.is_decoded());
+    ASSERT_EQ(raw.update().bids.size(), 2u);
+    EXPECT_EQ(raw.update().bids[0].price, Price(2712345));
+    EXPECT_EQ(raw.update().bids[0].quantity, Quantity(50000));
+    EXPECT_EQ(raw.update().bids[1].quantity, Quantity(0));
+    ASSERT_EQ(raw.update().asks.size(), 1u);
+    EXPECT_EQ(raw.update().asks[0].quantity, Quantity(125000));
+
+    // Level text is only checked structurally until someone decodes it.
+    const std::string bad = R"({"stream":"btcusdt@depth@100ms","data":{"e":"depthUpdate","E":1,"s":"BTCUSDT",)"
+                            R"("U":161,"u":161,"b":[["abc","1.0"]],"a":[]}})";
+    ASSERT_EQ(decode(bad), BinanceStreamDecoder::Result::DEPTH_UPDATE);
+    RawDepthUpdate unparseable = decoder.raw_depth();
+    EXPECT_FALSE(unparseable.decode(InstrumentSpec::from(0.01, 0.00001)));
+    EXPECT_EQ(decode(R"({"stream":"btcusdt@depth@100ms","data":{"e":"depthUpdate","b":[["1.0"]]}})"),
+              BinanceStreamDecoder::Result::ERROR);
+
+    decoder.set_lazy_depth(btc_depth, false);
+    EXPECT_EQ(decode(bad), BinanceStreamDecoder::Result::ERROR);
+    EXPECT_FALSE(decoder.depth_is_raw());
+}
+
+// Diffs buffered while the book waits for its snapshot are only parsed if
+// they are newer than the snapshot.
+TEST_F(StreamDecoderTest, ProcessorNeverParsesStaleBufferedDiffs)
+{
+    SymbolRegistry::get_instance().set_spec(intern_symbol("BTCUSDT"), InstrumentSpec::from(0.01, 0.00001));
+    auto bus = std::make_shared<EventBus>();
+    int snapshot_requests = 0;
+    StreamProcessor processor(bus, 20, [&](StreamProcessor::Feed &)
+                              { ++snapshot_requests; });
+    ASSERT_TRUE(processor.add_stream("btcusdt@depth"));
+    processor.request_snapshots();
+    EXPECT_EQ(snapshot_requests, 1);
+
+    auto process = [&](const std::string &frame)
+    {
+        storage.assign(frame);
+        storage.resize(BinanceStreamDecoder::padded_capacity(frame.size()), '\0');
+        processor.process_frame(storage.data(), frame.size(), storage.size());
+    };
+    auto diff = [](int first, int last, const std::string &bid_quantity)
+    {
+        return R"({"stream":"btcusdt@depth","data":{"e":"depthUpdate","E":1,"s":"BTCUSDT","U":)" + std::to_string(first) +
+               R"(,"u":)" + std::to_string(last) + R"(,"b":[["27000.00","1.0"],["26999.00",")" + bid_quantity + R"("]],"a":[]}})";
+    };
+    // Diffs up to the snapshot's update 90 carry level text that would not parse.
+    for (int id = 1; id < 100; id += 2)
+        process(diff(id, id + 1, id + 1 <= 90 ? "garbage" : "2." + std::to_string(id)));
+
+    StreamProcessor::Feed *feed = processor.find_feed("BTCUSDT");
+    ASSERT_NE(feed, nullptr);
+    EXPECT_EQ(feed->pending_diffs.size(), 50u);
+    ASSERT_TRUE(processor.on_snapshot(*feed, R"({"lastUpdateId":90,"bids":[["26990.00","3.0"]],"asks":[["27010.00","1.0"]]})"));
+
+    EXPECT_EQ(processor.stale_diffs_skipped(), 45u);
+    EXPECT_TRUE(feed->local_book.is_synced());
+    EXPECT_EQ(feed->local_book.last_update_id(), 100);
+    EXPECT_EQ(feed->local_book.bid_depth(), 3u);
+
+    // Synced books are decoded eagerly again, so bad level text is rejected up front.
+    process(diff(101, 101, "garbage"));
+    EXPECT_EQ(feed->local_book.last_update_id(), 100);
+    process(diff(101, 102, "0"));
+    EXPECT_EQ(feed->local_book.last_update_id(), 102);
+    EXPECT_EQ(feed->local_book.bid_depth(), 2u);
+    EXPECT_EQ(snapshot_requests, 1);
+}
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/SymbolRegistry.h"
+
+using namespace hft_system;
+
+TEST(SymbolRegistryTest, InternIsStableAndRoundTrips)
+{
+    SymbolId btc = intern_symbol("REGISTRY_BTC");
+    SymbolId eth = intern_symbol("REGISTRY_ETH");
+    EXPECT_NE(btc, eth);
+    EXPECT_EQ(intern_symbol(std::string("REGISTRY_BTC")), btc);
+    EXPECT_EQ(symbol_name(btc), "REGISTRY_BTC");
+    EXPECT_EQ(SymbolRegistry::get_instance().find("REGISTRY_ETH"), eth);
+    EXPECT_EQ(SymbolRegistry::get_instance().find("REGISTRY_NEVER_SEEN"), INVALID_SYMBOL_ID);
+    EXPECT_EQ(symbol_name(INVALID_SYMBOL_ID), "");
+}
+
+TEST(SymbolRegistryTest, ConcurrentInternAssignsOneIdPerName)
+{
+    constexpr int THREADS = 4;
+    constexpr int NAMES = 200;
+    std::vector<std::vector<SymbolId>> ids(THREADS, std::vector<SymbolId>(NAMES));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([&, t]()
+                             {
+            for (int i = 0; i < NAMES; ++i)
+                ids[t][i] = intern_symbol("CONCURRENT_" + std::to_string(i)); });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    for (int i = 0; i < NAMES; ++i)
+    {
+        for (int t = 1; t < THREADS; ++t)
+            ASSERT_EQ(ids[t][i], ids[0][i]);
+        EXPECT_EQ(symbol_name(ids[0][i]), "CONCURRENT_" + std::to_string(i));
+    }
+}
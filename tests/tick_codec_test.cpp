@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/Log.h"
+#include "core/EventBus.h"
+#include "core/SymbolRegistry.h"
+#include "data/BinanceStreamDecoder.h"
+#include "data/StreamProcessor.h"
+#include "data/TickCodec.h"
+#include "data/TickDataHandler.h"
+#include "events/Event.h"
+#include "utils/Timer.h"
+
+using namespace hft_system;
+
+class TickCodecTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Log::init();
+        file_path = (std::filesystem::temp_directory_path() / "hft_tick_codec_test.ticks").string();
+
+        // A random walk around 30000.00 with ten levels per side, in 0.01 ticks and 0.00001 lots.
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> step(-3, 3);
+        std::uniform_int_distribution<int> lots(1, 50000);
+        long long mid_ticks = 3000000;
+        for (int i = 0; i < NUM_UPDATES; ++i)
+        {
+            mid_ticks += step(rng);
+            DepthUpdate book;
+            book.symbol = "BTCUSDT";
+            book.timestamp = FIRST_TIMESTAMP + i * 7;
+            for (int level = 0; level < LEVELS_PER_SIDE; ++level)
+            {
+                book.bids.push_back({Price(mid_ticks - 1 - level), Quantity(lots(rng))});
+                book.asks.push_back({Price(mid_ticks + 1 + level), Quantity(lots(rng))});
+            }
+            books.push_back(std::move(book));
+        }
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(file_path);
+        Log::shutdown();
+    }
+
+    void write_file(size_t updates_per_block)
+    {
+        TickWriter writer(file_path, "BTCUSDT", 0.01, 0.00001, updates_per_block);
+        ASSERT_TRUE(writer.open());
+        for (const auto &book : books)
+        {
+            writer.append(book);
+        }
+        writer.close();
+    }
+
+    static constexpr int NUM_UPDATES = 20000;
+    static constexpr int LEVELS_PER_SIDE = 10;
+    static constexpr long long FIRST_TIMESTAMP = 1700000000000;
+    std::string file_path;
+    std::vector<DepthUpdate> books;
+};
+
+TEST_F(TickCodecTest, RoundTripsEveryLevelExactly)
+{
+    write_file(1000);
+
+    TickReader reader(file_path);
+    ASSERT_TRUE(reader.open());
+    EXPECT_EQ(reader.symbol(), "BTCUSDT");
+
+    TickBlock block;
+    size_t update = 0;
+    while (reader.next_block(block))
+    {
+        for (size_t i = 0; i < block.update_count(); ++i, ++update)
+        {
+            const DepthUpdate &expected = books[update];
+            ASSERT_EQ(block.timestamps[i], expected.timestamp);
+            ASSERT_EQ(block.bid_counts[i], expected.bids.size());
+            ASSERT_EQ(block.ask_counts[i], expected.asks.size());
+            size_t level = block.level_begin[i];
+            for (const auto &bid : expected.bids)
+            {
+                ASSERT_EQ(block.prices[level], bid.price.value);
+                ASSERT_EQ(block.quantities[level], bid.quantity.value);
+                ++level;
+            }
+            for (const auto &ask : expected.asks)
+            {
+                ASSERT_EQ(block.prices[level], ask.price.value);
+                ASSERT_EQ(block.quantities[level], ask.quantity.value);
+                ++level;
+            }
+        }
+    }
+    EXPECT_EQ(update, books.size());
+}
+
+TEST_F(TickCodecTest, CompressesAndDecodesQuickly)
+{
+    write_file(TickWriter::DEFAULT_UPDATES_PER_BLOCK);
+
+    size_t logical_bytes = 0;
+    int64_t decode_ns = 0;
+    for (int pass = 0; pass < 5; ++pass)
+    {
+        TickReader reader(file_path);
+        ASSERT_TRUE(reader.open());
+        TickBlock block;
+        Timer decode_timer;
+        while (reader.next_block(block))
+        {
+            logical_bytes += block.logical_bytes();
+        }
+        decode_ns += decode_timer.elapsed_nanoseconds();
+    }
+
+    auto file_bytes = std::filesystem::file_size(file_path);
+    double ratio = static_cast<double>(logical_bytes / 5) / file_bytes;
+    Log::get_logger()->info("Tick codec: {} bytes on disk, {:.1f}x smaller than decoded, decode {:.2f} GB/s",
+                            file_bytes, ratio, static_cast<double>(logical_bytes) / decode_ns);
+    EXPECT_GT(ratio, 3.0);
+}
+
+TEST_F(TickCodecTest, BlocksBeforeStartAreSkippedWithoutDecoding)
+{
+    write_file(1000);
+
+    TickReader reader(file_path);
+    ASSERT_TRUE(reader.open());
+    TickBlock block;
+    const long long start = books[12345].timestamp;
+    ASSERT_TRUE(reader.next_block(block, start));
+    // The first decoded block is the one containing update 12345, decoded from scratch.
+    EXPECT_EQ(block.timestamps.front(), books[12000].timestamp);
+    EXPECT_EQ(block.prices[block.level_begin[345]], books[12345].bids[0].price.value);
+}
+
+TEST_F(TickCodecTest, HandlerReplaysRecordedUpdatesInRange)
+{
+    books[10].bids[0].quantity = Quantity(0); // A removal must not reach strategies as a level.
+    write_file(1000);
+
+    auto event_bus = std::make_shared<EventBus>();
+    std::vector<OrderBook> received;
+    std::promise<void> done_promise;
+    auto done_future = done_promise.get_future();
+    event_bus->subscribe(EventType::ORDER_BOOK,
+                         [&](const Event &event)
+                         { received.push_back(static_cast<const OrderBookEvent &>(event).book); });
+    event_bus->subscribe(EventType::SYSTEM, [&](const Event &)
+                         { done_promise.set_value(); });
+
+    TickDataHandler data_handler(event_bus, file_path);
+    data_handler.set_replay_delay(std::chrono::microseconds(0));
+    data_handler.set_time_range(books[5].timestamp, books[15005].timestamp);
+
+    event_bus->start();
+    data_handler.start();
+
+    auto future_status = done_future.wait_for(std::chrono::seconds(5));
+
+    data_handler.stop();
+    event_bus->stop();
+
+    ASSERT_EQ(future_status, std::future_status::ready) << "Test timed out.";
+    ASSERT_EQ(received.size(), 15000u);
+    EXPECT_EQ(symbol_name(received.front().symbol_id), "BTCUSDT");
+    EXPECT_EQ(received.front().timestamp, books[5].timestamp);
+    EXPECT_EQ(received.back().timestamp, books[15004].timestamp);
+    EXPECT_EQ(received[5].bids.size(), static_cast<size_t>(LEVELS_PER_SIDE - 1));
+    EXPECT_EQ(received[100].asks.price[3], books[105].asks[3].price);
+    EXPECT_EQ(received[100].asks.quantity[3], books[105].asks[3].quantity);
+    EXPECT_DOUBLE_EQ(instrument_spec(received[100].symbol_id).to_double(received[100].asks.price[3]),
+                     (books[105].asks[3].price.value) / 100.0);
+}
+
+TEST_F(TickCodecTest, TruncatedFileIsReportedNotMisread)
+{
+    write_file(1000);
+    std::filesystem::resize_file(file_path, std::filesystem::file_size(file_path) - 10);
+
+    TickReader reader(file_path);
+    ASSERT_TRUE(reader.open());
+    TickBlock block;
+    EXPECT_THROW(
+        {
+            while (reader.next_block(block))
+            {
+            }
+        },
+        std::runtime_error);
+}
+
+// A live recording holds the books the feed published, so replaying it gives
+// back whole books and not the diffs they were built from.
+TEST_F(TickCodecTest, RecordedDiffsReplayAsTheBooksTheyBuilt)
+{
+    const SymbolId btc = intern_symbol("BTCUSDT");
+    SymbolRegistry::get_instance().set_spec(btc, InstrumentSpec::from(0.01, 0.00001));
+    StreamProcessor processor(std::make_shared<EventBus>(), 5, [](StreamProcessor::Feed &) {});
+    ASSERT_TRUE(processor.add_stream("btcusdt@depth"));
+    StreamProcessor::Feed *feed = processor.find_feed("BTCUSDT");
+    ASSERT_NE(feed, nullptr);
+    feed->recorder = std::make_unique<TickWriter>(file_path, "BTCUSDT", 0.01, 0.00001);
+    ASSERT_TRUE(feed->recorder->open());
+
+    std::string storage;
+    auto process = [&](int id, const std::string &bids, const std::string &asks)
+    {
+        const std::string frame = R"({"stream":"btcusdt@depth","data":{"e":"depthUpdate","E":)" + std::to_string(1000 + id) +
+                                  R"(,"s":"BTCUSDT","U":)" + std::to_string(id) + R"(,"u":)" + std::to_string(id) +
+                                  R"(,"b":[)" + bids + R"(],"a":[)" + asks + "]}}";
+        storage.assign(frame);
+        storage.resize(BinanceStreamDecoder::padded_capacity(frame.size()), '\0');
+        processor.process_frame(storage.data(), frame.size(), storage.size());
+    };
+    processor.request_snapshots();
+    ASSERT_TRUE(processor.on_snapshot(*feed, R"({"lastUpdateId":10,"bids":[["100.00","1.0"],["99.00","2.0"],["98.00","3.0"]],)"
+                                             R"("asks":[["101.00","1.5"],["102.00","2.5"]]})"));
+    std::vector<OrderBook> published;
+    published.push_back(feed->view);
+    process(11, R"(["100.00","4.0"])", "");
+    published.push_back(feed->view);
+    process(12, R"(["99.00","0"])", R"(["100.50","0.5"])");
+    published.push_back(feed->view);
+    process(13, "", R"(["101.00","0"])");
+    published.push_back(feed->view);
+    feed->recorder->close();
+
+    TickReader reader(file_path);
+    ASSERT_TRUE(reader.open());
+    TickBlock block;
+    ASSERT_TRUE(reader.next_block(block));
+    ASSERT_EQ(block.update_count(), published.size());
+    for (size_t i = 0; i < published.size(); ++i)
+    {
+        const OrderBook book = block.to_order_book(i, btc);
+        ASSERT_EQ(book.bids.size(), published[i].bids.size()) << i;
+        ASSERT_EQ(book.asks.size(), published[i].asks.size()) << i;
+        for (size_t level = 0; level < book.bids.size(); ++level)
+        {
+            EXPECT_EQ(book.bids.price[level], published[i].bids.price[level]);
+            EXPECT_EQ(book.bids.quantity[level], published[i].bids.quantity[level]);
+        }
+        for (size_t level = 0; level < book.asks.size(); ++level)
+        {
+            EXPECT_EQ(book.asks.price[level], published[i].asks.price[level]);
+            EXPECT_EQ(book.asks.quantity[level], published[i].asks.quantity[level]);
+        }
+    }
+
+    // The last book keeps the snapshot levels no diff touched: bids 100 (now 4.0) and 98, asks 100.50 and 102.
+    const OrderBook last = block.to_order_book(published.size() - 1, btc);
+    ASSERT_EQ(last.bids.size(), 2u);
+    EXPECT_EQ(last.bids.price[0], Price(10000));
+    EXPECT_EQ(last.bids.quantity[0], Quantity(400000));
+    EXPECT_EQ(last.bids.price[1], Price(9800));
+    ASSERT_EQ(last.asks.size(), 2u);
+    EXPECT_EQ(last.asks.price[0], Price(10050));
+    EXPECT_EQ(last.asks.price[1], Price(10200));
+    EXPECT_EQ(last.asks.quantity[1], Quantity(250000));
+}
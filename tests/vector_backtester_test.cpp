@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <string>
+
+#include "core/Log.h"
+#include "core/Application.h"
+#include "analytics/VectorBacktester.h"
+#include "config/Config.h"
+
+using namespace hft_system;
+
+class VectorBacktesterTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        Log::init();
+    }
+
+    void TearDown() override
+    {
+        if (!temp_file.empty())
+            std::filesystem::remove(temp_file);
+        Log::shutdown();
+    }
+
+    static Config config(const std::string &file_path, int fast_period, int slow_period)
+    {
+        Config config;
+        config.run_mode = RunMode::BACKTEST;
+        config.data.symbol = "TEST_STOCK";
+        config.data.file_path = file_path;
+        // In lockstep, so the event engine handles each fill before the next bar.
+        config.data.replay_delay_us = 0;
+        config.data.lockstep = true;
+        StrategyConfig strategy;
+        strategy.name = "MA_CROSSOVER";
+        strategy.symbol = "TEST_STOCK";
+        strategy.params.fast_period = fast_period;
+        strategy.params.slow_period = slow_period;
+        config.strategies.push_back(strategy);
+        return config;
+    }
+
+    static void expect_same_report(const std::map<std::string, double> &vector, const std::map<std::string, double> &event)
+    {
+        ASSERT_EQ(vector.size(), event.size());
+        for (const auto &[key, value] : event)
+        {
+            ASSERT_TRUE(vector.count(key)) << key;
+            EXPECT_NEAR(vector.at(key), value, 1e-9 * std::max(1.0, std::abs(value))) << key;
+        }
+    }
+
+    std::string temp_file;
+};
+
+TEST_F(VectorBacktesterTest, MatchesTheEventEngineOnTestData)
+{
+    Config test_config = config(std::string(PROJECT_SOURCE_DIR) + "/tests/data/test_market_data.csv", 2, 3);
+    ASSERT_TRUE(VectorBacktester::supports(test_config));
+    Application app(test_config);
+    auto event_report = app.run_backtest();
+
+    VectorBacktester backtester(test_config);
+    ASSERT_TRUE(backtester.run());
+    EXPECT_EQ(backtester.bar_count(), 10u);
+    // A steady climb: one crossing, as soon as both averages exist.
+    EXPECT_EQ(backtester.signal_count(), 1u);
+    EXPECT_EQ(backtester.signals()[2], 1);
+    ASSERT_FALSE(event_report.empty());
+    expect_same_report(backtester.report(), event_report);
+}
+
+TEST_F(VectorBacktesterTest, MatchesTheEventEngineOnARandomWalk)
+{
+    temp_file = (std::filesystem::temp_directory_path() / "hft_vector_backtester_test.csv").string();
+    {
+        std::ofstream out(temp_file);
+        out << "timestamp,open,high,low,close,volume\n"
+            << std::fixed << std::setprecision(2);
+        std::mt19937 rng(11);
+        std::normal_distribution<double> step(0.0, 15.0);
+        double close = 16500.0;
+        for (int i = 0; i < 300; ++i)
+        {
+            double open = close;
+            close = std::round((close + step(rng)) * 100.0) / 100.0;
+            out << 1672531140 + 60 * i << ",\"" << open << "\",\"" << std::max(open, close) << "\",\""
+                << std::min(open, close) << "\",\"" << close << "\"," << 100 + i << "\n";
+        }
+    }
+
+    Config walk_config = config(temp_file, 3, 8);
+    Application app(walk_config);
+    auto event_report = app.run_backtest();
+
+    VectorBacktester backtester(walk_config);
+    ASSERT_TRUE(backtester.run());
+    EXPECT_EQ(backtester.bar_count(), 300u);
+    EXPECT_GT(backtester.signal_count(), 10u);
+    ASSERT_TRUE(event_report.count("total_trades"));
+    EXPECT_GT(event_report.at("total_trades"), 0.0);
+    expect_same_report(backtester.report(), event_report);
+}
@@ -0,0 +1,74 @@
+#include "../include/core/Log.h"
+#include "../include/data/ReplayServer.h"
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+// Serves a recording of Binance stream messages over plain WebSockets so the
+// LIVE pipeline can be pointed at ws://127.0.0.1:<port>/stream with
+// "use_tls": false.
+//
+//   replay_server <messages.jsonl> [--port N] [--speed X] [--loops N] [--disconnect-after N]
+//
+// --speed 1 keeps the recorded pace, N plays N times faster and 0 sends flat out.
+
+namespace
+{
+    volatile std::sig_atomic_t stop_requested = 0;
+    void on_signal(int) { stop_requested = 1; }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <messages.jsonl> [--port N] [--speed X] [--loops N] [--disconnect-after N]\n";
+        return 1;
+    }
+
+    hft_system::ReplayServerOptions options;
+    options.messages_file = argv[1];
+    options.port = 9443;
+    for (int i = 2; i + 1 < argc; i += 2)
+    {
+        std::string flag = argv[i];
+        std::string value = argv[i + 1];
+        if (flag == "--port")
+            options.port = static_cast<unsigned short>(std::stoi(value));
+        else if (flag == "--speed")
+            options.speed = std::stod(value);
+        else if (flag == "--loops")
+            options.loops = std::stoi(value);
+        else if (flag == "--disconnect-after")
+            options.disconnect_after = static_cast<size_t>(std::stoull(value));
+        else
+        {
+            std::cerr << "unknown option " << flag << "\n";
+            return 1;
+        }
+    }
+
+    hft_system::Log::init();
+    int status = 0;
+    {
+        hft_system::ReplayServer server(options);
+        if (server.start())
+        {
+            std::signal(SIGINT, on_signal);
+            std::signal(SIGTERM, on_signal);
+            while (!stop_requested)
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            server.stop();
+            hft_system::Log::get_logger()->info("Served {} connections, {} messages.",
+                                                server.connections_accepted(), server.messages_sent());
+        }
+        else
+        {
+            status = 1;
+        }
+    }
+    hft_system::Log::shutdown();
+    return status;
+}